@@ -14,10 +14,21 @@
 //   Publisher               — 事件发布者
 //   Acceptor                — 事件订阅者 (自动管理生命周期)
 //   MPMCQueue<T, N>         — 无锁多生产者多消费者队列 (底层组件)
+//   FrameClock              — 单调帧时间源 (限流订阅使用)
+//   IExecutor               — 回调执行器: ThreadPoolExecutor / MainThreadExecutor / StrandExecutor
 //   EventTask               — 协程任务类型 (fire-and-forget)
-//   EventAwaiter<S>         — 一次性事件等待 (co_await)
+//   EventAwaiter<S>         — 一次性事件等待 (co_await), 可附加 WithTimeout / WithCancellation
 //   EventStream<S>          — 持续事件流 (循环 co_await)
 //
+// 可选组件 (需单独包含):
+//   SharedMemoryTransport   — 跨进程事件传输 (POSIX 共享内存), "Core/Bus/SharedMemoryTransport.h"
+//   StaticEventBus<S...>    — 编译期信号路由的零开销总线, "Core/Bus/StaticEventBus.h"
+//   Benchmark::CompareStaticAndDynamicBus — 两种总线的 Emit 耗时对比, "Core/Bus/BusBenchmark.h"
+//   WhenAll / WhenAny       — 组合等待多个 EventAwaiter / Task, "Core/Coroutine/Combinators.h"
+//   Delay / NextFrame / Until — 帧驱动的时间轮等待, "Core/Coroutine/TimerWheel.h"
+//   CancellationSource / CancellationToken — 协作式取消, "Core/Coroutine/Cancellation.h"
+//
 
 #include "MPMCQueue.h"
+#include "Executor.h"
 #include "EventBus.h"
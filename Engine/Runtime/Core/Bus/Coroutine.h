@@ -8,6 +8,8 @@
 //
 // ■ 核心组件:
 //   EventAwaiter<S>   — 一次性等待: co_await, 事件到达后恢复, 返回数据
+//   .WithTimeout(d) / .WithCancellation(token)
+//                     — 带超时 / 取消的一次性等待, 返回 optional, 超时或取消时为空
 //   EventStream<S>    — 持续等待: 循环中反复 co_await, 每次 Emit 都恢复
 //   EventTask         — 无返回值协程任务, 用于启动事件驱动的异步流程
 //
@@ -49,11 +51,23 @@
 #include "Bus.h"
 #include "EventBus.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <coroutine>
 #include <exception>
+#include <memory>
+#include <limits>
+#include <mutex>
 #include <optional>
+#include <stdexcept>
 #include <tuple>
 #include <utility>
+#include <vector>
+
+#include "Core/Coroutine/Cancellation.h"
+#include "Core/Coroutine/FramePool.h"
+#include "Core/Coroutine/TimerWheel.h"
 
 // 前置声明 EventBus (定义在 EventBus.hpp)
 // Coroutine.hpp 不 #include EventBus.hpp, 而是由 EventBus.hpp 来 #include 本文件,
@@ -66,6 +80,10 @@ namespace Core::Bus
 // 前置声明
 class EventBus;
 
+template<typename SignalType>
+    requires IsSignal<SignalType>
+class GuardedEventAwaiter;
+
 
 // ============================================================================
 //  Section 1: EventTask — 协程任务类型
@@ -82,6 +100,9 @@ class EventBus;
 // ■ 异常:
 //   协程内的未捕获异常会调用 std::terminate (与标准行为一致).
 //
+// ■ 内存:
+//   协程帧从 FramePool 分配 (按大小分桶的线程缓存), 不经过全局 operator new.
+//
 // ■ 用法:
 //   EventTask MyCoroutine(EventBus& bus)
 //   {
@@ -93,7 +114,7 @@ class EventBus;
 class EventTask
 {
 public:
-    struct promise_type
+    struct promise_type : PooledCoroutineFrame
     {
         EventTask get_return_object()
         {
@@ -168,25 +189,50 @@ private:
 //   EventAwaiter 是一次性的, co_await 后即消耗.
 //   持续监听请使用 EventStream.
 //
+// ■ 取消:
+//   挂起期间可调用 Cancel() 断开订阅 (WhenAny 用它取消失败者).
+//   返回 true 时保证协程不会再被该事件恢复.
+//   需要超时或取消令牌时, 使用 WithTimeout / WithCancellation (见 Section 2b).
+//
 template<typename SignalType>
     requires IsSignal<SignalType>
 class EventAwaiter
 {
     using DataType = typename SignalType::ArgTypes; // std::tuple<Args...>
+    /// 事件回调与 Cancel 之间的仲裁状态; 回调按值持有, 迟到的回调只访问这里
+    struct WaitState
+    {
+        std::mutex Mutex;
+        bool       Armed   = false; // await_suspend 已完成注册 (Conn 已赋值)
+        bool       Settled = false; // 事件已到达或已取消
+    };
+
     EventBus& Bus;
     std::optional<DataType> Result;
     Connection Conn;
+    std::shared_ptr<WaitState> State;
 
 public:
     explicit EventAwaiter(EventBus& bus) : Bus(bus) {}
 
+    EventAwaiter(EventAwaiter&&) noexcept = default;
+
+    /// 挂起中随协程帧销毁时: 先置 Settled, 迟到的回调不再写入本对象, 随后 Conn 析构断开订阅
+    ~EventAwaiter()
+    {
+        if (!State)
+            return;
+        std::lock_guard lock(State->Mutex);
+        State->Settled = true;
+    }
+
     // co_await 三件套:
 
     /// 事件是否已就绪? 始终返回 false → 总是挂起
     bool await_ready() const noexcept { return false; }
 
-    /// 挂起时: 注册 OneShot 订阅, 回调中恢复协程
-    void await_suspend(std::coroutine_handle<> handle);
+    /// 挂起时: 注册 OneShot 订阅, 回调中恢复协程; 注册期间事件已到达时返回 false (不挂起)
+    bool await_suspend(std::coroutine_handle<> handle);
     // 实现在 EventBus 类定义之后 (需要 EventBus 完整定义)
 
     /// 恢复时: 返回事件数据
@@ -194,9 +240,205 @@ public:
     {
         return std::move(*Result);
     }
+
+    /// 取消等待: 断开订阅. 返回 false 表示事件已到达 (或尚未挂起), 协程仍会被恢复
+    bool Cancel()
+    {
+        if (!State)
+            return false;
+        {
+            std::lock_guard lock(State->Mutex);
+            if (State->Settled || !State->Armed)
+                return false;
+            State->Settled = true;
+        }
+        Conn.Disconnect();
+        return true;
+    }
+
+    /// 超时后以空 optional 恢复; 起点为时间轮最近一次 Tick 的时间
+    [[nodiscard]] GuardedEventAwaiter<SignalType> WithTimeout(
+        TimerWheel::Duration timeout, TimerWheel& wheel = TimerWheel::GetDefault()) &&;
+
+    /// token 被取消时以空 optional 恢复
+    [[nodiscard]] GuardedEventAwaiter<SignalType> WithCancellation(CancellationToken token) &&;
 };
 
 
+// ============================================================================
+//  Section 2b: GuardedEventAwaiter<SignalType> — 带超时 / 取消的一次性等待
+// ============================================================================
+//
+//   auto reply = co_await bus.Await<OnReply>().WithTimeout(std::chrono::seconds(5));
+//   if (!reply) { ... 超时 ... }
+//
+//   auto hit = co_await bus.Await<OnHit>()
+//                  .WithTimeout(std::chrono::seconds(2))
+//                  .WithCancellation(scope.GetToken());
+//
+// ■ 原理:
+//   事件订阅、时间轮定时器、取消令牌三个来源竞争同一个等待, 由共享的
+//   GuardState 仲裁: 先结束等待的一方立即断开其余来源 (订阅、定时器节点、
+//   令牌回调), 然后恢复协程. 超时或取消的等待不会在信号上残留订阅.
+//
+// ■ 挂起中的竞争:
+//   await_suspend 依次注册三个来源, 其间某个来源可能已在其它线程触发.
+//   注册期间 (Armed == false) 触发的来源只记录结果, 由 await_suspend
+//   发现后直接返回 false (不挂起), 避免协程在 await_suspend 返回前被恢复.
+//
+// ■ 返回值: std::optional<std::tuple<Args...>>, 超时或取消时为空.
+//   令牌在 co_await 前已取消、或 timeout <= 0 时不挂起, 直接返回空.
+//
+template<typename SignalType>
+    requires IsSignal<SignalType>
+class GuardedEventAwaiter
+{
+    using DataType = typename SignalType::ArgTypes;
+
+    /// 三个来源的仲裁状态; 来源回调按值持有, 迟到的回调只访问这里
+    struct GuardState
+    {
+        std::mutex Mutex;
+        bool       Armed   = false; // await_suspend 已完成注册
+        bool       Settled = false; // 已有来源结束了等待
+    };
+
+    EventBus&                           Bus;
+    TimerWheel*                         Wheel = nullptr;
+    std::optional<TimerWheel::Duration> Timeout;
+    CancellationToken                   Token;
+
+    std::optional<DataType>             Result;
+    Connection                          Conn;
+    Detail::WheelNode                   TimerNode;
+    CancellationRegistration            Registration;
+    std::shared_ptr<GuardState>         State;
+
+public:
+    explicit GuardedEventAwaiter(EventBus& bus) : Bus(bus) {}
+
+    // 仅在挂起前可移动 (链式调用 WithTimeout / WithCancellation 时)
+    GuardedEventAwaiter(GuardedEventAwaiter&& other) noexcept
+        : Bus(other.Bus)
+        , Wheel(other.Wheel)
+        , Timeout(other.Timeout)
+        , Token(std::move(other.Token))
+    {
+        assert(!other.State && "GuardedEventAwaiter — 不能移动正在等待的 awaiter");
+    }
+
+    GuardedEventAwaiter(const GuardedEventAwaiter&)            = delete;
+    GuardedEventAwaiter& operator=(const GuardedEventAwaiter&) = delete;
+    GuardedEventAwaiter& operator=(GuardedEventAwaiter&&)      = delete;
+
+    ~GuardedEventAwaiter()
+    {
+        if (!State)
+            return;
+        {
+            std::lock_guard lock(State->Mutex);
+            State->Settled = true;
+        }
+        ReleaseSources();
+    }
+
+    [[nodiscard]] GuardedEventAwaiter WithTimeout(
+        TimerWheel::Duration timeout, TimerWheel& wheel = TimerWheel::GetDefault()) &&
+    {
+        Timeout = timeout;
+        Wheel   = &wheel;
+        return std::move(*this);
+    }
+
+    [[nodiscard]] GuardedEventAwaiter WithCancellation(CancellationToken token) &&
+    {
+        Token = std::move(token);
+        return std::move(*this);
+    }
+
+    /// 令牌已取消或超时为 0 时不挂起
+    bool await_ready() const noexcept
+    {
+        return Token.IsCancellationRequested()
+            || (Timeout && *Timeout <= TimerWheel::Duration::zero());
+    }
+
+    /// 注册订阅 / 定时器 / 令牌回调; 注册期间已有来源触发时返回 false
+    bool await_suspend(std::coroutine_handle<> handle);
+    // 实现在 EventBus 类定义之后 (需要 EventBus 完整定义)
+
+    /// 事件数据; 超时或取消时为空
+    std::optional<DataType> await_resume() { return std::move(Result); }
+
+    /// 取消等待 (供 WhenAny 使用); 返回 true 时保证不会再恢复协程
+    bool Cancel()
+    {
+        if (!State)
+            return false;
+        {
+            std::lock_guard lock(State->Mutex);
+            if (State->Settled || !State->Armed)
+                return false;
+            State->Settled = true;
+        }
+        ReleaseSources();
+        return true;
+    }
+
+private:
+    // ----------------------------------------------------------------
+    // Settle — 某个来源尝试结束等待
+    //
+    // 胜出且协程已挂起时, 断开其余来源并恢复协程.
+    // 只有胜出后才访问 awaiter 本身: 落败时 awaiter 可能已随协程帧销毁.
+    // ----------------------------------------------------------------
+    template<typename StoreFn>
+    static void Settle(const std::shared_ptr<GuardState>& state, GuardedEventAwaiter* self,
+                       std::coroutine_handle<> handle, StoreFn&& store)
+    {
+        bool armed;
+        {
+            std::lock_guard lock(state->Mutex);
+            if (state->Settled)
+                return;
+            state->Settled = true;
+            armed = state->Armed;
+            store();
+        }
+        if (!armed)
+            return; // await_suspend 尚未完成, 由它处理
+        self->ReleaseSources();
+        handle.resume();
+    }
+
+    /// 断开全部来源; 重复调用安全
+    void ReleaseSources()
+    {
+        Conn.Disconnect();
+        if (Wheel)
+            Wheel->Remove(TimerNode, /*isTimer=*/true);
+        Registration.Reset();
+    }
+};
+
+template<typename SignalType>
+    requires IsSignal<SignalType>
+GuardedEventAwaiter<SignalType> EventAwaiter<SignalType>::WithTimeout(
+    TimerWheel::Duration timeout, TimerWheel& wheel) &&
+{
+    assert(!State && "EventAwaiter::WithTimeout — 只能在 co_await 前调用");
+    return GuardedEventAwaiter<SignalType>(Bus).WithTimeout(timeout, wheel);
+}
+
+template<typename SignalType>
+    requires IsSignal<SignalType>
+GuardedEventAwaiter<SignalType> EventAwaiter<SignalType>::WithCancellation(CancellationToken token) &&
+{
+    assert(!State && "EventAwaiter::WithCancellation — 只能在 co_await 前调用");
+    return GuardedEventAwaiter<SignalType>(Bus).WithCancellation(std::move(token));
+}
+
+
 // ============================================================================
 //  Section 3: EventStream<SignalType> — 持续事件流
 // ============================================================================
@@ -215,16 +457,48 @@ public:
 //       }
 //   }
 //
+//   // 高频信号: 每次 co_await 取走一批, 缓冲区非空时不挂起
+//   auto stream = bus.Stream<OnParticleSpawned>({.Capacity = 1024});
+//   for (;;)
+//   {
+//       auto batch = co_await stream.NextBatch(256);  // vector<tuple>, 空表示已停止 (n 须大于 0)
+//       if (batch.empty()) break;
+//       for (auto& [pos, vel] : batch) Spawn(pos, vel);
+//   }
+//
 // ■ 原理:
-//   - 内部维护一个持久订阅 (非 OneShot)
-//   - 每次 co_await 时挂起, 等待下一次 Emit
-//   - Emit 回调将数据写入缓冲区并恢复协程
-//   - Stop() 断开订阅, 使下一次 co_await 返回 nullopt
+//   - 首次 co_await 时注册持久订阅 (非 OneShot)
+//   - Emit 回调把事件写入有界环形缓冲区; 若协程正在等待则恢复它
+//   - 协程运行期间 (未挂起) 到达的事件留在缓冲区, 不会丢失也不会重入
+//   - co_await 时缓冲区非空则直接返回, 不挂起
+//   - Stop() 断开订阅; 缓冲区中剩余事件仍可取出, 取完后返回 nullopt / 空批次
+//
+// ■ 溢出策略 (缓冲区满时, 见 EStreamOverflow):
+//   DropOldest — 丢弃最旧的事件, 保留最近 Capacity 个 (默认)
+//   DropNewest — 丢弃新到达的事件
+//   Coalesce   — 新事件覆盖最新的一个缓冲事件 (只关心最新状态)
 //
 // ■ 线程安全:
 //   co_await stream 必须在同一线程中使用 (不可跨线程共享 stream 对象).
 //   Emit 可以来自任意线程.
+//   订阅回调引用 stream 自身, 开始 co_await 后不可再移动 stream.
 //
+
+/// 缓冲区满时的处理方式
+enum class EStreamOverflow : uint8_t
+{
+    DropOldest,
+    DropNewest,
+    Coalesce,
+};
+
+/// EventStream 的缓冲配置
+struct StreamOptions
+{
+    size_t          Capacity = 64;
+    EStreamOverflow Overflow = EStreamOverflow::DropOldest;
+};
+
 template<typename SignalType>
     requires IsSignal<SignalType>
 class EventStream
@@ -233,45 +507,156 @@ class EventStream
 
     EventBus& Bus;
     Connection Conn;
-    std::optional<DataType> Buffer;           // 最新事件数据
+    StreamOptions Options;
+
+    // 环形缓冲区, 由 Mutex 保护 (Emit 可能来自其他线程)
+    mutable std::mutex                  Mutex;
+    std::vector<std::optional<DataType>> Ring;
+    size_t                              Head  = 0;
+    size_t                              Count = 0;
+    uint64_t                            DroppedCount = 0;
+
     std::coroutine_handle<> WaitingHandle;    // 当前等待中的协程
     bool Stopped = false;
 
+    /// 写入一个事件 (调用方需持有 Mutex)
+    void PushLocked(DataType&& data)
+    {
+        if (Count == Ring.size())
+        {
+            ++DroppedCount;
+            switch (Options.Overflow)
+            {
+            case EStreamOverflow::DropNewest:
+                return;
+            case EStreamOverflow::Coalesce:
+                Ring[(Head + Count - 1) % Ring.size()].emplace(std::move(data));
+                return;
+            case EStreamOverflow::DropOldest:
+                Ring[Head].reset();
+                Head = (Head + 1) % Ring.size();
+                --Count;
+                break;
+            }
+        }
+        Ring[(Head + Count) % Ring.size()].emplace(std::move(data));
+        ++Count;
+    }
+
+    /// 取出最旧的事件 (调用方需持有 Mutex, 且 Count > 0)
+    DataType PopLocked()
+    {
+        DataType data = std::move(*Ring[Head]);
+        Ring[Head].reset();
+        Head = (Head + 1) % Ring.size();
+        --Count;
+        return data;
+    }
+
+    /// 事件到达 (订阅回调中调用)
+    void OnEvent(DataType&& data)
+    {
+        std::coroutine_handle<> handle;
+        {
+            std::lock_guard lock(Mutex);
+            if (Stopped)
+                return;
+            PushLocked(std::move(data));
+            handle = std::exchange(WaitingHandle, nullptr);
+        }
+        if (handle)
+            handle.resume();
+    }
+
+    /// 首次等待时注册订阅 (实现在 EventBus 类定义之后)
+    void EnsureSubscribed();
+
+    /// 挂起前的检查: 缓冲区非空或已停止时不挂起
+    bool TrySuspend(std::coroutine_handle<> handle)
+    {
+        EnsureSubscribed();
+        std::lock_guard lock(Mutex);
+        if (Count > 0 || Stopped)
+            return false;
+        WaitingHandle = handle;
+        return true;
+    }
+
 public:
-    explicit EventStream(EventBus& bus) : Bus(bus) {}
+    explicit EventStream(EventBus& bus, StreamOptions options = {})
+        : Bus(bus)
+        , Options(options)
+        , Ring(options.Capacity > 0 ? options.Capacity : 1)
+    {}
 
     ~EventStream()
     {
-        Stop();
+        // 析构时不恢复等待者: 此时等待者所在的协程帧通常正在销毁
+        {
+            std::lock_guard lock(Mutex);
+            Stopped       = true;
+            WaitingHandle = nullptr;
+        }
+        Conn.Disconnect();
     }
 
-    // Move-only
+    // Move-only (仅在开始 co_await 之前)
     EventStream(EventStream&& other) noexcept
         : Bus(other.Bus)
         , Conn(std::move(other.Conn))
-        , Buffer(std::move(other.Buffer))
+        , Options(other.Options)
+        , Ring(std::move(other.Ring))
+        , Head(other.Head)
+        , Count(other.Count)
+        , DroppedCount(other.DroppedCount)
         , WaitingHandle(other.WaitingHandle)
         , Stopped(other.Stopped)
     {
+        assert(!Conn.IsConnected() && "EventStream — 不能移动已开始等待的 stream");
         other.WaitingHandle = nullptr;
         other.Stopped = true;
+        other.Count = 0;
     }
     EventStream(const EventStream&) = delete;
     EventStream& operator=(const EventStream&) = delete;
     EventStream& operator=(EventStream&&) = delete;
 
-    /// 停止流, 断开订阅, 使后续 co_await 返回 nullopt
+    /// 停止流, 断开订阅; 缓冲区取空后 co_await 返回 nullopt
     void Stop()
     {
-        Stopped = true;
-        Conn.Disconnect();
-        // 如果有协程在等待, 恢复它 (让它收到 nullopt)
-        if (WaitingHandle)
+        std::coroutine_handle<> handle;
         {
-            auto h = WaitingHandle;
-            WaitingHandle = nullptr;
-            h.resume();
+            std::lock_guard lock(Mutex);
+            Stopped = true;
+            handle  = std::exchange(WaitingHandle, nullptr);
         }
+        Conn.Disconnect();
+        // 如果有协程在等待, 恢复它 (让它收到 nullopt)
+        if (handle)
+            handle.resume();
+    }
+
+    /// 不挂起地取出一个缓冲事件
+    std::optional<DataType> TryNext()
+    {
+        std::lock_guard lock(Mutex);
+        if (Count == 0)
+            return std::nullopt;
+        return PopLocked();
+    }
+
+    /// 缓冲区中的事件数量
+    [[nodiscard]] size_t BufferedCount() const
+    {
+        std::lock_guard lock(Mutex);
+        return Count;
+    }
+
+    /// 因缓冲区溢出被丢弃 (或被合并) 的事件数量
+    [[nodiscard]] uint64_t GetDroppedCount() const
+    {
+        std::lock_guard lock(Mutex);
+        return DroppedCount;
     }
 
     // ----------------------------------------------------------------
@@ -279,8 +664,8 @@ public:
     // ----------------------------------------------------------------
     //
     // 每次 co_await stream 返回 std::optional<DataType>:
-    //   - 有值 → 收到了事件数据
-    //   - nullopt → 流已停止 (Stop() 被调用或 stream 被销毁)
+    //   - 有值 → 收到了事件数据 (缓冲区中最旧的一个)
+    //   - nullopt → 流已停止且缓冲区为空
     //
 
     /// Awaiter — co_await stream 的中间对象
@@ -288,27 +673,55 @@ public:
     {
         EventStream& Stream;
 
-        bool await_ready() const noexcept
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle)
         {
-            // 如果流已停止, 立即返回 (不挂起)
-            return Stream.Stopped;
+            return Stream.TrySuspend(handle);
         }
 
-        void await_suspend(std::coroutine_handle<> handle);
-        // 实现在 EventBus 类定义之后
-
         std::optional<DataType> await_resume()
         {
-            if (Stream.Stopped && !Stream.Buffer.has_value())
-                return std::nullopt;
-            auto result = std::move(Stream.Buffer);
-            Stream.Buffer.reset();
-            return result;
+            return Stream.TryNext();
+        }
+    };
+
+    /// BatchAwaiter — co_await stream.NextBatch(n) 的中间对象
+    struct BatchAwaiter
+    {
+        EventStream& Stream;
+        size_t       MaxCount;
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            return Stream.TrySuspend(handle);
+        }
+
+        std::vector<DataType> await_resume()
+        {
+            std::vector<DataType> batch;
+            std::lock_guard lock(Stream.Mutex);
+            size_t n = std::min(MaxCount, Stream.Count);
+            batch.reserve(n);
+            while (n-- > 0)
+                batch.push_back(Stream.PopLocked());
+            return batch;
         }
     };
 
     /// 使 EventStream 可被 co_await
     Awaiter operator co_await() { return Awaiter{*this}; }
+
+    /// 等待并一次取出最多 maxCount 个事件; 返回空 vector 表示流已停止
+    /// maxCount 为 0 时无法区分 "未取出" 与 "已停止", 抛出 std::invalid_argument
+    BatchAwaiter NextBatch(size_t maxCount = std::numeric_limits<size_t>::max())
+    {
+        if (maxCount == 0)
+            throw std::invalid_argument("EventStream::NextBatch — maxCount 必须大于 0");
+        return BatchAwaiter{*this, maxCount};
+    }
 };
 
 
@@ -49,20 +49,24 @@
 //
 // ============================================================================
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <limits>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 
 #include "MPMCQueue.h"
-#include "Coroutine.h"
+#include "FrameClock.h"
+#include "Executor.h"
 
 namespace Core::Bus
 {
@@ -248,6 +252,16 @@ public:
 };
 
 
+// Coroutine.h 中的 EventAwaiter / EventStream 依赖上面的 IsSignal 与 Connection,
+// 而 EventBus 的 Await / Stream 又需要它们的声明, 因此在此处包含.
+} // namespace Core::Bus
+
+#include "Coroutine.h"
+
+namespace Core::Bus
+{
+
+
 // ============================================================================
 //  Section 5: IChannel — 通道基类 (内部使用)
 // ============================================================================
@@ -266,6 +280,29 @@ struct IChannel
 };
 
 
+// ----------------------------------------------------------------------------
+// RateLimit — 订阅限流策略
+// ----------------------------------------------------------------------------
+//
+// 由 Channel 在 Emit 时判断, 被抑制的事件直接跳过, 不会调用 std::function 回调.
+// 时间统一取自 FrameClock::Now() (单调帧时间).
+//
+enum class ERateLimit : uint8_t
+{
+    None,     // 不限流
+    Throttle, // 节流: 相邻两次回调至少间隔 Period (前沿触发, 第一个事件立即回调)
+    Debounce, // 防抖: 事件停止 Period 后, 以最后一次的参数回调一次 (后沿触发, 仅由 FlushAsyncEvents 补发)
+    Sample,   // 采样: 每 EveryN 个事件回调一次 (第 1, N+1, 2N+1 ... 个)
+};
+
+struct RateLimit
+{
+    ERateLimit           Mode   = ERateLimit::None;
+    FrameClock::Duration Period = {};
+    uint32_t             EveryN = 1;
+};
+
+
 // ============================================================================
 //  Section 6: Channel<Args...> — 类型安全的事件通道
 // ============================================================================
@@ -294,13 +331,86 @@ struct IChannel
 // ■ 一次性订阅 (OneShot):
 //   通过 atomic<bool> 保证即使多线程并发 Emit, 一次性回调也只执行一次.
 //
+// ■ 限流订阅 (RateLimit):
+//   Throttle / Sample 在 Emit 中直接判断, 被抑制的事件不调用回调.
+//   Debounce 在 Emit 中只记录最后一次参数, 由 FlushAsyncEvents (每帧)
+//   在静默期结束后补发一次 — 因此防抖订阅依赖帧循环调用 FlushAllAsync.
+//
+// ■ 执行器订阅 (Executor):
+//   订阅可绑定到一个 IExecutor, 回调不在 Emit 线程执行, 而是投递到执行器.
+//   订阅变化时 (写路径) 按执行器把这类订阅预先分组为 ExecutorBatch,
+//   Emit 对每个执行器只 Post 一次: 闭包持有快照与参数副本, 在执行器上
+//   依次调用该组的全部回调. N 个同执行器订阅 → 1 次队列操作.
+//
+// ■ 优先级与消费 (Priority / Consumer):
+//   SlotList 在订阅时按 Priority 降序插入 (同优先级保持订阅顺序),
+//   Emit 直接按列表顺序调用, 热路径无需排序.
+//   可消费订阅的回调返回 true 时事件被消费, Emit 立即停止遍历,
+//   低优先级订阅及执行器订阅都不再收到该事件.
+//
 template<typename... Args>
 class Channel final : public IChannel
 {
 public:
     using CallbackType = std::function<void(const Args&...)>;
+    using ConsumerType = std::function<bool(const Args&...)>;
     using SlotId       = uint64_t;
 
+    /// Limiter — 限流订阅的运行时状态 (跨 CoW 快照共享)
+    struct Limiter
+    {
+        using Ticks = FrameClock::Clock::rep;
+        static constexpr Ticks NeverTicks = std::numeric_limits<Ticks>::min();
+
+        RateLimit             Policy;
+        std::atomic<Ticks>    LastTicks{NeverTicks}; // Throttle: 上次回调时间; Debounce: 上次事件时间
+        std::atomic<uint64_t> Counter{0};            // Sample: 已收到的事件数
+
+        // Debounce: 静默期内最后一次事件的参数
+        std::mutex                         PendingMutex;
+        std::optional<std::tuple<Args...>> Pending;
+
+        explicit Limiter(RateLimit policy) : Policy(policy) {}
+
+        /// Emit 时调用: 返回 true 表示本次应立即回调
+        bool Admit(const Args&... args)
+        {
+            switch (Policy.Mode)
+            {
+            case ERateLimit::Throttle:
+            {
+                Ticks now  = FrameClock::Now().time_since_epoch().count();
+                Ticks last = LastTicks.load(std::memory_order_relaxed);
+                if (last != NeverTicks && now - last < Policy.Period.count())
+                    return false;
+                // CAS: 并发 Emit 时同一时间窗内只放行一个
+                return LastTicks.compare_exchange_strong(last, now, std::memory_order_relaxed);
+            }
+            case ERateLimit::Sample:
+                return Counter.fetch_add(1, std::memory_order_relaxed) % Policy.EveryN == 0;
+            case ERateLimit::Debounce:
+            {
+                std::lock_guard lock(PendingMutex);
+                Pending.emplace(args...);
+                LastTicks.store(FrameClock::Now().time_since_epoch().count(), std::memory_order_relaxed);
+                return false;
+            }
+            default:
+                return true;
+            }
+        }
+
+        /// Debounce: 若静默期已过, 取出待补发的参数
+        std::optional<std::tuple<Args...>> TakeSettled(FrameClock::TimePoint now)
+        {
+            std::lock_guard lock(PendingMutex);
+            if (!Pending || now.time_since_epoch().count() - LastTicks.load(std::memory_order_relaxed)
+                                < Policy.Period.count())
+                return std::nullopt;
+            return std::exchange(Pending, std::nullopt);
+        }
+    };
+
     /// Slot — 订阅槽, 存储一个回调及其元信息
     struct Slot
     {
@@ -312,10 +422,34 @@ public:
         // 使用 shared_ptr 以便在 CoW 快照间共享状态.
         // 仅 OneShot == true 时非空.
         std::shared_ptr<std::atomic<bool>> Fired;
+
+        // 限流状态, 仅限流订阅时非空
+        std::shared_ptr<Limiter> Gate;
+
+        // 投递目标, 为空时在 Emit 线程同步执行
+        IExecutor* Executor;
+
+        // 优先级, 越大越先调用
+        int32_t Priority = 0;
+
+        // 可消费回调, 非空时替代 Callback; 返回 true 则停止传递
+        ConsumerType Consumer;
     };
 
 private:
-    using SlotList    = std::vector<Slot>;
+    /// ExecutorBatch — 同一执行器上的订阅在 Slots 中的下标
+    struct ExecutorBatch
+    {
+        IExecutor*            Target;
+        std::vector<uint32_t> SlotIndices;
+    };
+
+    /// SlotList — CoW 快照: 订阅列表及按执行器分组的投递批次
+    struct SlotList
+    {
+        std::vector<Slot>          Slots;
+        std::vector<ExecutorBatch> Batches;
+    };
     using SlotListPtr = std::shared_ptr<const SlotList>;
 
     // Copy-on-Write 核心: mutex 只保护 SlotsPtr 的读写, 不保护回调执行
@@ -324,6 +458,8 @@ private:
 
     std::atomic<SlotId>   NextId{1};
     std::atomic<uint64_t> EmitCount{0};
+    std::atomic<size_t>   DebounceSlotCount{0}; // 为 0 时 FlushAsyncEvents 跳过防抖扫描
+    std::atomic<size_t>   LiveWaiters{0};       // 挂起中的 EventAwaiter 数量
 
     // 异步事件队列 (lock-free MPMC)
     MPMCQueue<std::tuple<Args...>, 4096> AsyncQueue;
@@ -335,6 +471,71 @@ private:
         return SlotsPtr;
     }
 
+    /// CoW: 重建执行器批次后替换 shared_ptr (调用方需持有 Mutex)
+    void Publish(std::shared_ptr<SlotList> newSlots)
+    {
+        newSlots->Batches.clear();
+        for (uint32_t i = 0; i < newSlots->Slots.size(); ++i)
+        {
+            IExecutor* target = newSlots->Slots[i].Executor;
+            if (!target)
+                continue;
+            auto it = std::find_if(newSlots->Batches.begin(), newSlots->Batches.end(),
+                [target](const ExecutorBatch& b) { return b.Target == target; });
+            if (it == newSlots->Batches.end())
+                it = newSlots->Batches.insert(newSlots->Batches.end(), ExecutorBatch{target, {}});
+            it->SlotIndices.push_back(i);
+        }
+        SlotsPtr = std::move(newSlots);
+    }
+
+    /// CoW: 复制现有列表, 按优先级插入新 Slot, 替换 shared_ptr
+    SlotId AddSlot(Slot slot)
+    {
+        SlotId id = slot.Id;
+        std::lock_guard lock(Mutex);
+        auto newSlots = std::make_shared<SlotList>(*SlotsPtr);
+        // 插在第一个优先级更低的 Slot 之前, 同优先级保持 FIFO
+        auto pos = std::upper_bound(newSlots->Slots.begin(), newSlots->Slots.end(), slot.Priority,
+            [](int32_t priority, const Slot& s) { return priority > s.Priority; });
+        newSlots->Slots.insert(pos, std::move(slot));
+        Publish(std::move(newSlots));
+        return id;
+    }
+
+    /// 投递一个批次: 闭包持有快照 (保证 Slot 存活) 与参数副本
+    static void PostBatch(const SlotListPtr& snapshot, size_t batchIndex, const Args&... args)
+    {
+        const auto& batch = snapshot->Batches[batchIndex];
+        batch.Target->Post([snapshot, batchIndex, payload = std::tuple<Args...>(args...)]()
+        {
+            for (uint32_t index : snapshot->Batches[batchIndex].SlotIndices)
+                std::apply(snapshot->Slots[index].Callback, payload);
+        });
+    }
+
+    /// 补发静默期已结束的防抖事件, 返回补发数量
+    size_t FlushDebounced()
+    {
+        if (DebounceSlotCount.load(std::memory_order_relaxed) == 0)
+            return 0;
+
+        size_t count    = 0;
+        auto   now      = FrameClock::Now();
+        auto   snapshot = GetSnapshot();
+        for (const auto& slot : snapshot->Slots)
+        {
+            if (!slot.Gate || slot.Gate->Policy.Mode != ERateLimit::Debounce)
+                continue;
+            if (auto settled = slot.Gate->TakeSettled(now))
+            {
+                std::apply(slot.Callback, *settled);
+                ++count;
+            }
+        }
+        return count;
+    }
+
 public:
     // ----------------------------------------------------------------
     // Subscribe — 添加订阅
@@ -347,22 +548,120 @@ public:
     // ----------------------------------------------------------------
     SlotId Subscribe(CallbackType callback, bool oneShot = false)
     {
-        SlotId id = NextId.fetch_add(1, std::memory_order_relaxed);
-
-        std::lock_guard lock(Mutex);
-        // CoW: 复制现有列表, 追加新 Slot, 替换 shared_ptr
-        auto newSlots = std::make_shared<SlotList>(*SlotsPtr);
-        newSlots->push_back(Slot{
-            .Id       = id,
+        return AddSlot(Slot{
+            .Id       = NextId.fetch_add(1, std::memory_order_relaxed),
             .Callback = std::move(callback),
             .OneShot  = oneShot,
             .Fired    = oneShot
                 ? std::make_shared<std::atomic<bool>>(false)
                 : nullptr,
+            .Gate     = nullptr,
+            .Executor = nullptr,
+            .Priority = 0,
+            .Consumer = nullptr,
         });
-        SlotsPtr = std::move(newSlots);
+    }
 
-        return id;
+    // ----------------------------------------------------------------
+    // Subscribe — 添加限流订阅
+    //
+    // 参数:
+    //   callback — 回调函数, 签名为 void(const Args&...)
+    //   limit    — 限流策略 (Throttle / Debounce / Sample)
+    //
+    // 返回: 订阅 ID, 用于 Unsubscribe
+    // ----------------------------------------------------------------
+    SlotId Subscribe(CallbackType callback, RateLimit limit)
+    {
+        assert((limit.Mode != ERateLimit::Sample || limit.EveryN > 0) &&
+               "Channel::Subscribe — Sample 的 EveryN 必须大于 0");
+        if (limit.Mode == ERateLimit::None)
+            return Subscribe(std::move(callback));
+        if (limit.Mode == ERateLimit::Debounce)
+            DebounceSlotCount.fetch_add(1, std::memory_order_relaxed);
+
+        return AddSlot(Slot{
+            .Id       = NextId.fetch_add(1, std::memory_order_relaxed),
+            .Callback = std::move(callback),
+            .OneShot  = false,
+            .Fired    = nullptr,
+            .Gate     = std::make_shared<Limiter>(limit),
+            .Executor = nullptr,
+            .Priority = 0,
+            .Consumer = nullptr,
+        });
+    }
+
+    // ----------------------------------------------------------------
+    // Subscribe — 添加执行器订阅
+    //
+    // 参数:
+    //   callback — 回调函数, 签名为 void(const Args&...)
+    //   executor — 回调的执行器, 必须比该订阅活得更久
+    //
+    // 返回: 订阅 ID, 用于 Unsubscribe
+    //
+    // 注意: 断开后, 已投递但尚未执行的批次仍可能调用回调一次
+    // ----------------------------------------------------------------
+    SlotId Subscribe(CallbackType callback, IExecutor& executor)
+    {
+        return AddSlot(Slot{
+            .Id       = NextId.fetch_add(1, std::memory_order_relaxed),
+            .Callback = std::move(callback),
+            .OneShot  = false,
+            .Fired    = nullptr,
+            .Gate     = nullptr,
+            .Executor = &executor,
+            .Priority = 0,
+            .Consumer = nullptr,
+        });
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeWithPriority — 添加带优先级的订阅
+    //
+    // 参数:
+    //   callback — 回调函数, 签名为 void(const Args&...)
+    //   priority — 优先级, 越大越先调用; 普通订阅为 0
+    //
+    // 返回: 订阅 ID, 用于 Unsubscribe
+    // ----------------------------------------------------------------
+    SlotId SubscribeWithPriority(CallbackType callback, int32_t priority)
+    {
+        return AddSlot(Slot{
+            .Id       = NextId.fetch_add(1, std::memory_order_relaxed),
+            .Callback = std::move(callback),
+            .OneShot  = false,
+            .Fired    = nullptr,
+            .Gate     = nullptr,
+            .Executor = nullptr,
+            .Priority = priority,
+            .Consumer = nullptr,
+        });
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeConsumer — 添加可消费订阅
+    //
+    // 参数:
+    //   consumer — 回调函数, 签名为 bool(const Args&...),
+    //              返回 true 表示事件已被消费, 停止向后续订阅者传递
+    //   priority — 优先级, 越大越先调用; 普通订阅为 0
+    //
+    // 返回: 订阅 ID, 用于 Unsubscribe
+    // ----------------------------------------------------------------
+    SlotId SubscribeConsumer(ConsumerType consumer, int32_t priority = 0)
+    {
+        return AddSlot(Slot{
+            .Id       = NextId.fetch_add(1, std::memory_order_relaxed),
+            .Callback = nullptr,
+            .OneShot  = false,
+            .Fired    = nullptr,
+            .Gate     = nullptr,
+            .Executor = nullptr,
+            .Priority = priority,
+            .Consumer = std::move(consumer),
+        });
     }
 
     // ----------------------------------------------------------------
@@ -372,8 +671,15 @@ public:
     {
         std::lock_guard lock(Mutex);
         auto newSlots = std::make_shared<SlotList>(*SlotsPtr);
-        std::erase_if(*newSlots, [id](const Slot& s) { return s.Id == id; });
-        SlotsPtr = std::move(newSlots);
+        std::erase_if(newSlots->Slots, [this, id](const Slot& s)
+        {
+            if (s.Id != id)
+                return false;
+            if (s.Gate && s.Gate->Policy.Mode == ERateLimit::Debounce)
+                DebounceSlotCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        });
+        Publish(std::move(newSlots));
     }
 
     // ----------------------------------------------------------------
@@ -385,8 +691,13 @@ public:
     //   - 回调中可安全调用 Subscribe / Unsubscribe
     //
     // 对于 OneShot 订阅: 使用 CAS 保证即使并发 Emit 也只执行一次
+    // 对于限流订阅: 被抑制的事件直接跳过, 不调用回调
+    // 对于执行器订阅: 每个执行器投递一次批次, 回调在执行器上执行
+    // 对于可消费订阅: 回调返回 true 后立即停止遍历
+    //
+    // 返回: true = 事件被某个可消费订阅消费
     // ----------------------------------------------------------------
-    void Emit(const Args&... args)
+    bool Emit(const Args&... args)
     {
         EmitCount.fetch_add(1, std::memory_order_relaxed);
 
@@ -395,9 +706,14 @@ public:
 
         // 步骤 2: 遍历快照调用回调 (无锁)
         std::vector<SlotId> oneShotsToRemove;
+        bool                consumed = false;
 
-        for (const auto& slot : *snapshot)
+        for (const auto& slot : snapshot->Slots)
         {
+            if (slot.Executor)
+                continue;
+            if (slot.Gate && !slot.Gate->Admit(args...))
+                continue;
             if (slot.OneShot)
             {
                 // CAS: 仅当 Fired 从 false → true 成功时才执行 (精确一次)
@@ -405,20 +721,33 @@ public:
                 if (!slot.Fired->compare_exchange_strong(expected, true))
                     continue;
             }
-            slot.Callback(args...);
+            if (slot.Consumer)
+                consumed = slot.Consumer(args...);
+            else
+                slot.Callback(args...);
             if (slot.OneShot)
                 oneShotsToRemove.push_back(slot.Id);
+            if (consumed)
+                break;
         }
 
-        // 步骤 3: 清理已触发的 OneShot 订阅
+        // 步骤 3: 按执行器批量投递 (事件已被消费时跳过)
+        if (!consumed)
+        {
+            for (size_t i = 0; i < snapshot->Batches.size(); ++i)
+                PostBatch(snapshot, i, args...);
+        }
+
+        // 步骤 4: 清理已触发的 OneShot 订阅
         if (!oneShotsToRemove.empty())
         {
             std::lock_guard lock(Mutex);
             auto newSlots = std::make_shared<SlotList>(*SlotsPtr);
             for (auto id : oneShotsToRemove)
-                std::erase_if(*newSlots, [id](const Slot& s) { return s.Id == id; });
-            SlotsPtr = std::move(newSlots);
+                std::erase_if(newSlots->Slots, [id](const Slot& s) { return s.Id == id; });
+            Publish(std::move(newSlots));
         }
+        return consumed;
     }
 
     // ----------------------------------------------------------------
@@ -437,10 +766,11 @@ public:
     // ----------------------------------------------------------------
     // FlushAsyncEvents — 刷新异步队列, 分发所有待处理事件
     //
-    // 将队列中的事件逐一取出并调用 Emit 分发.
+    // 将队列中的事件逐一取出并调用 Emit 分发,
+    // 随后补发静默期已结束的防抖 (Debounce) 事件.
     // 通常在主线程的帧循环中调用一次.
     //
-    // 返回: 本次处理的事件数量
+    // 返回: 本次处理的事件数量 (含补发的防抖事件)
     // ----------------------------------------------------------------
     size_t FlushAsyncEvents() override
     {
@@ -450,7 +780,7 @@ public:
             std::apply([this](const Args&... args) { Emit(args...); }, *event);
             ++count;
         }
-        return count;
+        return count + FlushDebounced();
     }
 
     // ----------------------------------------------------------------
@@ -460,7 +790,7 @@ public:
     /// 当前订阅者数量
     [[nodiscard]] size_t SubscriberCount() const
     {
-        return GetSnapshot()->size();
+        return GetSnapshot()->Slots.size();
     }
 
     /// 累计 Emit 次数 (含同步和异步刷新)
@@ -469,6 +799,15 @@ public:
         return EmitCount.load(std::memory_order_relaxed);
     }
 
+    /// 挂起中的协程等待者数量 (EventAwaiter / GuardedEventAwaiter)
+    [[nodiscard]] size_t GetLiveWaiterCount() const noexcept
+    {
+        return LiveWaiters.load(std::memory_order_relaxed);
+    }
+
+    void AddLiveWaiter() noexcept { LiveWaiters.fetch_add(1, std::memory_order_relaxed); }
+    void RemoveLiveWaiter() noexcept { LiveWaiters.fetch_sub(1, std::memory_order_relaxed); }
+
     /// 异步队列中待处理的事件数量 (近似值)
     [[nodiscard]] size_t PendingAsyncCount() const noexcept
     {
@@ -575,6 +914,25 @@ public:
         });
     }
 
+    // ----------------------------------------------------------------
+    // SubscribeWaiter — 协程等待者的一次性订阅 (供 EventAwaiter 使用)
+    //
+    // 与 Subscribe(callback, true) 相同, 另外计入 LiveWaiterCount,
+    // 直到返回的 Connection 断开.
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeWaiter(typename SignalType::CallbackType callback)
+    {
+        auto& channel = GetOrCreateChannel<SignalType>();
+        auto slotId   = channel.Subscribe(std::move(callback), /*oneShot=*/true);
+        channel.AddLiveWaiter();
+
+        return Connection([&channel, slotId]() {
+            channel.Unsubscribe(slotId);
+            channel.RemoveLiveWaiter();
+        });
+    }
+
     // ----------------------------------------------------------------
     // SubscribeFiltered — 带过滤条件的订阅
     //
@@ -605,10 +963,141 @@ public:
             typename SignalType::CallbackType{std::move(wrapped)});
     }
 
+    // ----------------------------------------------------------------
+    // SubscribeRateLimited — 按 RateLimit 策略限流的订阅
+    //
+    // 限流在 Channel 内部判断, 被抑制的事件不会调用 callback.
+    // 常用形式见下方 SubscribeThrottled / SubscribeDebounced / SubscribeSampled.
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeRateLimited(
+        RateLimit limit,
+        typename SignalType::CallbackType callback)
+    {
+        auto& channel = GetOrCreateChannel<SignalType>();
+        auto slotId   = channel.Subscribe(std::move(callback), limit);
+
+        return Connection([&channel, slotId]() {
+            channel.Unsubscribe(slotId);
+        });
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeThrottled — 节流: 相邻两次回调至少间隔 interval
+    //
+    // 第一个事件立即回调, 之后 interval 内的事件被丢弃.
+    //
+    // 示例:
+    //   // 血条 UI 每秒最多刷新 10 次
+    //   auto conn = bus.SubscribeThrottled<OnHealthChanged>(
+    //       std::chrono::milliseconds(100), [](int hp) { ... });
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeThrottled(
+        FrameClock::Duration interval,
+        typename SignalType::CallbackType callback)
+    {
+        return SubscribeRateLimited<SignalType>(
+            RateLimit{.Mode = ERateLimit::Throttle, .Period = interval}, std::move(callback));
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeDebounced — 防抖: 事件停止 quietPeriod 后回调一次
+    //
+    // 回调收到的是静默期前最后一个事件的参数,
+    // 只在 FlushAllAsync / FlushAsync<SignalType> (帧循环) 中触发:
+    // Emit 本身从不调用防抖回调, 不刷新异步队列则静默期过后也不会回调.
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeDebounced(
+        FrameClock::Duration quietPeriod,
+        typename SignalType::CallbackType callback)
+    {
+        return SubscribeRateLimited<SignalType>(
+            RateLimit{.Mode = ERateLimit::Debounce, .Period = quietPeriod}, std::move(callback));
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeSampled — 采样: 每 everyN 个事件回调一次
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeSampled(
+        uint32_t everyN,
+        typename SignalType::CallbackType callback)
+    {
+        return SubscribeRateLimited<SignalType>(
+            RateLimit{.Mode = ERateLimit::Sample, .EveryN = everyN}, std::move(callback));
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeOn — 订阅并指定回调的执行器
+    //
+    // Emit 不在调用线程执行 callback, 而是投递到 executor;
+    // 同一执行器上的所有订阅在一次 Emit 中合并为一次投递.
+    //
+    // 示例:
+    //   auto conn = bus.SubscribeOn<OnAssetLoaded>(
+    //       ThreadPoolExecutor::GetDefault(), [](const AssetHandle& h) { ... });
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeOn(
+        IExecutor& executor,
+        typename SignalType::CallbackType callback)
+    {
+        auto& channel = GetOrCreateChannel<SignalType>();
+        auto slotId   = channel.Subscribe(std::move(callback), executor);
+
+        return Connection([&channel, slotId]() {
+            channel.Unsubscribe(slotId);
+        });
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeWithPriority — 带优先级的订阅
+    //
+    // priority 越大越先调用, 普通订阅为 0; 同优先级按订阅顺序调用.
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeWithPriority(
+        int32_t priority,
+        typename SignalType::CallbackType callback)
+    {
+        auto& channel = GetOrCreateChannel<SignalType>();
+        auto slotId   = channel.SubscribeWithPriority(std::move(callback), priority);
+
+        return Connection([&channel, slotId]() {
+            channel.Unsubscribe(slotId);
+        });
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeConsumer — 可消费订阅
+    //
+    // consumer 返回 true 表示事件已被消费, Emit 不再传递给后续订阅者.
+    //
+    // 示例:
+    //   // 弹窗优先处理点击, 命中时阻止其下方的控件收到
+    //   auto conn = bus.SubscribeConsumer<OnMouseClick>(100,
+    //       [&](float x, float y) { return popup.HitTest(x, y); });
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    [[nodiscard]] Connection SubscribeConsumer(
+        int32_t priority,
+        typename ChannelFor<SignalType>::ConsumerType consumer)
+    {
+        auto& channel = GetOrCreateChannel<SignalType>();
+        auto slotId   = channel.SubscribeConsumer(std::move(consumer), priority);
+
+        return Connection([&channel, slotId]() {
+            channel.Unsubscribe(slotId);
+        });
+    }
+
     // ----------------------------------------------------------------
     // Emit — 同步发布事件
     //
     // 在调用线程上立即触发所有订阅者的回调.
+    // 返回 true 表示事件被可消费订阅消费.
     //
     // 模板参数: SignalType — 要发布的信号类型
     // 参数:     args...   — 事件携带的数据, 类型必须与 Signal 定义匹配
@@ -617,10 +1106,10 @@ public:
     //   bus.Emit<OnDamage>(50, std::string("Fireball"));
     // ----------------------------------------------------------------
     template<IsSignal SignalType, typename... EmitArgs>
-    void Emit(EmitArgs&&... args)
+    bool Emit(EmitArgs&&... args)
     {
         auto& channel = GetOrCreateChannel<SignalType>();
-        channel.Emit(std::forward<EmitArgs>(args)...);
+        return channel.Emit(std::forward<EmitArgs>(args)...);
     }
 
     // ----------------------------------------------------------------
@@ -685,6 +1174,13 @@ public:
         return SubscriberCount<SignalType>() > 0;
     }
 
+    /// 正在 co_await 指定信号的协程数量 (用于排查泄漏的等待)
+    template<IsSignal SignalType>
+    [[nodiscard]] size_t LiveWaiterCount()
+    {
+        return GetOrCreateChannel<SignalType>().GetLiveWaiterCount();
+    }
+
     // ----------------------------------------------------------------
     // Await — 协程: 一次性等待某个信号 (co_await)
     //
@@ -713,12 +1209,15 @@ public:
     // Stream — 协程: 持续监听信号流 (循环 co_await)
     //
     // 返回一个 EventStream 对象, 可在循环中反复 co_await.
-    // 每次 Emit 后恢复协程, 返回最新的事件数据.
+    // 事件先写入有界缓冲区, 每次 co_await 按到达顺序取出一个
+    // (或用 NextBatch 取出一批), 协程运行期间到达的事件不会丢失.
+    //
+    // 参数: options — 缓冲区容量与溢出策略 (默认 64, DropOldest)
     //
     // 返回: EventStream<SignalType>
     //       co_await stream 的结果为 std::optional<std::tuple<Args...>>
     //         - 有值: 收到事件
-    //         - nullopt: 流已停止 (Stop() 或析构)
+    //         - nullopt: 流已停止 (Stop()) 且缓冲区已取空
     //
     // 示例:
     //   EventTask MonitorDamage(EventBus& bus) {
@@ -731,9 +1230,9 @@ public:
     //   }
     // ----------------------------------------------------------------
     template<IsSignal SignalType>
-    [[nodiscard]] EventStream<SignalType> Stream()
+    [[nodiscard]] EventStream<SignalType> Stream(StreamOptions options = {})
     {
-        return EventStream<SignalType>(*this);
+        return EventStream<SignalType>(*this, options);
     }
 };
 
@@ -769,12 +1268,12 @@ public:
     /// 绑定到 EventBus (延迟初始化)
     void Bind(EventBus& bus) { Bus = &bus; }
 
-    /// 同步发布事件
+    /// 同步发布事件, 返回 true 表示事件被消费
     template<IsSignal SignalType, typename... EmitArgs>
-    void Emit(EmitArgs&&... args)
+    bool Emit(EmitArgs&&... args)
     {
         assert(Bus != nullptr && "Publisher::Emit — Publisher 未绑定到 EventBus");
-        Bus->Emit<SignalType>(std::forward<EmitArgs>(args)...);
+        return Bus->Emit<SignalType>(std::forward<EmitArgs>(args)...);
     }
 
     /// 异步发布事件 (入队)
@@ -901,6 +1400,92 @@ public:
         return *this;
     }
 
+    // ----------------------------------------------------------------
+    // SubscribeThrottled / SubscribeDebounced / SubscribeSampled — 限流订阅
+    //
+    // 适用于只需要每秒几次更新的 UI / 日志订阅者,
+    // 被抑制的事件在 Channel 内部直接跳过, 不会调用回调.
+    //
+    // 示例:
+    //   acceptor.SubscribeThrottled<OnPlayerMoved>(std::chrono::milliseconds(250),
+    //       [](const Vector3& pos) { UpdateMinimap(pos); })
+    //           .SubscribeSampled<OnFrameStats>(60, [](const FrameStats& s) { Log(s); });
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    Acceptor& SubscribeThrottled(
+        FrameClock::Duration interval,
+        typename SignalType::CallbackType callback)
+    {
+        assert(Bus != nullptr && "Acceptor::SubscribeThrottled — Acceptor 未绑定到 EventBus");
+        Connections.push_back(Bus->SubscribeThrottled<SignalType>(interval, std::move(callback)));
+        return *this;
+    }
+
+    template<IsSignal SignalType>
+    Acceptor& SubscribeDebounced(
+        FrameClock::Duration quietPeriod,
+        typename SignalType::CallbackType callback)
+    {
+        assert(Bus != nullptr && "Acceptor::SubscribeDebounced — Acceptor 未绑定到 EventBus");
+        Connections.push_back(Bus->SubscribeDebounced<SignalType>(quietPeriod, std::move(callback)));
+        return *this;
+    }
+
+    template<IsSignal SignalType>
+    Acceptor& SubscribeSampled(
+        uint32_t everyN,
+        typename SignalType::CallbackType callback)
+    {
+        assert(Bus != nullptr && "Acceptor::SubscribeSampled — Acceptor 未绑定到 EventBus");
+        Connections.push_back(Bus->SubscribeSampled<SignalType>(everyN, std::move(callback)));
+        return *this;
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeOn — 订阅并指定回调的执行器
+    //
+    // 示例:
+    //   acceptor.SubscribeOn<OnScoreChanged>(MainThreadExecutor::GetDefault(),
+    //       [](int score) { ui.SetScore(score); });
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    Acceptor& SubscribeOn(
+        IExecutor& executor,
+        typename SignalType::CallbackType callback)
+    {
+        assert(Bus != nullptr && "Acceptor::SubscribeOn — Acceptor 未绑定到 EventBus");
+        Connections.push_back(Bus->SubscribeOn<SignalType>(executor, std::move(callback)));
+        return *this;
+    }
+
+    // ----------------------------------------------------------------
+    // SubscribeWithPriority / SubscribeConsumer — 按优先级传递
+    //
+    // 示例 (UI 事件: 自上而下分发, 命中的控件消费事件):
+    //   for (auto* w : widgets)
+    //       acceptor.SubscribeConsumer<OnMouseClick>(w->ZOrder(),
+    //           [w](float x, float y) { return w->HandleClick(x, y); });
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+    Acceptor& SubscribeWithPriority(
+        int32_t priority,
+        typename SignalType::CallbackType callback)
+    {
+        assert(Bus != nullptr && "Acceptor::SubscribeWithPriority — Acceptor 未绑定到 EventBus");
+        Connections.push_back(Bus->SubscribeWithPriority<SignalType>(priority, std::move(callback)));
+        return *this;
+    }
+
+    template<IsSignal SignalType>
+    Acceptor& SubscribeConsumer(
+        int32_t priority,
+        typename ChannelFor<SignalType>::ConsumerType consumer)
+    {
+        assert(Bus != nullptr && "Acceptor::SubscribeConsumer — Acceptor 未绑定到 EventBus");
+        Connections.push_back(Bus->SubscribeConsumer<SignalType>(priority, std::move(consumer)));
+        return *this;
+    }
+
     // ----------------------------------------------------------------
     // 管理接口
     // ----------------------------------------------------------------
@@ -947,10 +1532,10 @@ public:
     //   }
     // ----------------------------------------------------------------
     template<IsSignal SignalType>
-    [[nodiscard]] EventStream<SignalType> Stream()
+    [[nodiscard]] EventStream<SignalType> Stream(StreamOptions options = {})
     {
         assert(Bus != nullptr && "Acceptor::Stream — Acceptor 未绑定到 EventBus");
-        return Bus->Stream<SignalType>();
+        return Bus->Stream<SignalType>(options);
     }
 };
 
@@ -967,60 +1552,128 @@ public:
 //   3. 恢复协程 (handle.resume())
 //   4. Connection 保存在 Awaiter 中, 保证生命周期
 //
+// 回调与 Cancel 通过 WaitState 仲裁, 已被取消的等待不会再恢复协程.
+// 与 GuardedEventAwaiter 相同, 注册期间 (Armed == false) 在其它线程到达的事件
+// 只写入 Result, 由 await_suspend 发现后返回 false; 此时 Conn 尚未赋值, 回调不能访问它.
+// 胜出的回调在恢复协程前断开订阅, LiveWaiterCount 随之减少.
+//
 template<typename SignalType>
     requires IsSignal<SignalType>
-void EventAwaiter<SignalType>::await_suspend(std::coroutine_handle<> handle)
+bool EventAwaiter<SignalType>::await_suspend(std::coroutine_handle<> handle)
 {
+    State = std::make_shared<WaitState>();
+
     // 注册 OneShot 订阅: 事件到达时写入 Result 并恢复协程
-    Conn = Bus.Subscribe<SignalType>(
-        [this, handle](const auto&... args)
+    Conn = Bus.SubscribeWaiter<SignalType>(
+        [this, handle, state = State](const auto&... args)
         {
-            Result.emplace(args...);
+            {
+                std::lock_guard lock(state->Mutex);
+                if (state->Settled)
+                    return;
+                state->Settled = true;
+                Result.emplace(args...);
+                if (!state->Armed)
+                    return; // await_suspend 尚未返回, 由它处理
+            }
+            Conn.Disconnect();
             handle.resume();
-        },
-        /*oneShot=*/true
+        }
     );
+
+    {
+        std::lock_guard lock(State->Mutex);
+        if (!State->Settled)
+        {
+            State->Armed = true;
+            return true;
+        }
+    }
+    Conn.Disconnect();
+    return false;
 }
 
 
 // ============================================================================
-//  延迟实现: EventStream::Awaiter::await_suspend
+//  延迟实现: GuardedEventAwaiter::await_suspend
 // ============================================================================
 //
-// 流程:
-//   1. 保存协程 handle 到 Stream.WaitingHandle
-//   2. 如果是首次 co_await, 注册持久订阅 (非 OneShot)
-//      回调中: 将数据写入 Buffer, 恢复协程
-//   3. 后续 co_await 复用同一订阅, 仅更新 WaitingHandle
+// 依次注册事件订阅、定时器、令牌回调, 最后置 Armed.
+// 注册期间已有来源胜出时, 断开全部来源并返回 false (不挂起).
 //
 template<typename SignalType>
     requires IsSignal<SignalType>
-void EventStream<SignalType>::Awaiter::await_suspend(
-    std::coroutine_handle<> handle)
+bool GuardedEventAwaiter<SignalType>::await_suspend(std::coroutine_handle<> handle)
 {
-    Stream.WaitingHandle = handle;
+    State = std::make_shared<GuardState>();
 
-    // 首次 co_await 时注册订阅
-    if (!Stream.Conn.IsConnected() && !Stream.Stopped)
+    Conn = Bus.SubscribeWaiter<SignalType>(
+        [this, handle, state = State](const auto&... args)
+        {
+            Settle(state, this, handle, [&] { Result.emplace(args...); });
+        }
+    );
+
+    if (Timeout)
     {
-        Stream.Conn = Stream.Bus.template Subscribe<SignalType>(
-            [&stream = Stream](const auto&... args)
-            {
-                stream.Buffer.emplace(args...);
-                if (stream.WaitingHandle)
-                {
-                    auto h = stream.WaitingHandle;
-                    stream.WaitingHandle = nullptr;
-                    h.resume();
-                }
-                // 如果没有协程在等待, 数据留在 Buffer 中
-                // 下次 co_await 时 await_ready 仍返回 false,
-                // 但 await_resume 会立即取走 Buffer 中的数据.
-                // 注意: 如果 Emit 频率 > co_await 频率, 中间的事件会被覆盖.
-                // 这是 Stream 的设计意图: 始终获取最新事件.
-            }
-        );
+        TimerNode.Callback = [this, handle, state = State]()
+        {
+            Settle(state, this, handle, [] {});
+        };
+        Wheel->AddTimer(TimerNode, *Timeout);
+    }
+
+    if (Token.CanBeCancelled())
+    {
+        Registration = Token.Register([this, handle, state = State]()
+        {
+            Settle(state, this, handle, [] {});
+        });
+        // 注册前令牌已被取消: Register 不会调用回调
+        if (!Registration.IsActive())
+        {
+            std::lock_guard lock(State->Mutex);
+            State->Settled = true;
+        }
     }
+
+    {
+        std::lock_guard lock(State->Mutex);
+        if (!State->Settled)
+        {
+            State->Armed = true;
+            return true;
+        }
+    }
+    ReleaseSources();
+    return false;
+}
+
+
+// ============================================================================
+//  延迟实现: EventStream::EnsureSubscribed
+// ============================================================================
+//
+// 首次 co_await 时注册持久订阅 (非 OneShot), 之后复用.
+// 回调把事件写入缓冲区, 协程正在等待时恢复它.
+//
+template<typename SignalType>
+    requires IsSignal<SignalType>
+void EventStream<SignalType>::EnsureSubscribed()
+{
+    if (Conn.IsConnected())
+        return;
+    {
+        std::lock_guard lock(Mutex);
+        if (Stopped)
+            return;
+    }
+    Conn = Bus.template Subscribe<SignalType>(
+        [this](const auto&... args)
+        {
+            OnEvent(DataType(args...));
+        }
+    );
 }
 
 } // namespace Core::Bus
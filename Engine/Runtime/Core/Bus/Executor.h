@@ -0,0 +1,282 @@
+#pragma once
+// ============================================================================
+// Executor.h — 订阅回调的执行器
+// ============================================================================
+//
+// 默认情况下, 回调 (以及被恢复的协程) 在调用 Emit 的线程上同步执行,
+// 重量级订阅者会阻塞发布者. 通过 EventBus::SubscribeOn 可以为单个订阅
+// 指定执行器, 回调被投递到执行器上异步执行.
+//
+// ■ 核心组件:
+//   IExecutor           — 执行器接口: Post 一个任务
+//   ThreadPoolExecutor  — 投递到 ThreadPool (默认为 GThreadPool())
+//   MainThreadExecutor  — 投递到主线程队列, 由帧循环调用 RunPending() 执行
+//   StrandExecutor      — 串行执行器: 任务在底层执行器上按投递顺序逐个执行
+//
+// ■ 批量投递:
+//   Channel 在订阅变化时按执行器预先分组, 一次 Emit 对每个执行器只 Post 一次,
+//   该批次内的所有回调在执行器上依次调用. 因此 200 个订阅在同一执行器上时,
+//   一次 Emit 只产生 1 次队列操作, 而不是 200 次.
+//
+// ■ 生命周期:
+//   执行器必须比其上的订阅以及尚未执行完的任务活得更久.
+//   断开订阅后, 已经投递但尚未执行的批次仍可能调用该回调一次.
+//
+// ■ 用法:
+//   // 在线程池上处理, 不阻塞发布者
+//   acceptor.SubscribeOn<OnAssetLoaded>(Core::Bus::ThreadPoolExecutor::GetDefault(),
+//       [](const AssetHandle& h) { Decompress(h); });
+//
+//   // 回到主线程更新 UI
+//   acceptor.SubscribeOn<OnScoreChanged>(Core::Bus::MainThreadExecutor::GetDefault(),
+//       [](int score) { ui.SetScore(score); });
+//
+//   // 帧循环中
+//   Core::Bus::MainThreadExecutor::GetDefault().RunPending();
+// ============================================================================
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Core/ThreadPool/ThreadPool.h"
+
+namespace Core::Bus
+{
+
+// ============================================================================
+//  Section 1: IExecutor — 执行器接口
+// ============================================================================
+
+class IExecutor
+{
+public:
+    virtual ~IExecutor() = default;
+
+    /// 投递一个任务, 由执行器在其线程上异步执行. 必须是线程安全的.
+    virtual void Post(std::function<void()> work) = 0;
+};
+
+
+// ============================================================================
+//  Section 2: ThreadPoolExecutor — 线程池执行器
+// ============================================================================
+//
+// 任务以 IQueueWork 的形式加入线程池队列 (不创建 std::future).
+// 同一执行器上的不同批次可能在不同工作线程上并发执行.
+//
+class ThreadPoolExecutor final : public IExecutor
+{
+    class Work final : public IQueueWork
+    {
+        std::function<void()> Fn;
+        ETaskPriority         Priority;
+
+    public:
+        Work(std::function<void()> fn, ETaskPriority priority)
+            : Fn(std::move(fn)), Priority(priority) {}
+
+        void DoThreadWork() override { Fn(); }
+        ETaskPriority GetPriority() const override { return Priority; }
+    };
+
+    ThreadPool&   Pool;
+    ETaskPriority Priority;
+
+public:
+    explicit ThreadPoolExecutor(ThreadPool& pool, ETaskPriority priority = ETaskPriority::Normal)
+        : Pool(pool), Priority(priority) {}
+
+    /// 绑定到 GThreadPool() 的默认执行器
+    static ThreadPoolExecutor& GetDefault()
+    {
+        static ThreadPoolExecutor instance(GThreadPool());
+        return instance;
+    }
+
+    void Post(std::function<void()> work) override
+    {
+        Pool.AddQueuedWork(new Work(std::move(work), Priority));
+    }
+
+    [[nodiscard]] ThreadPool& GetPool() const noexcept { return Pool; }
+};
+
+
+// ============================================================================
+//  Section 3: MainThreadExecutor — 主线程执行器
+// ============================================================================
+//
+// Post 可从任意线程调用; 任务在帧循环调用 RunPending() 的线程上执行.
+// RunPending 执行期间新投递的任务留到下一次 RunPending (任务内部嵌套调用 RunPending 时立即执行).
+// 任务抛出异常时, 本批中尚未执行的任务放回队首, 异常继续传播; 已执行的任务不会重复执行.
+//
+class MainThreadExecutor final : public IExecutor
+{
+    std::mutex                         Mutex;
+    std::vector<std::function<void()>> Pending;
+    std::vector<std::function<void()>> Spare; // 上一批用完的缓冲, 复用容量, 避免每帧分配
+
+public:
+    /// 全局默认主线程执行器
+    static MainThreadExecutor& GetDefault()
+    {
+        static MainThreadExecutor instance;
+        return instance;
+    }
+
+    void Post(std::function<void()> work) override
+    {
+        std::lock_guard lock(Mutex);
+        Pending.push_back(std::move(work));
+    }
+
+    // ----------------------------------------------------------------
+    // RunPending — 执行所有已投递的任务 (在主线程的帧循环中调用)
+    //
+    // 返回: 本次执行的任务数量
+    // 本批任务取到局部变量中执行, 因此任务内部可以安全地 Post 或嵌套调用 RunPending
+    // ----------------------------------------------------------------
+    size_t RunPending()
+    {
+        std::vector<std::function<void()>> batch;
+        {
+            std::lock_guard lock(Mutex);
+            batch.swap(Spare);
+            batch.swap(Pending);
+        }
+
+        size_t index = 0;
+        try
+        {
+            for (; index < batch.size(); ++index)
+                batch[index]();
+        }
+        catch (...)
+        {
+            std::lock_guard lock(Mutex);
+            Pending.insert(Pending.begin(),
+                           std::make_move_iterator(batch.begin() + index + 1),
+                           std::make_move_iterator(batch.end()));
+            throw;
+        }
+
+        batch.clear();
+        {
+            std::lock_guard lock(Mutex);
+            if (Spare.capacity() < batch.capacity())
+                Spare.swap(batch);
+        }
+        return index;
+    }
+
+    /// 待执行的任务数量
+    [[nodiscard]] size_t PendingCount()
+    {
+        std::lock_guard lock(Mutex);
+        return Pending.size();
+    }
+};
+
+
+// ============================================================================
+//  Section 4: StrandExecutor — 串行执行器
+// ============================================================================
+//
+// 在底层执行器 (通常是 ThreadPoolExecutor) 之上保证串行:
+// 任务按 Post 顺序执行, 同一时刻最多只有一个任务在运行,
+// 相当于一个不独占线程的 "专用工作线程".
+//
+// 实现: 队列非空时只向底层执行器投递一个 Drain 任务, Drain 依次执行
+// 队列中的所有任务, 队列为空时退出; 之后的 Post 会重新投递 Drain.
+// 任务抛出异常时, 剩余任务放回队首并重新投递 Drain, 异常继续向底层执行器传播
+// (ThreadPool 会吞掉异常), strand 不会因此停止.
+//
+class StrandExecutor final : public IExecutor
+{
+    IExecutor&                         Target;
+    std::mutex                         Mutex;
+    std::vector<std::function<void()>> Queue;
+    bool                               Scheduled = false;
+
+    void Drain()
+    {
+        std::vector<std::function<void()>> batch;
+        for (;;)
+        {
+            {
+                std::lock_guard lock(Mutex);
+                if (Queue.empty())
+                {
+                    Scheduled = false;
+                    return;
+                }
+                batch.swap(Queue);
+            }
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                try
+                {
+                    batch[i]();
+                }
+                catch (...)
+                {
+                    Requeue(batch, i + 1);
+                    throw;
+                }
+            }
+            batch.clear();
+        }
+    }
+
+    // 任务抛出异常时: 未执行的剩余批次放回队首 (保持投递顺序),
+    // Scheduled 保持为 true 并重新投递 Drain, 异常继续交给底层执行器处理
+    void Requeue(std::vector<std::function<void()>>& batch, size_t next)
+    {
+        {
+            std::lock_guard lock(Mutex);
+            Queue.insert(Queue.begin(),
+                         std::make_move_iterator(batch.begin() + static_cast<std::ptrdiff_t>(next)),
+                         std::make_move_iterator(batch.end()));
+            if (Queue.empty())
+            {
+                Scheduled = false;
+                return;
+            }
+        }
+        try
+        {
+            Target.Post([this]() { Drain(); });
+        }
+        catch (...)
+        {
+            // 无法重新投递: 交还调度权, 下一次 Post 会再投递 Drain
+            std::lock_guard lock(Mutex);
+            Scheduled = false;
+        }
+    }
+
+public:
+    explicit StrandExecutor(IExecutor& target = ThreadPoolExecutor::GetDefault())
+        : Target(target) {}
+
+    StrandExecutor(const StrandExecutor&)            = delete;
+    StrandExecutor& operator=(const StrandExecutor&) = delete;
+
+    void Post(std::function<void()> work) override
+    {
+        {
+            std::lock_guard lock(Mutex);
+            Queue.push_back(std::move(work));
+            if (Scheduled)
+                return;
+            Scheduled = true;
+        }
+        Target.Post([this]() { Drain(); });
+    }
+};
+
+} // namespace Core::Bus
@@ -0,0 +1,96 @@
+#pragma once
+// ============================================================================
+// FrameClock.h — 单调帧时间源
+// ============================================================================
+//
+// 为事件系统提供统一的 "当前时间": 由帧循环在每帧开始时推进一次,
+// 同一帧内所有 Emit / 定时判断看到的是同一个时间点, 结果可复现.
+//
+// ■ 两种工作状态:
+//   - 未驱动: 从未调用 Tick/Set 时, Now() 直接返回 steady_clock::now()
+//   - 帧驱动: 帧循环每帧调用 Tick() (或回放时调用 Set(t)), Now() 返回帧时间
+//
+// ■ 单调性:
+//   Set 传入比当前更早的时间会被忽略, 保证 Now() 永不回退.
+//
+// ■ 用法:
+//   void GameLoop() {
+//       Core::Bus::FrameClock::Tick();
+//       Core::TimerWheel::GetDefault().Tick(Core::Bus::FrameClock::Now());
+//       bus.FlushAllAsync();
+//       // ... 后续逻辑 ...
+//   }
+//
+// ■ 线程安全: 所有方法均可从任意线程调用 (内部为 atomic).
+// ============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Core::Bus
+{
+
+class FrameClock
+{
+public:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration  = Clock::duration;
+
+    /// 每帧开始时调用一次: 帧时间推进到当前单调时间, 帧序号 +1
+    static void Tick() noexcept
+    {
+        Set(Clock::now());
+        FrameCounter().fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /// 直接设置帧时间 (回放 / 测试用); 早于当前帧时间的值会被忽略
+    static void Set(TimePoint time) noexcept
+    {
+        auto  ticks   = time.time_since_epoch().count();
+        auto& current = FrameTicks();
+        auto  old     = current.load(std::memory_order_relaxed);
+        while (old < ticks &&
+               !current.compare_exchange_weak(old, ticks, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// 回到未驱动状态 (Now() 重新使用实时时钟)
+    static void Reset() noexcept
+    {
+        FrameTicks().store(0, std::memory_order_release);
+        FrameCounter().store(0, std::memory_order_release);
+    }
+
+    /// 当前帧时间; 未驱动时为实时单调时间
+    [[nodiscard]] static TimePoint Now() noexcept
+    {
+        auto ticks = FrameTicks().load(std::memory_order_acquire);
+        if (ticks == 0)
+            return Clock::now();
+        return TimePoint(Duration(ticks));
+    }
+
+    /// 已经过的帧数 (Tick 的调用次数)
+    [[nodiscard]] static uint64_t FrameIndex() noexcept
+    {
+        return FrameCounter().load(std::memory_order_acquire);
+    }
+
+private:
+    static std::atomic<Clock::rep>& FrameTicks() noexcept
+    {
+        static std::atomic<Clock::rep> ticks{0};
+        return ticks;
+    }
+
+    static std::atomic<uint64_t>& FrameCounter() noexcept
+    {
+        static std::atomic<uint64_t> counter{0};
+        return counter;
+    }
+};
+
+} // namespace Core::Bus
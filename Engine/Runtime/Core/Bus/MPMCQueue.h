@@ -85,40 +85,24 @@ private:
     alignas(CacheLineSize) std::atomic<size_t>   EnqueuePos{0};
     alignas(CacheLineSize) std::atomic<size_t>   DequeuePos{0};
 
-public:
-    MPMCQueue()
-    {
-        // 初始化: 每个 Cell 的序列号设为其索引值, 表示 "可写入" 状态
-        for (size_t i = 0; i < Capacity; ++i)
-            Buffer[i].Sequence.store(i, std::memory_order_relaxed);
-    }
-
-    // 不可复制, 不可移动 (内含原子变量, 语义上不允许)
-    MPMCQueue(const MPMCQueue&)            = delete;
-    MPMCQueue& operator=(const MPMCQueue&) = delete;
-    MPMCQueue(MPMCQueue&&)                 = delete;
-    MPMCQueue& operator=(MPMCQueue&&)      = delete;
-
     // ------------------------------------------------------------------------
-    // TryPush — 尝试入队一个元素 (生产者调用)
-    //
-    // 返回: true = 入队成功, false = 队列已满
+    // AcquireWriteCell — 抢占一个可写入的 Cell
     //
     // 流程:
     //   1. load(EnqueuePos)     → 获取当前想要写入的位置 pos
     //   2. load(Cell.Sequence)  → 读取该 Cell 的序列号 seq
     //   3. 如果 seq == pos      → 表示该 Cell 空闲可写,
     //      CAS(EnqueuePos, pos, pos+1) 抢占此位置
-    //   4. 写入数据, 更新 Cell.Sequence = pos + 1 (标记为 "可读取")
+    //
+    // 返回: 抢占到的 Cell (pos 为其入队位置), 队列已满时返回 nullptr
     // ------------------------------------------------------------------------
-    [[nodiscard]] bool TryPush(T item)
+    Cell* AcquireWriteCell(size_t& pos)
     {
-        Cell* cell;
-        size_t pos = EnqueuePos.load(std::memory_order_relaxed);
+        pos = EnqueuePos.load(std::memory_order_relaxed);
 
         for (;;)
         {
-            cell = &Buffer[pos & Mask];
+            Cell* cell = &Buffer[pos & Mask];
             size_t seq = cell->Sequence.load(std::memory_order_acquire);
             auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
 
@@ -127,12 +111,12 @@ public:
                 // Cell 可写, 通过 CAS 抢占入队位置
                 if (EnqueuePos.compare_exchange_weak(
                         pos, pos + 1, std::memory_order_relaxed))
-                    break;
+                    return cell;
             }
             else if (diff < 0)
             {
                 // seq < pos → 队列已满
-                return false;
+                return nullptr;
             }
             else
             {
@@ -140,33 +124,26 @@ public:
                 pos = EnqueuePos.load(std::memory_order_relaxed);
             }
         }
-
-        cell->Data = std::move(item);
-        // 更新序列号 → 通知消费者此 Cell 可读
-        cell->Sequence.store(pos + 1, std::memory_order_release);
-        return true;
     }
 
     // ------------------------------------------------------------------------
-    // TryPop — 尝试出队一个元素 (消费者调用)
-    //
-    // 返回: std::optional<T>, 有值 = 出队成功, 空 = 队列为空
+    // AcquireReadCell — 抢占一个可读取的 Cell
     //
     // 流程:
     //   1. load(DequeuePos)     → 获取当前想要读取的位置 pos
     //   2. load(Cell.Sequence)  → 读取该 Cell 的序列号 seq
     //   3. 如果 seq == pos + 1  → 表示该 Cell 已写入数据可读,
     //      CAS(DequeuePos, pos, pos+1) 抢占此位置
-    //   4. 移动数据, 更新 Cell.Sequence = pos + Capacity (标记为 "可写入")
+    //
+    // 返回: 抢占到的 Cell (pos 为其出队位置), 队列为空时返回 nullptr
     // ------------------------------------------------------------------------
-    [[nodiscard]] std::optional<T> TryPop()
+    Cell* AcquireReadCell(size_t& pos)
     {
-        Cell* cell;
-        size_t pos = DequeuePos.load(std::memory_order_relaxed);
+        pos = DequeuePos.load(std::memory_order_relaxed);
 
         for (;;)
         {
-            cell = &Buffer[pos & Mask];
+            Cell* cell = &Buffer[pos & Mask];
             size_t seq = cell->Sequence.load(std::memory_order_acquire);
             auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
 
@@ -175,12 +152,12 @@ public:
                 // Cell 可读, 通过 CAS 抢占出队位置
                 if (DequeuePos.compare_exchange_weak(
                         pos, pos + 1, std::memory_order_relaxed))
-                    break;
+                    return cell;
             }
             else if (diff < 0)
             {
                 // seq < pos + 1 → 队列为空
-                return std::nullopt;
+                return nullptr;
             }
             else
             {
@@ -188,12 +165,97 @@ public:
                 pos = DequeuePos.load(std::memory_order_relaxed);
             }
         }
+    }
+
+public:
+    MPMCQueue()
+    {
+        // 初始化: 每个 Cell 的序列号设为其索引值, 表示 "可写入" 状态
+        for (size_t i = 0; i < Capacity; ++i)
+            Buffer[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // 不可复制, 不可移动 (内含原子变量, 语义上不允许)
+    MPMCQueue(const MPMCQueue&)            = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    MPMCQueue(MPMCQueue&&)                 = delete;
+    MPMCQueue& operator=(MPMCQueue&&)      = delete;
 
-        T result = std::move(cell->Data);
+    // ------------------------------------------------------------------------
+    // TryPush — 尝试入队一个元素 (生产者调用)
+    //
+    // 返回: true = 入队成功, false = 队列已满
+    //
+    // 流程:
+    //   1. AcquireWriteCell     → 通过 CAS 抢占入队位置 pos
+    //   2. 写入数据, 更新 Cell.Sequence = pos + 1 (标记为 "可读取")
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool TryPush(T item)
+    {
+        return TryPushInPlace([&item](T& slot) { slot = std::move(item); });
+    }
+
+    // ------------------------------------------------------------------------
+    // TryPushInPlace — 尝试入队, 由 writer 直接在 Cell 内写入数据
+    //
+    // writer 签名: void(T& slot)
+    // 返回: true = 入队成功, false = 队列已满 (writer 不会被调用)
+    //
+    // 与 TryPush 的区别: 不需要先在栈上构造一个完整的 T 再移动进来,
+    // 适用于 T 为较大的定长记录 (如共享内存中的事件记录).
+    // ------------------------------------------------------------------------
+    template<typename WriterFn>
+    [[nodiscard]] bool TryPushInPlace(WriterFn&& writer)
+    {
+        size_t pos;
+        Cell* cell = AcquireWriteCell(pos);
+        if (!cell)
+            return false;
+
+        writer(cell->Data);
+        // 更新序列号 → 通知消费者此 Cell 可读
+        cell->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // TryPop — 尝试出队一个元素 (消费者调用)
+    //
+    // 返回: std::optional<T>, 有值 = 出队成功, 空 = 队列为空
+    //
+    // 流程:
+    //   1. AcquireReadCell      → 通过 CAS 抢占出队位置 pos
+    //   2. 移动数据, 更新 Cell.Sequence = pos + Capacity (标记为 "可写入")
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::optional<T> TryPop()
+    {
+        std::optional<T> result;
+        (void)TryConsume([&result](T& data) { result.emplace(std::move(data)); });
+        return result;
+    }
+
+    // ------------------------------------------------------------------------
+    // TryConsume — 尝试出队, 由 reader 直接在 Cell 内读取数据 (零拷贝)
+    //
+    // reader 签名: void(T& data)
+    // 返回: true = 出队成功, false = 队列为空 (reader 不会被调用)
+    //
+    // reader 执行期间该 Cell 仍被当前消费者占有, 生产者不会覆盖它;
+    // reader 返回后 Cell 才被标记为可写入. 因此 reader 中不应长时间阻塞.
+    // ------------------------------------------------------------------------
+    template<typename ReaderFn>
+    [[nodiscard]] bool TryConsume(ReaderFn&& reader)
+    {
+        size_t pos;
+        Cell* cell = AcquireReadCell(pos);
+        if (!cell)
+            return false;
+
+        reader(cell->Data);
         // 更新序列号 → 标记此 Cell 可被生产者重新写入
         // +Capacity 使得序列号回绕到下一轮
         cell->Sequence.store(pos + Capacity, std::memory_order_release);
-        return result;
+        return true;
     }
 
     // ------------------------------------------------------------------------
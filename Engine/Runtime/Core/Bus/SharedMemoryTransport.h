@@ -0,0 +1,501 @@
+#pragma once
+// ============================================================================
+// SharedMemoryTransport.h — 跨进程 EventBus 传输 (POSIX 共享内存)
+// ============================================================================
+//
+// 将引擎进程中选定的信号镜像到一块 POSIX 共享内存环形缓冲区中,
+// 使同一台机器上的工具进程 (Profiler UI / 回放录制 / 无头校验器 等)
+// 无需 socket 即可订阅这些事件.
+//
+// ■ 核心组件:
+//   StableSignalId<S>       — 跨进程稳定的信号标识 (类型名哈希)
+//   IsShareableSignal<S>    — 约束: 参数均为平凡可复制且能放入一条记录
+//   SharedEventRecord       — 环形缓冲区中的定长事件记录
+//   SharedMemoryTransport   — 绑定到 EventBus 的传输端 (Producer / Consumer)
+//
+// ■ 原理:
+//   共享内存中放置一个 MPMCQueue<SharedEventRecord, N>, 与进程内的
+//   异步队列使用同一套序列号协议 (Vyukov Bounded MPMC).
+//   - Producer: Mirror<S>() 在本地 EventBus 上订阅 S, 回调中直接在
+//     Cell 内写入记录 (TryPushInPlace), 队列满时丢弃并计数.
+//   - Consumer: Route<S>() 注册解码函数, Poll() 逐条 TryConsume 把记录拷出 Cell
+//     (256 字节), 出队提交后再以记录中的数据作为 const Args&... 调用本地 Emit.
+//     订阅者抛出异常不会卡住环形缓冲区.
+//
+// ■ 约束:
+//   - 仅支持平凡可复制 (trivially copyable) 的参数, 总大小 ≤ SharedEventPayloadCapacity.
+//     std::string / std::function 等含指针的类型跨进程没有意义.
+//   - 两端必须由同一份源码构建 (StableSignalId 基于编译器生成的类型名).
+//   - 每条事件只会被一个 Consumer 取走 (MPMC 语义);
+//     多个工具进程同时监听时, 请为每个工具创建独立的传输名.
+//   - 同名共享内存已存在时 Producer 构造失败; 确认是上次崩溃的残留后,
+//     可传入 ECreateMode::ReplaceStale 显式清理.
+//
+// ■ 用法:
+//   // 引擎进程
+//   Core::Bus::SharedMemoryTransport out(bus, "/potato_profiler",
+//       Core::Bus::SharedMemoryTransport::ERole::Producer);
+//   out.Mirror<OnFrameStats>().Mirror<OnHitch>();
+//
+//   // 工具进程
+//   Core::Bus::EventBus toolBus;
+//   Core::Bus::SharedMemoryTransport in(toolBus, "/potato_profiler",
+//       Core::Bus::SharedMemoryTransport::ERole::Consumer);
+//   in.Route<OnFrameStats>().Route<OnHitch>();
+//   Core::Bus::Acceptor acceptor(toolBus);
+//   acceptor.Subscribe<OnFrameStats>([](const FrameStats& s) { ... });
+//   while (running) in.Poll();
+//
+// ■ 平台: 仅 POSIX (Linux / macOS). 其他平台构造时抛出 std::runtime_error.
+// ============================================================================
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Bus.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define CORE_BUS_HAS_SHARED_MEMORY 1
+#else
+    #define CORE_BUS_HAS_SHARED_MEMORY 0
+#endif
+
+namespace Core::Bus
+{
+
+// ============================================================================
+//  Section 1: StableSignalId — 跨进程稳定的信号标识
+// ============================================================================
+//
+// TypeTag<T>::Value 是函数指针地址, 在 ASLR 下每个进程都不同, 不能写入共享内存.
+// 这里对编译器生成的函数签名 (包含 T 的完整类型名) 做 FNV-1a 哈希,
+// 同一份源码构建出的不同进程得到相同的值.
+//
+namespace Detail
+{
+    constexpr uint64_t Fnv1a(std::string_view text) noexcept
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : text)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    constexpr std::string_view TypeSignature() noexcept
+    {
+#if defined(_MSC_VER)
+        return __FUNCSIG__;
+#else
+        return __PRETTY_FUNCTION__;
+#endif
+    }
+
+    // 参数在记录 Payload 中的布局: 按声明顺序依次对齐排列
+    template<typename Tuple>
+    struct SharedPayloadLayout;
+
+    template<typename... Args>
+    struct SharedPayloadLayout<std::tuple<Args...>>
+    {
+        static constexpr size_t Count = sizeof...(Args);
+
+        static constexpr std::array<size_t, Count> Offsets = []
+        {
+            constexpr std::array<size_t, Count> sizes  = {sizeof(Args)...};
+            constexpr std::array<size_t, Count> aligns = {alignof(Args)...};
+            std::array<size_t, Count> offsets{};
+            size_t offset = 0;
+            for (size_t i = 0; i < Count; ++i)
+            {
+                offset = (offset + aligns[i] - 1) & ~(aligns[i] - 1);
+                offsets[i] = offset;
+                offset += sizes[i];
+            }
+            return offsets;
+        }();
+
+        static constexpr size_t Size = []
+        {
+            if constexpr (Count == 0)
+                return size_t{0};
+            else
+                return Offsets[Count - 1] + sizeof(std::tuple_element_t<Count - 1, std::tuple<Args...>>);
+        }();
+
+        static constexpr size_t MaxAlign = std::max({size_t{1}, alignof(Args)...});
+
+        static constexpr bool IsTriviallyCopyable = (std::is_trivially_copyable_v<Args> && ...);
+    };
+}
+
+template<IsSignal S>
+inline constexpr uint64_t StableSignalId = Detail::Fnv1a(Detail::TypeSignature<S>());
+
+
+// ============================================================================
+//  Section 2: SharedEventRecord — 共享内存中的定长事件记录
+// ============================================================================
+
+/// 单条记录可携带的最大参数字节数 (记录总大小为 256 字节)
+inline constexpr size_t SharedEventPayloadCapacity = 240;
+
+struct SharedEventRecord
+{
+    uint64_t SignalId;     // StableSignalId<S>
+    uint32_t PayloadSize;  // 实际写入的字节数 (用于两端一致性校验)
+    uint32_t Reserved;
+    alignas(16) std::byte Payload[SharedEventPayloadCapacity];
+};
+
+static_assert(std::is_trivially_copyable_v<SharedEventRecord>);
+static_assert(sizeof(SharedEventRecord) == 256);
+
+/// 可通过共享内存传输的信号: 参数平凡可复制, 且能放入一条记录
+template<typename S>
+concept IsShareableSignal = IsSignal<S>
+    && Detail::SharedPayloadLayout<typename S::ArgTypes>::IsTriviallyCopyable
+    && Detail::SharedPayloadLayout<typename S::ArgTypes>::Size <= SharedEventPayloadCapacity
+    && Detail::SharedPayloadLayout<typename S::ArgTypes>::MaxAlign <= alignof(SharedEventRecord);
+
+
+// ============================================================================
+//  Section 3: SharedMemoryTransport — 跨进程传输端
+// ============================================================================
+//
+// ■ 共享内存布局:
+//   [Header (魔数/版本/记录大小/就绪标记)] [MPMCQueue<SharedEventRecord, RingCapacity>]
+//
+//   Producer 创建共享内存, placement-new 构造队列, 最后以 release 语义写入 Ready.
+//   Consumer 打开已有的共享内存, 校验 Header 后直接使用其中的队列 (不再构造).
+//   跨进程使用原子变量要求其为 lock-free (地址无关), 见下方 static_assert.
+//
+// ■ 生命周期:
+//   Producer 以 O_EXCL 创建, 默认不会删除他人正在使用的同名共享内存.
+//   Producer 析构时 shm_unlink, 已映射的 Consumer 仍可读完剩余事件.
+//   Mirror 产生的订阅由传输端持有, 析构时先断开订阅再解除映射.
+//
+class SharedMemoryTransport
+{
+public:
+    static constexpr size_t RingCapacity = 4096;
+
+    enum class ERole : uint8_t
+    {
+        Producer, // 创建共享内存, 将本地信号镜像出去
+        Consumer, // 打开共享内存, 将收到的事件重新发布到本地 EventBus
+    };
+
+    /// Producer 遇到同名共享内存时的处理方式
+    enum class ECreateMode : uint8_t
+    {
+        Exclusive,    // 已存在则构造失败 (默认)
+        ReplaceStale, // 先 shm_unlink 再创建, 仅用于清理确认已无人使用的残留
+    };
+
+private:
+    static constexpr uint64_t Magic   = 0x53554250'4F544154ull; // "TATOPBUS"
+    static constexpr uint32_t Version = 1;
+
+    using QueueType = MPMCQueue<SharedEventRecord, RingCapacity>;
+
+    static_assert(std::atomic<size_t>::is_always_lock_free,
+        "SharedMemoryTransport: 跨进程原子操作要求 std::atomic<size_t> 为 lock-free");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+        "SharedMemoryTransport: 跨进程原子操作要求 std::atomic<uint32_t> 为 lock-free");
+
+    struct Header
+    {
+        uint64_t              Magic;
+        uint32_t              Version;
+        uint32_t              RecordSize;
+        uint64_t              QueueSize;
+        std::atomic<uint32_t> Ready;
+    };
+
+    struct Region
+    {
+        Header                           Head;
+        alignas(CacheLineSize) QueueType Queue;
+    };
+
+    /// 解码函数: 将一条记录作为 Signal S 的参数重新发布到本地总线, PayloadSize 不符时返回 false
+    using DispatchFn = bool(*)(EventBus&, const SharedEventRecord&);
+
+    EventBus&   Bus;
+    std::string Name;
+    ERole       Role;
+    Region*     Shared = nullptr;
+
+    std::vector<Connection>                    Connections; // Producer: Mirror 订阅
+    std::unordered_map<uint64_t, DispatchFn>   Routes;      // Consumer: 信号 → 解码函数
+
+    std::atomic<uint64_t> DroppedCount{0};   // Producer: 队列满被丢弃的事件
+    std::atomic<uint64_t> UnroutedCount{0};  // Consumer: 未 Route 的信号
+    std::atomic<uint64_t> MismatchCount{0};  // Consumer: PayloadSize 与本端布局不符的记录
+
+    // 按 SharedPayloadLayout 将参数逐个 memcpy 到记录中
+    template<IsSignal S, typename... Args>
+    static void WriteRecord(SharedEventRecord& record, const Args&... args)
+    {
+        using Layout = Detail::SharedPayloadLayout<typename S::ArgTypes>;
+        record.SignalId    = StableSignalId<S>;
+        record.PayloadSize = static_cast<uint32_t>(Layout::Size);
+        [&]<size_t... Is>(std::index_sequence<Is...>)
+        {
+            (std::memcpy(record.Payload + Layout::Offsets[Is], &args, sizeof(Args)), ...);
+        }(std::index_sequence_for<Args...>{});
+    }
+
+    // 直接以记录中的对象作为参数调用 Emit, 不再逐个拷贝参数
+    template<IsSignal S>
+    static bool DispatchRecord(EventBus& bus, const SharedEventRecord& record)
+    {
+        using ArgTypes = typename S::ArgTypes;
+        using Layout   = Detail::SharedPayloadLayout<ArgTypes>;
+        if (record.PayloadSize != Layout::Size)
+            return false;
+        [&]<size_t... Is>(std::index_sequence<Is...>)
+        {
+            bus.Emit<S>(*std::launder(reinterpret_cast<const std::tuple_element_t<Is, ArgTypes>*>(
+                record.Payload + Layout::Offsets[Is]))...);
+        }(std::make_index_sequence<Layout::Count>{});
+        return true;
+    }
+
+    static std::string NormalizeName(std::string_view name)
+    {
+        // POSIX 要求共享内存名以 '/' 开头
+        if (!name.empty() && name.front() == '/')
+            return std::string(name);
+        return "/" + std::string(name);
+    }
+
+    void MapRegion(ECreateMode mode)
+    {
+#if CORE_BUS_HAS_SHARED_MEMORY
+        const bool create = Role == ERole::Producer;
+        if (create && mode == ECreateMode::ReplaceStale)
+            ::shm_unlink(Name.c_str()); // 调用方已确认同名共享内存是无人使用的残留
+
+        int fd = ::shm_open(Name.c_str(), create ? (O_CREAT | O_EXCL | O_RDWR) : O_RDWR, 0600);
+        if (fd < 0)
+        {
+            if (create && errno == EEXIST)
+                throw std::runtime_error("SharedMemoryTransport: " + Name
+                    + " already exists (another producer, or a stale segment: use ECreateMode::ReplaceStale)");
+            throw std::runtime_error("SharedMemoryTransport: shm_open failed for " + Name);
+        }
+
+        if (create && ::ftruncate(fd, static_cast<off_t>(sizeof(Region))) != 0)
+        {
+            ::close(fd);
+            ::shm_unlink(Name.c_str());
+            throw std::runtime_error("SharedMemoryTransport: ftruncate failed for " + Name);
+        }
+
+        struct stat info{};
+        if (!create && (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Region)))
+        {
+            ::close(fd);
+            throw std::runtime_error("SharedMemoryTransport: " + Name + " is not initialized yet");
+        }
+
+        void* memory = ::mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd); // 映射建立后 fd 即可关闭
+        if (memory == MAP_FAILED)
+        {
+            if (create)
+                ::shm_unlink(Name.c_str());
+            throw std::runtime_error("SharedMemoryTransport: mmap failed for " + Name);
+        }
+
+        Shared = static_cast<Region*>(memory);
+        if (create)
+        {
+            // ftruncate 保证内存已清零; 在其上构造队列并发布 Header
+            ::new (&Shared->Queue) QueueType();
+            Shared->Head.Magic      = Magic;
+            Shared->Head.Version    = Version;
+            Shared->Head.RecordSize = sizeof(SharedEventRecord);
+            Shared->Head.QueueSize  = sizeof(QueueType);
+            Shared->Head.Ready.store(1, std::memory_order_release);
+        }
+        else if (Shared->Head.Ready.load(std::memory_order_acquire) != 1
+              || Shared->Head.Magic      != Magic
+              || Shared->Head.Version    != Version
+              || Shared->Head.RecordSize != sizeof(SharedEventRecord)
+              || Shared->Head.QueueSize  != sizeof(QueueType))
+        {
+            UnmapRegion();
+            throw std::runtime_error("SharedMemoryTransport: layout mismatch or not ready for " + Name);
+        }
+#else
+        (void)mode;
+        throw std::runtime_error("SharedMemoryTransport: shared memory is not supported on this platform");
+#endif
+    }
+
+    void UnmapRegion() noexcept
+    {
+#if CORE_BUS_HAS_SHARED_MEMORY
+        if (!Shared)
+            return;
+        ::munmap(Shared, sizeof(Region));
+        Shared = nullptr;
+        if (Role == ERole::Producer)
+            ::shm_unlink(Name.c_str());
+#endif
+    }
+
+public:
+    // ----------------------------------------------------------------
+    // 构造 — 创建 (Producer) 或打开 (Consumer) 名为 name 的共享内存
+    //
+    // mode 仅对 Producer 有效, 见 ECreateMode.
+    //
+    // 失败时抛出 std::runtime_error:
+    //   - 平台不支持 / shm_open / mmap 失败
+    //   - Producer 以 Exclusive 创建时同名共享内存已存在
+    //   - Consumer 打开时 Producer 尚未完成初始化, 或两端布局不一致
+    // ----------------------------------------------------------------
+    SharedMemoryTransport(EventBus& bus, std::string_view name, ERole role,
+                          ECreateMode mode = ECreateMode::Exclusive)
+        : Bus(bus)
+        , Name(NormalizeName(name))
+        , Role(role)
+    {
+        MapRegion(mode);
+    }
+
+    ~SharedMemoryTransport()
+    {
+        // 先断开订阅, 保证没有回调再访问即将解除映射的内存
+        Connections.clear();
+        UnmapRegion();
+    }
+
+    SharedMemoryTransport(const SharedMemoryTransport&)            = delete;
+    SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+
+    // ----------------------------------------------------------------
+    // Mirror — (Producer) 将本地总线上的 Signal S 镜像到共享内存
+    //
+    // 返回 *this 以支持链式调用.
+    // 队列满时事件被丢弃, 可通过 GetDroppedCount() 监控.
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+        requires IsShareableSignal<SignalType>
+    SharedMemoryTransport& Mirror()
+    {
+        assert(Role == ERole::Producer && "SharedMemoryTransport::Mirror — 仅 Producer 可镜像信号");
+        Connections.push_back(Bus.Subscribe<SignalType>(
+            [this](const auto&... args)
+            {
+                bool pushed = Shared->Queue.TryPushInPlace(
+                    [&](SharedEventRecord& record) { WriteRecord<SignalType>(record, args...); });
+                if (!pushed)
+                    DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            }));
+        return *this;
+    }
+
+    // ----------------------------------------------------------------
+    // Route — (Consumer) 将共享内存中的 Signal S 重新发布到本地总线
+    //
+    // 返回 *this 以支持链式调用.
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType>
+        requires IsShareableSignal<SignalType>
+    SharedMemoryTransport& Route()
+    {
+        assert(Role == ERole::Consumer && "SharedMemoryTransport::Route — 仅 Consumer 可路由信号");
+        Routes[StableSignalId<SignalType>] = &DispatchRecord<SignalType>;
+        return *this;
+    }
+
+    // ----------------------------------------------------------------
+    // Poll — (Consumer) 取出最多 maxEvents 条事件并在当前线程分发
+    //
+    // 记录先拷出共享内存并提交出队, 再分发; 订阅者收到的 const Args&...
+    // 仅在回调期间有效. 订阅者抛出的异常会传播给调用方, 该条事件已出队,
+    // 再次 Poll 从下一条继续.
+    // 未 Route 的信号计入 GetUnroutedCount(), PayloadSize 不符的记录计入
+    // GetMismatchCount(), 两者都被跳过.
+    //
+    // 返回: 本次取出的事件数量 (含跳过的)
+    // ----------------------------------------------------------------
+    size_t Poll(size_t maxEvents = std::numeric_limits<size_t>::max())
+    {
+        assert(Role == ERole::Consumer && "SharedMemoryTransport::Poll — 仅 Consumer 可读取事件");
+        size_t            count = 0;
+        SharedEventRecord record;
+        while (count < maxEvents &&
+               Shared->Queue.TryConsume([&record](const SharedEventRecord& cell) { record = cell; }))
+        {
+            ++count;
+            auto it = Routes.find(record.SignalId);
+            if (it == Routes.end())
+                UnroutedCount.fetch_add(1, std::memory_order_relaxed);
+            else if (!it->second(Bus, record))
+                MismatchCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    // ----------------------------------------------------------------
+    // 查询接口
+    // ----------------------------------------------------------------
+
+    [[nodiscard]] ERole GetRole() const noexcept { return Role; }
+    [[nodiscard]] const std::string& GetName() const noexcept { return Name; }
+
+    /// 因队列满被丢弃的事件数量 (Producer)
+    [[nodiscard]] uint64_t GetDroppedCount() const noexcept
+    {
+        return DroppedCount.load(std::memory_order_relaxed);
+    }
+
+    /// 收到但未 Route 的事件数量 (Consumer)
+    [[nodiscard]] uint64_t GetUnroutedCount() const noexcept
+    {
+        return UnroutedCount.load(std::memory_order_relaxed);
+    }
+
+    /// 收到但 PayloadSize 与本端布局不符的事件数量 (Consumer, 通常意味着两端源码不一致)
+    [[nodiscard]] uint64_t GetMismatchCount() const noexcept
+    {
+        return MismatchCount.load(std::memory_order_relaxed);
+    }
+
+    /// 共享队列中待处理的事件数量 (近似值)
+    [[nodiscard]] size_t PendingCount() const noexcept
+    {
+        return Shared->Queue.ApproxSize();
+    }
+};
+
+} // namespace Core::Bus
@@ -0,0 +1,449 @@
+#pragma once
+// ============================================================================
+// StaticEventBus.h — 编译期信号路由 (零开销 EventBus 变体)
+// ============================================================================
+//
+// 当信号集合在编译期已知时, 动态 EventBus 的以下开销都是多余的:
+//   - TypeId 哈希查找 Channel (unordered_map + mutex)
+//   - std::function 的双重间接调用
+//   - CoW 快照 (shared_ptr 引用计数 + mutex)
+//
+// StaticEventBus<Signals...> 用 tuple<vector<Slot>...> 存储订阅,
+// 信号 → 下标的映射在编译期完成, Emit 只是一次线性遍历 + 函数指针调用.
+// 对外保持与 EventBus 相同的 Emit / Subscribe 接口, 系统可以直接切换.
+//
+// ■ 核心组件:
+//   StaticDelegate<Args...>    — 无堆分配 (小对象内联) 的回调, 单次间接调用
+//   StaticEventBus<Signals...> — 编译期信号集合的事件总线
+//
+// ■ 三种订阅方式:
+//   bus.Subscribe<OnDamage>([this](int dmg, const std::string& src) { ... }); // 任意可调用对象
+//   bus.Subscribe<OnDamage, &OnDamageFree>();                                 // 编译期自由函数
+//   bus.Subscribe<OnDamage, &Player::OnDamage>(player);                       // 编译期成员函数
+//   后两种的调用目标是模板参数, 会被直接内联到分发桩函数中.
+//
+// ■ 线程模型:
+//   StaticEventBus 不是线程安全的, 所有操作应在同一线程 (通常是主线程) 进行.
+//   回调中可以安全地 Subscribe / 断开连接:
+//     - Emit 期间新增的订阅在本次 Emit 结束后才生效
+//     - Emit 期间断开的订阅立即不再被调用, 存储 (含回调对象) 在最外层 Emit 结束后回收,
+//       因此回调可以断开自身
+//
+// ■ 可消费订阅:
+//   回调返回 bool 时视为可消费订阅, 返回 true 后停止遍历, Emit 返回 true (与 EventBus 一致)
+//
+// ■ 用法:
+//   struct OnDamage : Core::Bus::Signal<OnDamage, int, std::string> {};
+//   struct OnDeath  : Core::Bus::Signal<OnDeath> {};
+//
+//   Core::Bus::StaticEventBus<OnDamage, OnDeath> bus;
+//   auto conn = bus.Subscribe<OnDamage>([](int dmg, const std::string& src) { ... });
+//   bus.Emit<OnDamage>(50, std::string("Fireball"));
+//   bus.Emit<OnHeal>(10); // 编译错误: OnHeal 不在信号集合中
+// ============================================================================
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Bus.h"
+
+namespace Core::Bus
+{
+
+// ============================================================================
+//  Section 1: StaticDelegate<Args...> — 轻量回调
+// ============================================================================
+//
+// 一个函数指针 + 一块内联存储:
+//   - 可平凡复制且不超过 InlineSize 的可调用对象 (如 [this] lambda) 直接存入内联缓冲区
+//   - 其他可调用对象放在堆上, 内联缓冲区只存指针
+// 调用只有一次经由 Invoke 函数指针的间接跳转 (std::function 通常为两次).
+// 返回 bool 的可调用对象的返回值会被透传 (true = 事件已消费), 其他返回类型视为 false.
+//
+template<typename... Args>
+class StaticDelegate
+{
+    static constexpr size_t InlineSize = 3 * sizeof(void*);
+
+    using InvokeFn  = bool(*)(void*, const Args&...);
+    using DestroyFn = void(*)(void*);
+
+    alignas(void*) std::byte Storage[InlineSize]{};
+    InvokeFn  Invoke  = nullptr;
+    DestroyFn Destroy = nullptr; // 仅堆存储时非空
+
+    template<typename F>
+    static constexpr bool FitsInline = sizeof(F) <= InlineSize
+        && alignof(F) <= alignof(void*)
+        && std::is_trivially_copyable_v<F>
+        && std::is_trivially_destructible_v<F>;
+
+    template<typename F, typename... T>
+    static bool InvokeTarget(F&& fn, T&&... targetArgs)
+    {
+        if constexpr (std::is_same_v<std::invoke_result_t<F, T...>, bool>)
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<T>(targetArgs)...);
+        }
+        else
+        {
+            std::invoke(std::forward<F>(fn), std::forward<T>(targetArgs)...);
+            return false;
+        }
+    }
+
+public:
+    StaticDelegate() = default;
+
+    /// 从任意可调用对象构造
+    template<typename F>
+        requires (!std::is_same_v<std::remove_cvref_t<F>, StaticDelegate>
+               && std::is_invocable_v<std::remove_cvref_t<F>&, const Args&...>)
+    StaticDelegate(F&& fn)
+    {
+        using Fn = std::remove_cvref_t<F>;
+        if constexpr (FitsInline<Fn>)
+        {
+            ::new (static_cast<void*>(Storage)) Fn(std::forward<F>(fn));
+            Invoke = [](void* storage, const Args&... args)
+            {
+                return InvokeTarget(*std::launder(reinterpret_cast<Fn*>(storage)), args...);
+            };
+        }
+        else
+        {
+            Fn* heap = new Fn(std::forward<F>(fn));
+            std::memcpy(Storage, &heap, sizeof(heap));
+            Invoke = [](void* storage, const Args&... args)
+            {
+                Fn* target;
+                std::memcpy(&target, storage, sizeof(target));
+                return InvokeTarget(*target, args...);
+            };
+            Destroy = [](void* storage)
+            {
+                Fn* target;
+                std::memcpy(&target, storage, sizeof(target));
+                delete target;
+            };
+        }
+    }
+
+    /// 绑定编译期自由函数 (调用目标为模板参数, 可被内联)
+    template<auto Function>
+        requires std::is_invocable_v<decltype(Function), const Args&...>
+    static StaticDelegate Bind()
+    {
+        StaticDelegate delegate;
+        delegate.Invoke = [](void*, const Args&... args) { return InvokeTarget(Function, args...); };
+        return delegate;
+    }
+
+    /// 绑定编译期成员函数到对象 (调用者保证 object 的生命周期长于订阅)
+    template<auto Method, typename T>
+        requires std::is_invocable_v<decltype(Method), T&, const Args&...>
+    static StaticDelegate Bind(T& object)
+    {
+        StaticDelegate delegate;
+        T* target = &object;
+        std::memcpy(delegate.Storage, &target, sizeof(target));
+        delegate.Invoke = [](void* storage, const Args&... args)
+        {
+            T* self;
+            std::memcpy(&self, storage, sizeof(self));
+            return InvokeTarget(Method, *self, args...);
+        };
+        return delegate;
+    }
+
+    ~StaticDelegate() { Reset(); }
+
+    // Move-only: 内联对象可平凡复制, 堆对象只转移指针, 因此移动即按字节拷贝
+    StaticDelegate(StaticDelegate&& other) noexcept
+        : Invoke(std::exchange(other.Invoke, nullptr))
+        , Destroy(std::exchange(other.Destroy, nullptr))
+    {
+        std::memcpy(Storage, other.Storage, InlineSize);
+    }
+
+    StaticDelegate& operator=(StaticDelegate&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            std::memcpy(Storage, other.Storage, InlineSize);
+            Invoke  = std::exchange(other.Invoke, nullptr);
+            Destroy = std::exchange(other.Destroy, nullptr);
+        }
+        return *this;
+    }
+
+    StaticDelegate(const StaticDelegate&)            = delete;
+    StaticDelegate& operator=(const StaticDelegate&) = delete;
+
+    /// 释放可调用对象, 之后 IsBound() 为 false
+    void Reset() noexcept
+    {
+        if (Destroy)
+            Destroy(Storage);
+        Invoke  = nullptr;
+        Destroy = nullptr;
+    }
+
+    [[nodiscard]] bool IsBound() const noexcept { return Invoke != nullptr; }
+
+    /// 调用回调, 返回 true 表示事件已被消费
+    bool operator()(const Args&... args) { return Invoke(Storage, args...); }
+};
+
+
+// ============================================================================
+//  Section 2: 类型辅助
+// ============================================================================
+
+namespace Detail
+{
+    /// 信号 S 在 Signals... 中的下标 (不存在时为 sizeof...(Signals))
+    template<typename S, typename... Signals>
+    inline constexpr size_t SignalIndex = []
+    {
+        constexpr bool matches[] = {std::is_same_v<S, Signals>..., false};
+        size_t index = 0;
+        while (index < sizeof...(Signals) && !matches[index])
+            ++index;
+        return index;
+    }();
+
+    template<typename Tuple>
+    struct TupleToDelegate;
+
+    template<typename... Args>
+    struct TupleToDelegate<std::tuple<Args...>>
+    {
+        using Type = StaticDelegate<Args...>;
+    };
+}
+
+/// 从 Signal 类型推导 StaticDelegate 类型
+/// 例: StaticDelegateFor<OnDamage> → StaticDelegate<int, std::string>
+template<IsSignal S>
+using StaticDelegateFor = typename Detail::TupleToDelegate<typename S::ArgTypes>::Type;
+
+
+// ============================================================================
+//  Section 3: StaticEventBus<Signals...>
+// ============================================================================
+
+template<IsSignal... Signals>
+class StaticEventBus
+{
+public:
+    using SlotId = uint64_t;
+
+    /// S 是否属于此总线的信号集合
+    template<typename S>
+    static constexpr bool Contains = Detail::SignalIndex<S, Signals...> < sizeof...(Signals);
+
+private:
+    template<IsSignal S>
+    struct Slot
+    {
+        SlotId               Id;       // 0 = 已断开, 等待 Compact 回收
+        StaticDelegateFor<S> Callback;
+    };
+
+    template<IsSignal S>
+    struct SlotStorage
+    {
+        std::vector<Slot<S>> Active;
+        std::vector<Slot<S>> Pending;  // Emit 期间新增的订阅
+        bool                 HasDead = false;
+    };
+
+    std::tuple<SlotStorage<Signals>...> Storage;
+    SlotId   NextId    = 1;
+    uint32_t EmitDepth = 0;
+
+    template<IsSignal S>
+    SlotStorage<S>& StorageOf() noexcept
+    {
+        return std::get<Detail::SignalIndex<S, Signals...>>(Storage);
+    }
+
+    template<IsSignal S>
+    const SlotStorage<S>& StorageOf() const noexcept
+    {
+        return std::get<Detail::SignalIndex<S, Signals...>>(Storage);
+    }
+
+    template<IsSignal S>
+    Connection AddSlot(StaticDelegateFor<S> callback)
+    {
+        SlotId id = NextId++;
+        auto&  storage = StorageOf<S>();
+        // Emit 期间不修改 Active, 避免 vector 扩容导致正在执行的回调被移动
+        (EmitDepth > 0 ? storage.Pending : storage.Active)
+            .push_back(Slot<S>{id, std::move(callback)});
+        return Connection([this, id]() { Unsubscribe<S>(id); });
+    }
+
+    template<IsSignal S>
+    void Unsubscribe(SlotId id)
+    {
+        auto& storage = StorageOf<S>();
+        std::erase_if(storage.Pending, [id](const Slot<S>& s) { return s.Id == id; });
+        for (auto& slot : storage.Active)
+        {
+            if (slot.Id != id)
+                continue;
+            if (EmitDepth > 0)
+            {
+                // Emit 期间只标记, 不能 Reset: 断开的可能正是当前执行中的回调 (自我断开)
+                slot.Id         = 0;
+                storage.HasDead = true;
+            }
+            else
+            {
+                std::erase_if(storage.Active, [id](const Slot<S>& s) { return s.Id == id; });
+            }
+            return;
+        }
+    }
+
+    template<IsSignal S>
+    void Compact()
+    {
+        auto& storage = StorageOf<S>();
+        if (storage.HasDead)
+        {
+            std::erase_if(storage.Active, [](const Slot<S>& s) { return s.Id == 0; });
+            storage.HasDead = false;
+        }
+        if (!storage.Pending.empty())
+        {
+            for (auto& slot : storage.Pending)
+                storage.Active.push_back(std::move(slot));
+            storage.Pending.clear();
+        }
+    }
+
+    /// Emit 作用域: 回调抛出异常时也要恢复 EmitDepth 并回收
+    struct EmitScope
+    {
+        StaticEventBus& Bus;
+
+        explicit EmitScope(StaticEventBus& bus) noexcept : Bus(bus) { ++Bus.EmitDepth; }
+        ~EmitScope()
+        {
+            if (--Bus.EmitDepth == 0)
+                (Bus.template Compact<Signals>(), ...); // 回调中可能订阅/断开了其他信号
+        }
+    };
+
+    template<IsSignal S, typename... Args>
+    bool Dispatch(std::type_identity<std::tuple<Args...>>, std::type_identity_t<const Args&>... args)
+    {
+        auto&     active = StorageOf<S>().Active;
+        EmitScope scope(*this);
+        for (size_t i = 0, n = active.size(); i < n; ++i)
+        {
+            if (active[i].Id != 0 && active[i].Callback(args...))
+                return true;
+        }
+        return false;
+    }
+
+public:
+    StaticEventBus() = default;
+
+    // 不可复制, 不可移动 (Connection 中的闭包引用此 bus)
+    StaticEventBus(const StaticEventBus&)            = delete;
+    StaticEventBus& operator=(const StaticEventBus&) = delete;
+
+    // ----------------------------------------------------------------
+    // Subscribe — 订阅信号 (任意可调用对象)
+    //
+    // 返回: Connection (RAII 句柄, 销毁时自动取消订阅)
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType, typename CallbackFn>
+        requires Contains<SignalType>
+    [[nodiscard]] Connection Subscribe(CallbackFn&& callback)
+    {
+        return AddSlot<SignalType>(StaticDelegateFor<SignalType>(std::forward<CallbackFn>(callback)));
+    }
+
+    // ----------------------------------------------------------------
+    // Subscribe — 订阅信号 (编译期自由函数)
+    //
+    // 示例:
+    //   void OnDamageLog(const int& dmg, const std::string& src);
+    //   auto conn = bus.Subscribe<OnDamage, &OnDamageLog>();
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType, auto Function>
+        requires Contains<SignalType>
+    [[nodiscard]] Connection Subscribe()
+    {
+        return AddSlot<SignalType>(StaticDelegateFor<SignalType>::template Bind<Function>());
+    }
+
+    // ----------------------------------------------------------------
+    // Subscribe — 订阅信号 (编译期成员函数)
+    //
+    // 示例:
+    //   auto conn = bus.Subscribe<OnDamage, &HealthBar::OnDamage>(healthBar);
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType, auto Method, typename T>
+        requires Contains<SignalType>
+    [[nodiscard]] Connection Subscribe(T& object)
+    {
+        return AddSlot<SignalType>(StaticDelegateFor<SignalType>::template Bind<Method>(object));
+    }
+
+    // ----------------------------------------------------------------
+    // Emit — 同步发布事件
+    //
+    // 参数先转换为 const Args&... 一次, 再依次调用所有订阅者.
+    // 返回 true 表示事件被可消费订阅消费.
+    // ----------------------------------------------------------------
+    template<IsSignal SignalType, typename... EmitArgs>
+        requires Contains<SignalType>
+    bool Emit(EmitArgs&&... args)
+    {
+        return Dispatch<SignalType>(std::type_identity<typename SignalType::ArgTypes>{},
+                             std::forward<EmitArgs>(args)...);
+    }
+
+    // ----------------------------------------------------------------
+    // 查询接口
+    // ----------------------------------------------------------------
+
+    /// 获取指定信号的订阅者数量 (含 Emit 期间新增, 不含已断开的)
+    template<IsSignal SignalType>
+        requires Contains<SignalType>
+    [[nodiscard]] size_t SubscriberCount() const
+    {
+        const auto& storage = StorageOf<SignalType>();
+        size_t count = storage.Pending.size();
+        for (const auto& slot : storage.Active)
+            count += slot.Id != 0 ? 1 : 0;
+        return count;
+    }
+
+    /// 检查指定信号是否有订阅者
+    template<IsSignal SignalType>
+        requires Contains<SignalType>
+    [[nodiscard]] bool HasSubscribers() const
+    {
+        return SubscriberCount<SignalType>() > 0;
+    }
+};
+
+} // namespace Core::Bus
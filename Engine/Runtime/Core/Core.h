@@ -3,6 +3,9 @@
 #include "Core/Math/Vector.h"
 #include "Core/Math/Color.h"
 #include "Core/SoA/SoaDynamicArray.h"
+#include "Core/SoA/SoaChunkedArray.h"
+#include "Core/SoA/SoaMemoryResource.h"
+#include "Core/SoA/SoaReflected.h"
 #include "Core/CoreImpl.h"
 
 #include <utility>
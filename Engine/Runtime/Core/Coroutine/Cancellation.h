@@ -0,0 +1,178 @@
+#pragma once
+// ============================================================================
+// Cancellation.h — 协作式取消令牌
+// ============================================================================
+//
+// CancellationSource 发出取消请求, 从它取得的 CancellationToken 可以传给
+// 任意数量的等待操作. 等待操作通过 Register 注册回调, 取消时被调用.
+//
+//   Core::CancellationSource levelScope;
+//
+//   EventTask WaitBoss(EventBus& bus, Core::CancellationToken token)
+//   {
+//       auto killed = co_await bus.Await<OnBossKilled>().WithCancellation(token);
+//       if (!killed) co_return;   // 关卡卸载, 等待被取消
+//       ...
+//   }
+//
+//   levelScope.Cancel();          // 卸载关卡时一次性取消所有等待
+//
+// ■ 语义:
+//   - Cancel() 只生效一次, 回调在调用 Cancel 的线程上执行, 执行期间不持锁
+//   - 已取消的令牌上 Register 不会调用回调, 返回空注册 (调用方自行检查)
+//   - CancellationRegistration 析构时注销回调; 回调可能在注销前已开始执行,
+//     因此回调只能访问按值捕获的共享状态, 或在确认自身 "胜出" 后再访问外部对象
+//   - 默认构造的 CancellationToken 永远不会被取消
+// ============================================================================
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+
+namespace Detail
+{
+    struct CancellationState
+    {
+        std::mutex                                              Mutex;
+        std::atomic<bool>                                       Cancelled{false};
+        std::vector<std::pair<uint64_t, std::function<void()>>> Callbacks;
+        uint64_t                                                NextId = 1;
+    };
+}
+
+
+// ============================================================================
+//  CancellationRegistration — 回调注册句柄 (RAII)
+// ============================================================================
+class CancellationRegistration
+{
+    std::weak_ptr<Detail::CancellationState> State;
+    uint64_t                                 Id = 0;
+
+public:
+    CancellationRegistration() = default;
+    CancellationRegistration(std::weak_ptr<Detail::CancellationState> state, uint64_t id)
+        : State(std::move(state)), Id(id) {}
+
+    ~CancellationRegistration() { Reset(); }
+
+    CancellationRegistration(CancellationRegistration&& other) noexcept
+        : State(std::move(other.State)), Id(std::exchange(other.Id, 0)) {}
+
+    CancellationRegistration& operator=(CancellationRegistration&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            State = std::move(other.State);
+            Id    = std::exchange(other.Id, 0);
+        }
+        return *this;
+    }
+
+    CancellationRegistration(const CancellationRegistration&)            = delete;
+    CancellationRegistration& operator=(const CancellationRegistration&) = delete;
+
+    /// 注销回调 (若尚未被调用)
+    void Reset()
+    {
+        if (Id == 0)
+            return;
+        if (auto state = State.lock())
+        {
+            std::lock_guard lock(state->Mutex);
+            std::erase_if(state->Callbacks, [this](const auto& entry) { return entry.first == Id; });
+        }
+        Id = 0;
+        State.reset();
+    }
+
+    /// 是否持有有效注册
+    [[nodiscard]] bool IsActive() const noexcept { return Id != 0; }
+};
+
+
+// ============================================================================
+//  CancellationToken — 只读的取消视图
+// ============================================================================
+class CancellationToken
+{
+    std::shared_ptr<Detail::CancellationState> State;
+
+    friend class CancellationSource;
+    explicit CancellationToken(std::shared_ptr<Detail::CancellationState> state) : State(std::move(state)) {}
+
+public:
+    CancellationToken() = default;
+
+    /// 是否可能被取消 (默认构造的令牌返回 false)
+    [[nodiscard]] bool CanBeCancelled() const noexcept { return State != nullptr; }
+
+    [[nodiscard]] bool IsCancellationRequested() const noexcept
+    {
+        return State && State->Cancelled.load(std::memory_order_acquire);
+    }
+
+    // ----------------------------------------------------------------
+    // Register — 注册取消回调
+    //
+    // 返回: 注册句柄; 令牌已取消 (或不可取消) 时返回空句柄且不调用回调,
+    //       调用方应通过 IsActive() / IsCancellationRequested() 判断.
+    // ----------------------------------------------------------------
+    [[nodiscard]] CancellationRegistration Register(std::function<void()> callback) const
+    {
+        if (!State)
+            return {};
+        std::lock_guard lock(State->Mutex);
+        if (State->Cancelled.load(std::memory_order_relaxed))
+            return {};
+        uint64_t id = State->NextId++;
+        State->Callbacks.emplace_back(id, std::move(callback));
+        return CancellationRegistration(State, id);
+    }
+};
+
+
+// ============================================================================
+//  CancellationSource — 取消请求的发出方
+// ============================================================================
+class CancellationSource
+{
+    std::shared_ptr<Detail::CancellationState> State = std::make_shared<Detail::CancellationState>();
+
+public:
+    [[nodiscard]] CancellationToken GetToken() const { return CancellationToken(State); }
+
+    [[nodiscard]] bool IsCancellationRequested() const noexcept
+    {
+        return State->Cancelled.load(std::memory_order_acquire);
+    }
+
+    // ----------------------------------------------------------------
+    // Cancel — 发出取消请求, 调用所有已注册的回调
+    //
+    // 返回: true = 本次调用触发了取消; false = 之前已取消
+    // ----------------------------------------------------------------
+    bool Cancel()
+    {
+        std::vector<std::pair<uint64_t, std::function<void()>>> callbacks;
+        {
+            std::lock_guard lock(State->Mutex);
+            if (State->Cancelled.exchange(true, std::memory_order_acq_rel))
+                return false;
+            callbacks.swap(State->Callbacks);
+        }
+        for (auto& [id, callback] : callbacks)
+            callback();
+        return true;
+    }
+};
+
+} // namespace Core
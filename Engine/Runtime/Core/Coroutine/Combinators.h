@@ -0,0 +1,557 @@
+#pragma once
+// ============================================================================
+// Combinators.h — WhenAll / WhenAny 协程组合器
+// ============================================================================
+//
+// 同时等待多个可等待对象 (Task<T>、EventAwaiter<S> 或任意 awaitable):
+//
+//   // 等待全部完成, 结果按参数顺序返回
+//   auto [mesh, texture] = co_await Core::WhenAll(LoadMesh(path), LoadTexture(path));
+//
+//   // 等待一组同类任务
+//   std::vector<Task<Mesh>> loads = ...;
+//   std::vector<Mesh> meshes = co_await Core::WhenAll(std::move(loads));
+//
+//   // 等待最先到达的一个, variant::index() 为胜出者的下标
+//   auto first = co_await Core::WhenAny(bus.Await<OnDeath>(), bus.Await<OnTimeout>());
+//   if (first.index() == 0) { ... }
+//
+// ■ 结果类型:
+//   WhenAll(a, b, ...)   → std::tuple<Ra, Rb, ...>
+//   WhenAll(vector<A>)   → std::vector<R>
+//   WhenAny(a, b, ...)   → std::variant<Ra, Rb, ...>
+//   WhenAny(vector<A>)   → std::pair<size_t, R>  (胜出者下标, 结果)
+//   无返回值的 awaitable 对应 std::monostate.
+//
+// ■ 实现:
+//   每个操作数由一个分离的辅助协程 co_await, 完成后向共享状态报告;
+//   最后一个 (WhenAll) 或第一个 (WhenAny) 报告者通过对称转移恢复等待者.
+//
+// ■ WhenAny 的取消:
+//   胜出者确定后, 立即对仍在等待的操作数调用 Cancel() (若该类型提供,
+//   如 EventAwaiter: 断开订阅), 取消成功的辅助协程被直接销毁,
+//   失败者不再占用 Emit 的时间. 不可取消的操作数 (如 Task) 会在后台
+//   继续运行到结束, 其结果被丢弃.
+//
+// ■ 异常:
+//   WhenAll 在全部操作数结束后重新抛出第一个异常;
+//   WhenAny 若胜出者以异常结束, 则重新抛出该异常.
+// ============================================================================
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "FramePool.h"
+
+namespace Core
+{
+
+namespace Detail
+{
+    // ------------------------------------------------------------------------
+    // awaitable 的结果类型推导
+    // ------------------------------------------------------------------------
+    template<typename A>
+    concept HasMemberCoAwait = requires(A&& a) { std::forward<A>(a).operator co_await(); };
+
+    template<typename A>
+    struct AwaiterOf { using Type = A; };
+
+    template<HasMemberCoAwait A>
+    struct AwaiterOf<A> { using Type = decltype(std::declval<A&&>().operator co_await()); };
+
+    template<typename A>
+    using AwaitResultRaw = decltype(std::declval<typename AwaiterOf<A>::Type&>().await_resume());
+
+    /// co_await A 的结果类型; void 映射为 std::monostate
+    template<typename A>
+    using AwaitResult = std::conditional_t<std::is_void_v<AwaitResultRaw<A>>,
+                                           std::monostate,
+                                           std::remove_cvref_t<AwaitResultRaw<A>>>;
+
+    /// 支持取消的 awaitable: Cancel() 返回 true 表示保证不会再恢复等待者
+    template<typename A>
+    concept CancellableAwaitable = requires(A& a) { { a.Cancel() } -> std::convertible_to<bool>; };
+
+    // ------------------------------------------------------------------------
+    // WhenOperandTask — 等待单个操作数的分离协程
+    //
+    // 启动后不被任何对象拥有: 正常结束时自行销毁;
+    // 仅 WhenAny 在取消成功后由胜出者销毁其帧.
+    // ------------------------------------------------------------------------
+    class WhenOperandTask
+    {
+    public:
+        struct promise_type : PooledCoroutineFrame
+        {
+            WhenOperandTask get_return_object() noexcept
+            {
+                return WhenOperandTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_never  final_suspend() const noexcept { return {}; }
+
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> Coro;
+    };
+
+    /// 销毁当前协程并对称转移到 Next; Next 为空时直接运行到结束 (自行销毁)
+    struct ExitTo
+    {
+        std::coroutine_handle<> Next;
+
+        bool await_ready() const noexcept { return !Next; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) const noexcept
+        {
+            auto next = Next;
+            self.destroy();
+            return next;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /// 以引用转发 awaiter 接口: 部分编译器 (GCC 12) 会把 co_await 的 glvalue 操作数
+    /// 复制进协程帧, 这里保证挂起的正是辅助协程参数本身, Cancel() 才能作用到它
+    template<typename A>
+    struct AwaiterRef
+    {
+        A& Inner;
+
+        bool await_ready() { return Inner.await_ready(); }
+
+        template<typename Promise>
+        decltype(auto) await_suspend(std::coroutine_handle<Promise> handle)
+        {
+            return Inner.await_suspend(handle);
+        }
+
+        decltype(auto) await_resume() { return Inner.await_resume(); }
+    };
+
+    template<typename A>
+    decltype(auto) AsAwaitOperand(A& awaitable) noexcept
+    {
+        if constexpr (HasMemberCoAwait<A>)
+            return std::move(awaitable);
+        else
+            return AwaiterRef<A>{awaitable};
+    }
+
+    template<typename StatePtr, typename Index, typename A>
+    WhenOperandTask RunWhenOperand(StatePtr state, Index index, A awaitable)
+    {
+        state->Bind(index, awaitable);
+        try
+        {
+            if constexpr (std::is_void_v<AwaitResultRaw<A>>)
+            {
+                co_await AsAwaitOperand(awaitable);
+                state->Store(index, std::monostate{});
+            }
+            else
+            {
+                state->Store(index, co_await AsAwaitOperand(awaitable));
+            }
+        }
+        catch (...)
+        {
+            state->Fail(index, std::current_exception());
+        }
+        co_await ExitTo{state->Arrive(index)};
+    }
+
+    // ------------------------------------------------------------------------
+    // WhenAllState — 计数归零时恢复等待者
+    //
+    // Remaining 初始为 N + 1: 额外的 1 由等待者在启动全部操作数后释放,
+    // 避免操作数同步完成时在 await_suspend 返回前就恢复等待者.
+    // ------------------------------------------------------------------------
+    template<typename Results>
+    struct WhenAllState
+    {
+        Results                 Values;
+        std::exception_ptr      Exception;
+        std::atomic<bool>       Failed{false};
+        std::atomic<size_t>     Remaining{0};
+        std::coroutine_handle<> Parent;
+
+        template<typename Index, typename A>
+        void Bind(Index, A&) noexcept {}
+
+        template<size_t I, typename R>
+        void Store(std::integral_constant<size_t, I>, R&& value)
+        {
+            std::get<I>(Values).emplace(std::forward<R>(value));
+        }
+
+        template<typename R>
+        void Store(size_t index, R&& value)
+        {
+            Values[index].emplace(std::forward<R>(value));
+        }
+
+        template<typename Index>
+        void Fail(Index, std::exception_ptr exception) noexcept
+        {
+            if (!Failed.exchange(true, std::memory_order_relaxed))
+                Exception = std::move(exception);
+        }
+
+        template<typename Index>
+        std::coroutine_handle<> Arrive(Index) noexcept
+        {
+            return Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 ? Parent : nullptr;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // WhenAnyState — 第一个完成者胜出, 并取消其余操作数
+    // ------------------------------------------------------------------------
+    template<typename Result>
+    struct WhenAnyState
+    {
+        static constexpr size_t NoWinner = static_cast<size_t>(-1);
+
+        struct Operand
+        {
+            std::coroutine_handle<> Frame;
+            void*                   Awaitable = nullptr;
+            bool                  (*Cancel)(void*) = nullptr;
+            bool                    Armed     = false; // 已挂起, 可被取消
+            bool                    Finished  = false;
+        };
+
+        std::mutex              Mutex;
+        std::vector<Operand>    Operands;
+        size_t                  Winner = NoWinner;
+        bool                    Started = false;      // 等待者已启动全部操作数
+        bool                    ParentResumed = false;
+        std::optional<Result>   Value;
+        std::exception_ptr      Exception;
+        std::coroutine_handle<> Parent;
+
+        explicit WhenAnyState(size_t count) : Operands(count) {}
+
+        template<typename Index, typename A>
+        void Bind(Index index, A& awaitable) noexcept
+        {
+            if constexpr (CancellableAwaitable<A>)
+            {
+                Operands[index].Awaitable = &awaitable;
+                Operands[index].Cancel    = [](void* p) { return static_cast<bool>(static_cast<A*>(p)->Cancel()); };
+            }
+        }
+
+        template<size_t I, typename R>
+        void Store(std::integral_constant<size_t, I>, R&& value)
+        {
+            std::lock_guard lock(Mutex);
+            if (Winner != NoWinner)
+                return;
+            Winner = I;
+            Value.emplace(std::in_place_index<I>, std::forward<R>(value));
+        }
+
+        template<typename R>
+        void Store(size_t index, R&& value)
+        {
+            std::lock_guard lock(Mutex);
+            if (Winner != NoWinner)
+                return;
+            Winner = index;
+            Value.emplace(index, std::forward<R>(value));
+        }
+
+        void Fail(size_t index, std::exception_ptr exception)
+        {
+            std::lock_guard lock(Mutex);
+            if (Winner != NoWinner)
+                return;
+            Winner    = index;
+            Exception = std::move(exception);
+        }
+
+        std::coroutine_handle<> Arrive(size_t index)
+        {
+            std::lock_guard lock(Mutex);
+            Operands[index].Finished = true;
+            if (Winner != index || !Started || ParentResumed)
+                return nullptr;
+            ParentResumed = true;
+            CancelLosers();
+            return Parent;
+        }
+
+        [[nodiscard]] bool HasWinner()
+        {
+            std::lock_guard lock(Mutex);
+            return Winner != NoWinner;
+        }
+
+        /// 等待者启动全部操作数后调用: 返回 true 表示需要挂起
+        bool Arm()
+        {
+            std::lock_guard lock(Mutex);
+            Started = true;
+            for (auto& operand : Operands)
+                operand.Armed = operand.Frame && !operand.Finished;
+            if (Winner == NoWinner)
+                return true;
+            ParentResumed = true;
+            CancelLosers();
+            return false;
+        }
+
+    private:
+        /// 调用方需持有 Mutex. 取消成功的操作数保证不会再被恢复, 可直接销毁其帧.
+        void CancelLosers()
+        {
+            for (size_t i = 0; i < Operands.size(); ++i)
+            {
+                auto& operand = Operands[i];
+                if (i == Winner || !operand.Armed || operand.Finished || !operand.Cancel)
+                    continue;
+                if (operand.Cancel(operand.Awaitable))
+                {
+                    operand.Finished = true;
+                    operand.Frame.destroy();
+                }
+            }
+        }
+    };
+}
+
+
+// ============================================================================
+//  WhenAll
+// ============================================================================
+
+template<typename... Awaitables>
+class WhenAllAwaitable
+{
+    using ResultType = std::tuple<Detail::AwaitResult<Awaitables>...>;
+    using State      = Detail::WhenAllState<std::tuple<std::optional<Detail::AwaitResult<Awaitables>>...>>;
+
+    std::tuple<Awaitables...> Operands;
+    std::unique_ptr<State>    Shared;
+
+public:
+    explicit WhenAllAwaitable(std::tuple<Awaitables...> operands) : Operands(std::move(operands)) {}
+
+    bool await_ready() const noexcept { return sizeof...(Awaitables) == 0; }
+
+    bool await_suspend(std::coroutine_handle<> parent)
+    {
+        Shared         = std::make_unique<State>();
+        Shared->Parent = parent;
+        Shared->Remaining.store(sizeof...(Awaitables) + 1, std::memory_order_relaxed);
+
+        [this]<size_t... I>(std::index_sequence<I...>)
+        {
+            (Detail::RunWhenOperand(Shared.get(), std::integral_constant<size_t, I>{},
+                                    std::move(std::get<I>(Operands))).Coro.resume(), ...);
+        }(std::index_sequence_for<Awaitables...>{});
+
+        return Shared->Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    ResultType await_resume()
+    {
+        if constexpr (sizeof...(Awaitables) == 0)
+            return {};
+        else
+        {
+            if (Shared->Exception)
+                std::rethrow_exception(Shared->Exception);
+            return std::apply([](auto&... values) { return ResultType(std::move(*values)...); },
+                              Shared->Values);
+        }
+    }
+};
+
+template<typename Awaitable>
+class WhenAllRangeAwaitable
+{
+    using ValueType = Detail::AwaitResult<Awaitable>;
+    using State     = Detail::WhenAllState<std::vector<std::optional<ValueType>>>;
+
+    std::vector<Awaitable> Operands;
+    std::unique_ptr<State> Shared;
+
+public:
+    explicit WhenAllRangeAwaitable(std::vector<Awaitable> operands) : Operands(std::move(operands)) {}
+
+    bool await_ready() const noexcept { return Operands.empty(); }
+
+    bool await_suspend(std::coroutine_handle<> parent)
+    {
+        Shared         = std::make_unique<State>();
+        Shared->Parent = parent;
+        Shared->Values.resize(Operands.size());
+        Shared->Remaining.store(Operands.size() + 1, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < Operands.size(); ++i)
+            Detail::RunWhenOperand(Shared.get(), i, std::move(Operands[i])).Coro.resume();
+
+        return Shared->Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    std::vector<ValueType> await_resume()
+    {
+        std::vector<ValueType> results;
+        if (!Shared)
+            return results;
+        if (Shared->Exception)
+            std::rethrow_exception(Shared->Exception);
+        results.reserve(Shared->Values.size());
+        for (auto& value : Shared->Values)
+            results.push_back(std::move(*value));
+        return results;
+    }
+};
+
+/// 等待全部操作数完成, 返回 std::tuple (按参数顺序)
+template<typename... Awaitables>
+[[nodiscard]] auto WhenAll(Awaitables&&... awaitables)
+{
+    return WhenAllAwaitable<std::decay_t<Awaitables>...>(
+        std::tuple<std::decay_t<Awaitables>...>(std::forward<Awaitables>(awaitables)...));
+}
+
+/// 等待一组同类操作数完成, 返回 std::vector (按输入顺序)
+template<typename Awaitable>
+[[nodiscard]] auto WhenAll(std::vector<Awaitable> awaitables)
+{
+    return WhenAllRangeAwaitable<Awaitable>(std::move(awaitables));
+}
+
+
+// ============================================================================
+//  WhenAny
+// ============================================================================
+
+template<typename... Awaitables>
+class WhenAnyAwaitable
+{
+    static_assert(sizeof...(Awaitables) > 0, "WhenAny — 至少需要一个操作数");
+
+    using ResultType = std::variant<Detail::AwaitResult<Awaitables>...>;
+    using State      = Detail::WhenAnyState<ResultType>;
+
+    std::tuple<Awaitables...> Operands;
+    std::shared_ptr<State>    Shared;
+
+    template<size_t I>
+    bool Launch()
+    {
+        if (Shared->HasWinner())
+            return false;
+        auto coro = Detail::RunWhenOperand(Shared, std::integral_constant<size_t, I>{},
+                                           std::move(std::get<I>(Operands))).Coro;
+        Shared->Operands[I].Frame = coro;
+        coro.resume();
+        return true;
+    }
+
+public:
+    explicit WhenAnyAwaitable(std::tuple<Awaitables...> operands) : Operands(std::move(operands)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> parent)
+    {
+        Shared         = std::make_shared<State>(sizeof...(Awaitables));
+        Shared->Parent = parent;
+
+        // 已有胜出者时不再启动剩余操作数
+        [this]<size_t... I>(std::index_sequence<I...>)
+        {
+            (Launch<I>() && ...);
+        }(std::index_sequence_for<Awaitables...>{});
+
+        return Shared->Arm();
+    }
+
+    ResultType await_resume()
+    {
+        if (Shared->Exception)
+            std::rethrow_exception(Shared->Exception);
+        return std::move(*Shared->Value);
+    }
+};
+
+template<typename Awaitable>
+class WhenAnyRangeAwaitable
+{
+    using ValueType  = Detail::AwaitResult<Awaitable>;
+    using ResultType = std::pair<size_t, ValueType>;
+    using State      = Detail::WhenAnyState<ResultType>;
+
+    std::vector<Awaitable> Operands;
+    std::shared_ptr<State> Shared;
+
+public:
+    explicit WhenAnyRangeAwaitable(std::vector<Awaitable> operands) : Operands(std::move(operands))
+    {
+        assert(!Operands.empty() && "WhenAny — 至少需要一个操作数");
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> parent)
+    {
+        Shared         = std::make_shared<State>(Operands.size());
+        Shared->Parent = parent;
+
+        for (size_t i = 0; i < Operands.size() && !Shared->HasWinner(); ++i)
+        {
+            auto coro = Detail::RunWhenOperand(Shared, i, std::move(Operands[i])).Coro;
+            Shared->Operands[i].Frame = coro;
+            coro.resume();
+        }
+
+        return Shared->Arm();
+    }
+
+    ResultType await_resume()
+    {
+        if (Shared->Exception)
+            std::rethrow_exception(Shared->Exception);
+        return std::move(*Shared->Value);
+    }
+};
+
+/// 等待最先完成的操作数, 返回 std::variant (index() 为胜出者下标); 其余操作数被取消
+template<typename... Awaitables>
+[[nodiscard]] auto WhenAny(Awaitables&&... awaitables)
+{
+    return WhenAnyAwaitable<std::decay_t<Awaitables>...>(
+        std::tuple<std::decay_t<Awaitables>...>(std::forward<Awaitables>(awaitables)...));
+}
+
+/// 等待一组同类操作数中最先完成的一个, 返回 (下标, 结果); 其余操作数被取消
+template<typename Awaitable>
+[[nodiscard]] auto WhenAny(std::vector<Awaitable> awaitables)
+{
+    return WhenAnyRangeAwaitable<Awaitable>(std::move(awaitables));
+}
+
+} // namespace Core
@@ -0,0 +1,287 @@
+#pragma once
+// ============================================================================
+// FramePool.h — 协程帧池化分配器
+// ============================================================================
+//
+// 每个协程调用都会通过 operator new 分配一个协程帧. 事件驱动的玩法代码
+// 每关会创建数万个短命协程, 全局堆分配在 profile 中非常明显.
+// FramePool 按大小分桶, 每个线程持有各桶的空闲链表缓存:
+// 热路径上分配 / 释放只是一次链表 pop / push, 不加锁.
+//
+// ■ 使用方式:
+//   协程的 promise_type 继承 PooledCoroutineFrame 即可:
+//
+//   struct promise_type : Core::PooledCoroutineFrame { ... };
+//
+//   EventTask、Task<T>、WhenAll / WhenAny 的辅助协程均已接入.
+//
+// ■ 分桶:
+//   帧大小向上取整到 64 字节, 共 BucketCount 个桶 (最大 MaxPooledSize).
+//   超过上限的帧直接走全局 operator new, 并计入 Oversized 统计.
+//
+// ■ 线程缓存:
+//   - 分配: 本线程缓存非空则 pop, 否则从全局链表取一批 (或切分新的 Chunk);
+//           每批最多 MaxCachedPerBucket / 2 块, 新 Chunk 的其余块放入全局链表
+//   - 释放: push 到释放线程的缓存 (可能不是分配线程), 缓存超过上限时
+//           将一半归还全局链表
+//   - 线程退出时缓存全部归还全局
+//   Chunk 一经分配不再归还系统, 内存峰值即为协程帧数量峰值.
+//
+// ■ 统计:
+//   FramePool::GetStats() 返回各桶的累计分配次数与当前存活帧数,
+//   可据此调整 BucketGranularity / MaxPooledSize.
+// ============================================================================
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Core
+{
+
+class FramePool
+{
+public:
+    static constexpr size_t BucketGranularity = 64;
+    static constexpr size_t BucketCount       = 32;
+    static constexpr size_t MaxPooledSize     = BucketGranularity * BucketCount; // 2 KB
+    static constexpr size_t ChunkSize         = 64 * 1024;
+    static constexpr size_t MaxCachedPerBucket = 256;
+
+    struct BucketStats
+    {
+        size_t   FrameSize   = 0; // 该桶的块大小
+        uint64_t Allocations = 0; // 累计分配次数
+        int64_t  Live        = 0; // 当前存活帧数
+    };
+
+    struct Stats
+    {
+        std::array<BucketStats, BucketCount> Buckets{};
+        uint64_t OversizedAllocations = 0; // 超过 MaxPooledSize 的分配次数
+        size_t   LargestFrameSize     = 0; // 见过的最大帧
+        size_t   ReservedBytes        = 0; // 已向系统申请的 Chunk 总字节数
+    };
+
+    // ----------------------------------------------------------------
+    // Allocate / Deallocate — 分配与释放协程帧
+    //
+    // Deallocate 必须传入与 Allocate 相同的 size (promise_type 的
+    // sized operator delete 会收到编译器提供的帧大小).
+    // ----------------------------------------------------------------
+    [[nodiscard]] static void* Allocate(size_t size)
+    {
+        RecordSize(size);
+        if (size > MaxPooledSize)
+        {
+            Global().Oversized.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        size_t bucket = BucketIndex(size);
+        Global().Counters[bucket].Allocations.fetch_add(1, std::memory_order_relaxed);
+        Global().Counters[bucket].Live.fetch_add(1, std::memory_order_relaxed);
+
+        auto& cache = Cache().Lists[bucket];
+        if (!cache.Head)
+            Refill(bucket, cache);
+
+        FreeBlock* block = cache.Head;
+        cache.Head = block->Next;
+        --cache.Count;
+        return block;
+    }
+
+    static void Deallocate(void* ptr, size_t size) noexcept
+    {
+        if (!ptr)
+            return;
+        if (size > MaxPooledSize)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        size_t bucket = BucketIndex(size);
+        Global().Counters[bucket].Live.fetch_sub(1, std::memory_order_relaxed);
+
+        auto& cache = Cache().Lists[bucket];
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->Next = cache.Head;
+        cache.Head  = block;
+        if (++cache.Count > MaxCachedPerBucket)
+            Release(bucket, cache, MaxCachedPerBucket / 2);
+    }
+
+    /// 本线程缓存中 size 所在桶的空闲块数 (超过 MaxPooledSize 时为 0)
+    [[nodiscard]] static size_t ThreadCachedCount(size_t size) noexcept
+    {
+        return size > MaxPooledSize ? 0 : Cache().Lists[BucketIndex(size)].Count;
+    }
+
+    /// 帧大小分布及容量统计 (近似值, 各计数器独立读取)
+    [[nodiscard]] static Stats GetStats() noexcept
+    {
+        Stats stats;
+        auto& global = Global();
+        for (size_t i = 0; i < BucketCount; ++i)
+        {
+            stats.Buckets[i].FrameSize   = (i + 1) * BucketGranularity;
+            stats.Buckets[i].Allocations = global.Counters[i].Allocations.load(std::memory_order_relaxed);
+            stats.Buckets[i].Live        = global.Counters[i].Live.load(std::memory_order_relaxed);
+        }
+        stats.OversizedAllocations = global.Oversized.load(std::memory_order_relaxed);
+        stats.LargestFrameSize     = global.LargestFrame.load(std::memory_order_relaxed);
+        stats.ReservedBytes        = global.Reserved.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    struct FreeList
+    {
+        FreeBlock* Head  = nullptr;
+        size_t     Count = 0;
+    };
+
+    struct BucketCounters
+    {
+        std::atomic<uint64_t> Allocations{0};
+        std::atomic<int64_t>  Live{0};
+    };
+
+    struct GlobalState
+    {
+        std::mutex                               Mutex;
+        std::array<FreeList, BucketCount>        Lists{};
+        std::vector<void*>                       Chunks;
+        std::array<BucketCounters, BucketCount>  Counters{};
+        std::atomic<uint64_t>                    Oversized{0};
+        std::atomic<size_t>                      LargestFrame{0};
+        std::atomic<size_t>                      Reserved{0};
+    };
+
+    struct ThreadCache
+    {
+        std::array<FreeList, BucketCount> Lists{};
+
+        ~ThreadCache()
+        {
+            for (size_t i = 0; i < BucketCount; ++i)
+                Release(i, Lists[i], Lists[i].Count);
+        }
+    };
+
+    static constexpr size_t BucketIndex(size_t size) noexcept
+    {
+        return size == 0 ? 0 : (size - 1) / BucketGranularity;
+    }
+
+    /// 全局状态永不析构: 线程缓存可能在静态对象析构之后才归还
+    static GlobalState& Global() noexcept
+    {
+        static GlobalState* state = new GlobalState();
+        return *state;
+    }
+
+    static ThreadCache& Cache() noexcept
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static void RecordSize(size_t size) noexcept
+    {
+        auto& largest = Global().LargestFrame;
+        size_t current = largest.load(std::memory_order_relaxed);
+        while (current < size &&
+               !largest.compare_exchange_weak(current, size, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// 从全局链表取最多 MaxCachedPerBucket / 2 块; 全局为空时先切分一个新 Chunk 放入全局链表
+    /// (小桶的一个 Chunk 有上千块, 整块放进线程缓存会绕过 MaxCachedPerBucket)
+    static void Refill(size_t bucket, FreeList& cache)
+    {
+        auto& global = Global();
+        std::lock_guard lock(global.Mutex);
+
+        auto& shared = global.Lists[bucket];
+        if (!shared.Head)
+        {
+            size_t blockSize = (bucket + 1) * BucketGranularity;
+            auto*  chunk     = static_cast<std::byte*>(
+                ::operator new(ChunkSize, std::align_val_t{BucketGranularity}));
+            global.Chunks.push_back(chunk);
+            global.Reserved.fetch_add(ChunkSize, std::memory_order_relaxed);
+
+            for (size_t offset = 0; offset + blockSize <= ChunkSize; offset += blockSize)
+            {
+                auto* block = reinterpret_cast<FreeBlock*>(chunk + offset);
+                block->Next = shared.Head;
+                shared.Head = block;
+                ++shared.Count;
+            }
+        }
+
+        size_t take = MaxCachedPerBucket / 2;
+        while (shared.Head && take-- > 0)
+        {
+            FreeBlock* block = shared.Head;
+            shared.Head = block->Next;
+            --shared.Count;
+            block->Next = cache.Head;
+            cache.Head  = block;
+            ++cache.Count;
+        }
+    }
+
+    /// 将本线程缓存的 count 块归还全局链表
+    static void Release(size_t bucket, FreeList& cache, size_t count) noexcept
+    {
+        if (count == 0)
+            return;
+
+        FreeBlock* first = cache.Head;
+        FreeBlock* last  = first;
+        for (size_t i = 1; i < count; ++i)
+            last = last->Next;
+        cache.Head   = last->Next;
+        cache.Count -= count;
+
+        auto& global = Global();
+        std::lock_guard lock(global.Mutex);
+        auto& shared = global.Lists[bucket];
+        last->Next   = shared.Head;
+        shared.Head  = first;
+        shared.Count += count;
+    }
+};
+
+
+// ============================================================================
+//  PooledCoroutineFrame — promise_type 的基类, 让协程帧从 FramePool 分配
+// ============================================================================
+struct PooledCoroutineFrame
+{
+    static void* operator new(size_t size)
+    {
+        return FramePool::Allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept
+    {
+        FramePool::Deallocate(ptr, size);
+    }
+};
+
+} // namespace Core
@@ -0,0 +1,341 @@
+#pragma once
+// ============================================================================
+// Task.h — 惰性启动的协程任务 Task<T>
+// ============================================================================
+//
+// EventTask (Core/Bus/Coroutine.h) 是 fire-and-forget 的: 立即启动, 无返回值,
+// 也不能被其它协程等待. Task<T> 用于组合异步逻辑:
+//
+//   Task<Mesh> LoadMesh(std::string path)
+//   {
+//       co_await GThreadPool().Schedule();   // 切换到线程池
+//       auto bytes = ReadFile(path);
+//       co_return ParseMesh(bytes);
+//   }
+//
+//   Task<Model> LoadModel(std::string path)
+//   {
+//       Mesh mesh = co_await LoadMesh(path); // 等待子任务, 不创建 future
+//       co_return Model{std::move(mesh)};
+//   }
+//
+//   Model model = Core::SyncWait(LoadModel("hero.mesh")); // 阻塞等待 (测试 / 工具代码)
+//
+// ■ 语义:
+//   - 惰性启动: 创建 Task 时协程不执行, 被 co_await (或 SyncWait) 时才开始
+//   - 对称转移 (symmetric transfer): co_await 子任务与子任务结束返回父协程
+//     都通过 await_suspend 返回 coroutine_handle 完成, 不会因 await 链的深度
+//     而增长调用栈 (依赖编译器把 resume 生成为尾调用; GCC 在 -O0 下不保证)
+//   - 异常: 协程内未捕获的异常被保存, 在 co_await / SyncWait 处重新抛出
+//   - Task 是 move-only 的, 析构时销毁协程帧; 一个 Task 只能被 co_await 一次
+//   - 协程帧从 FramePool 分配 (见 FramePool.h)
+//
+// ■ 线程模型:
+//   Task 在哪个线程恢复, 就在哪个线程继续执行; 子任务结束后, 父协程在
+//   子任务结束的线程上继续. 需要切换线程时 co_await pool.Schedule().
+// ============================================================================
+
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "FramePool.h"
+
+namespace Core
+{
+
+template<typename T = void>
+class Task;
+
+namespace Detail
+{
+    // ------------------------------------------------------------------------
+    // TaskPromiseBase — 保存等待者 (continuation), 结束时对称转移回去
+    // ------------------------------------------------------------------------
+    class TaskPromiseBase : public PooledCoroutineFrame
+    {
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                auto continuation = handle.promise().Continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+    public:
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter        final_suspend() const noexcept { return {}; }
+
+        void unhandled_exception() noexcept { Exception = std::current_exception(); }
+
+        void SetContinuation(std::coroutine_handle<> continuation) noexcept
+        {
+            Continuation = continuation;
+        }
+
+    protected:
+        void RethrowIfFailed() const
+        {
+            if (Exception)
+                std::rethrow_exception(Exception);
+        }
+
+    private:
+        std::coroutine_handle<> Continuation;
+        std::exception_ptr      Exception;
+    };
+
+    template<typename T>
+    class TaskPromise final : public TaskPromiseBase
+    {
+        std::optional<T> Value;
+
+    public:
+        Task<T> get_return_object() noexcept;
+
+        template<typename U = T>
+            requires std::convertible_to<U&&, T>
+        void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+        {
+            Value.emplace(std::forward<U>(value));
+        }
+
+        T TakeResult()
+        {
+            RethrowIfFailed();
+            assert(Value.has_value() && "Task — 协程未返回值");
+            return std::move(*Value);
+        }
+    };
+
+    template<>
+    class TaskPromise<void> final : public TaskPromiseBase
+    {
+    public:
+        Task<void> get_return_object() noexcept;
+
+        void return_void() noexcept {}
+
+        void TakeResult() const { RethrowIfFailed(); }
+    };
+}
+
+
+// ============================================================================
+//  Task<T> — 可 co_await 的惰性协程任务
+// ============================================================================
+template<typename T>
+class [[nodiscard]] Task
+{
+    static_assert(!std::is_reference_v<T>, "Task<T> 不支持引用类型, 请返回指针或 std::reference_wrapper");
+
+public:
+    using promise_type = Detail::TaskPromise<T>;
+    using Handle       = std::coroutine_handle<promise_type>;
+    using ValueType    = T;
+
+    Task() noexcept = default;
+    explicit Task(Handle handle) noexcept : Coro(handle) {}
+
+    Task(Task&& other) noexcept : Coro(std::exchange(other.Coro, nullptr)) {}
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (Coro)
+                Coro.destroy();
+            Coro = std::exchange(other.Coro, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        if (Coro)
+            Coro.destroy();
+    }
+
+    /// 是否持有协程
+    [[nodiscard]] bool IsValid() const noexcept { return Coro != nullptr; }
+
+    /// 协程是否已执行完毕
+    [[nodiscard]] bool IsDone() const noexcept { return !Coro || Coro.done(); }
+
+    // ----------------------------------------------------------------
+    // co_await task — 启动子任务, 结束后在子任务的线程上恢复等待者
+    // ----------------------------------------------------------------
+    struct Awaiter
+    {
+        Handle Coro;
+
+        bool await_ready() const noexcept { return !Coro || Coro.done(); }
+
+        /// 记录等待者, 然后对称转移到子任务
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            Coro.promise().SetContinuation(awaiting);
+            return Coro;
+        }
+
+        T await_resume()
+        {
+            assert(Coro && "Task — co_await 了空任务");
+            return Coro.promise().TakeResult();
+        }
+    };
+
+    Awaiter operator co_await() && noexcept { return Awaiter{Coro}; }
+    Awaiter operator co_await() & noexcept { return Awaiter{Coro}; }
+
+private:
+    Handle Coro = nullptr;
+};
+
+namespace Detail
+{
+    template<typename T>
+    Task<T> TaskPromise<T>::get_return_object() noexcept
+    {
+        return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+    }
+
+    inline Task<void> TaskPromise<void>::get_return_object() noexcept
+    {
+        return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+    }
+
+    // ------------------------------------------------------------------------
+    // SyncWait 的实现: 一个包装协程, 结束时唤醒阻塞的线程
+    // ------------------------------------------------------------------------
+    class SyncWaitEvent
+    {
+        std::mutex              Mutex;
+        std::condition_variable Condition;
+        bool                    IsSet = false;
+
+    public:
+        void Set()
+        {
+            // 持锁通知: Wait 返回后事件对象即被销毁
+            std::lock_guard lock(Mutex);
+            IsSet = true;
+            Condition.notify_all();
+        }
+
+        void Wait()
+        {
+            std::unique_lock lock(Mutex);
+            Condition.wait(lock, [this]() { return IsSet; });
+        }
+    };
+
+    class SyncWaitTask
+    {
+    public:
+        struct promise_type : PooledCoroutineFrame
+        {
+            SyncWaitEvent*     Event = nullptr;
+            std::exception_ptr Exception;
+
+            SyncWaitTask get_return_object() noexcept
+            {
+                return SyncWaitTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            auto final_suspend() const noexcept
+            {
+                struct Notifier
+                {
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+                    {
+                        handle.promise().Event->Set();
+                    }
+                    void await_resume() const noexcept {}
+                };
+                return Notifier{};
+            }
+
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { Exception = std::current_exception(); }
+        };
+
+        explicit SyncWaitTask(std::coroutine_handle<promise_type> handle) noexcept : Coro(handle) {}
+        SyncWaitTask(SyncWaitTask&& other) noexcept : Coro(std::exchange(other.Coro, nullptr)) {}
+        SyncWaitTask(const SyncWaitTask&)            = delete;
+        SyncWaitTask& operator=(const SyncWaitTask&) = delete;
+        SyncWaitTask& operator=(SyncWaitTask&&)      = delete;
+
+        ~SyncWaitTask()
+        {
+            if (Coro)
+                Coro.destroy();
+        }
+
+        /// 启动并阻塞直到包装协程结束
+        void Run()
+        {
+            SyncWaitEvent event;
+            Coro.promise().Event = &event;
+            Coro.resume();
+            event.Wait();
+            if (Coro.promise().Exception)
+                std::rethrow_exception(Coro.promise().Exception);
+        }
+
+    private:
+        std::coroutine_handle<promise_type> Coro;
+    };
+
+    template<typename T>
+    SyncWaitTask MakeSyncWaitTask(Task<T>& task, std::optional<T>& result)
+    {
+        result.emplace(co_await task);
+    }
+
+    inline SyncWaitTask MakeSyncWaitTask(Task<void>& task)
+    {
+        co_await task;
+    }
+}
+
+
+// ----------------------------------------------------------------
+// SyncWait — 在当前线程阻塞等待任务完成, 返回结果 (或重新抛出异常)
+//
+// 任务可以在任意线程上完成 (例如中途 co_await pool.Schedule()).
+// 不要在任务最终需要恢复的线程上调用 (例如主线程队列), 否则会死锁.
+// ----------------------------------------------------------------
+template<typename T>
+T SyncWait(Task<T> task)
+{
+    if constexpr (std::is_void_v<T>)
+    {
+        Detail::MakeSyncWaitTask(task).Run();
+    }
+    else
+    {
+        std::optional<T> result;
+        Detail::MakeSyncWaitTask(task, result).Run();
+        return std::move(*result);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,591 @@
+#pragma once
+// ============================================================================
+// TimerWheel.h — 分层时间轮与 Delay / NextFrame / Until 等待体
+// ============================================================================
+//
+// 协程中等待时间或帧:
+//
+//   EventTask Blink(Sprite& sprite)
+//   {
+//       for (;;)
+//       {
+//           sprite.Visible = !sprite.Visible;
+//           co_await Core::Delay(std::chrono::milliseconds(500));
+//       }
+//   }
+//
+//   co_await Core::NextFrame();                          // 下一帧继续
+//   co_await Core::Until([&] { return door.IsOpen(); }); // 每帧检查, 成立时继续
+//
+// 帧循环每帧推进一次时间轮:
+//
+//   Core::Bus::FrameClock::Tick();
+//   Core::TimerWheel::GetDefault().Tick(Core::Bus::FrameClock::Now());
+//
+// ■ 时间轮结构 (精度 Resolution = 1ms):
+//   Level 0: 256 个槽, 每槽 1 tick          → 覆盖 256ms
+//   Level 1:  64 个槽, 每槽 256 tick        → 覆盖约 16s
+//   Level 2:  64 个槽, 每槽 16384 tick      → 覆盖约 17min
+//   Level 3:  64 个槽, 每槽 1048576 tick    → 覆盖约 18.6h (更远的定时器到期后重新插入)
+//   插入: 由剩余 tick 数直接算出层级与槽位, O(1)
+//   推进: 每 tick 只处理 Level 0 的一个槽; Level 0 转满一圈时把上一层的
+//         一个槽重新分配到下层 (cascade). 只有到期的等待者会被恢复.
+//
+// ■ 等待节点:
+//   节点是侵入式双向链表, 嵌在 awaiter 中 (即协程帧内), 插入 / 移除不分配内存.
+//   等待中的协程被销毁时, awaiter 析构自动把节点摘下.
+//   DelayAwaiter 提供 Cancel(), 可与 WhenAny 组合实现超时:
+//     auto r = co_await WhenAny(bus.Await<OnReply>(), Delay(std::chrono::seconds(5)));
+//   只等待单个事件时, bus.Await<OnReply>().WithTimeout(d) 更轻量 (见 Bus/Coroutine.h).
+//
+// ■ 线程模型:
+//   Tick 只应由帧循环所在线程调用, 被唤醒的协程也在该线程恢复.
+//   co_await Delay / NextFrame / Until 可以在任意线程发起 (内部加锁).
+//   Until 的谓词在帧线程上求值.
+//   Tick 先在锁内摘下节点, 再在锁外恢复 (或求值谓词). 其它线程在此期间调用
+//   Cancel 会等到这次恢复结束才返回 false; 返回 true 则保证协程不会再被恢复.
+//   因此在别的线程销毁等待中的协程前应先 Cancel, 只有返回 true 时才可销毁.
+//   帧线程上 (包括被恢复的协程内部) 的 Cancel / 析构不等待.
+// ============================================================================
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace Core
+{
+
+class TimerWheel;
+
+namespace Detail
+{
+    /// 侵入式链表节点 (循环链表, 槽位本身是哨兵节点)
+    struct WheelNode
+    {
+        WheelNode*              Prev = this;
+        WheelNode*              Next = this;
+        uint64_t                ExpireTick = 0;
+        std::coroutine_handle<> Handle;
+
+        // 非空时到期调用它而不是恢复 Handle (定时器与其它来源竞争时使用).
+        // 到期时在锁内复制, 在锁外调用: 回调按值持有的状态在调用期间保持有效.
+        std::function<void()>   Callback;
+
+        WheelNode() = default;
+        WheelNode(const WheelNode&)            = delete;
+        WheelNode& operator=(const WheelNode&) = delete;
+
+        [[nodiscard]] bool IsLinked() const noexcept { return Next != this; }
+        [[nodiscard]] bool IsEmpty() const noexcept { return Next == this; }
+
+        void PushBack(WheelNode& node) noexcept
+        {
+            node.Prev       = Prev;
+            node.Next       = this;
+            Prev->Next      = &node;
+            Prev            = &node;
+        }
+
+        void Unlink() noexcept
+        {
+            Prev->Next = Next;
+            Next->Prev = Prev;
+            Prev = Next = this;
+        }
+
+        WheelNode* PopFront() noexcept
+        {
+            if (IsEmpty())
+                return nullptr;
+            WheelNode* node = Next;
+            node->Unlink();
+            return node;
+        }
+
+        /// 把 other 的全部节点移到本链表末尾
+        void SpliceBack(WheelNode& other) noexcept
+        {
+            if (other.IsEmpty())
+                return;
+            WheelNode* first = other.Next;
+            WheelNode* last  = other.Prev;
+            other.Prev = other.Next = &other;
+
+            first->Prev = Prev;
+            last->Next  = this;
+            Prev->Next  = first;
+            Prev        = last;
+        }
+    };
+
+    /// Until 等待节点: 额外携带谓词
+    struct PredicateNode : WheelNode
+    {
+        std::function<bool()> Predicate;
+    };
+}
+
+
+// ============================================================================
+//  TimerWheel
+// ============================================================================
+class TimerWheel
+{
+public:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration  = Clock::duration;
+
+    static constexpr std::chrono::milliseconds Resolution{1};
+
+    explicit TimerWheel(TimePoint start = Clock::now()) : Origin(start), CurrentTime(start) {}
+
+    TimerWheel(const TimerWheel&)            = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /// 全局默认时间轮 (由主帧循环驱动)
+    static TimerWheel& GetDefault()
+    {
+        static TimerWheel instance;
+        return instance;
+    }
+
+    // ----------------------------------------------------------------
+    // Tick — 推进到 now, 恢复所有到期的等待者 (帧循环每帧调用一次)
+    //
+    // 顺序: 到期定时器 → NextFrame 等待者 → Until 谓词成立者.
+    // 本次 Tick 中新加入的 NextFrame / Until 等待留到下一次 Tick.
+    // 早于上一次的 now 会被忽略 (时间不回退).
+    //
+    // 返回: 本次恢复的协程数量
+    // ----------------------------------------------------------------
+    size_t Tick(TimePoint now)
+    {
+        size_t resumed = 0;
+
+        uint64_t target = ToTick(now);
+        {
+            std::lock_guard lock(Mutex);
+            if (now > CurrentTime)
+                CurrentTime = now;
+            // 没有定时器时直接跳到目标 tick
+            if (TimerCount == 0 && target >= NextTick)
+                NextTick = target + 1;
+        }
+
+        for (;;)
+        {
+            {
+                std::lock_guard lock(Mutex);
+                if (NextTick > target)
+                    break;
+                Cascade();
+            }
+            resumed += ExpireSlot(Level0[NextTick & Level0Mask]);
+
+            std::lock_guard lock(Mutex);
+            ++NextTick;
+            if (TimerCount == 0 && target >= NextTick)
+                NextTick = target + 1;
+        }
+
+        resumed += ResumeFrameWaiters();
+        resumed += EvaluatePredicates();
+        return resumed;
+    }
+
+    /// 最近一次 Tick 的时间 (Delay 以此为起点)
+    [[nodiscard]] TimePoint Now() const
+    {
+        std::lock_guard lock(Mutex);
+        return CurrentTime;
+    }
+
+    /// 等待中的定时器数量
+    [[nodiscard]] size_t PendingTimers() const
+    {
+        std::lock_guard lock(Mutex);
+        return TimerCount;
+    }
+
+    // ----------------------------------------------------------------
+    // 注册 / 移除 (供 awaiter 使用)
+    // ----------------------------------------------------------------
+
+    /// 注册一个在 duration 后到期的定时器; 起点为最近一次 Tick 的时间
+    void AddTimer(Detail::WheelNode& node, Duration duration)
+    {
+        std::lock_guard lock(Mutex);
+        auto ticks = (duration + Resolution - Duration(1)) / Resolution; // 向上取整
+        node.ExpireTick = ToTick(CurrentTime) + static_cast<uint64_t>(ticks > 0 ? ticks : 1);
+        Insert(node);
+        ++TimerCount;
+    }
+
+    void AddFrameWaiter(Detail::WheelNode& node)
+    {
+        std::lock_guard lock(Mutex);
+        FrameWaiters.PushBack(node);
+    }
+
+    void AddPredicateWaiter(Detail::PredicateNode& node)
+    {
+        std::lock_guard lock(Mutex);
+        PredicateWaiters.PushBack(node);
+    }
+
+    /// 移除一个等待节点; 返回 false 表示节点已被摘下 (已到期或正在被恢复)
+    /// 节点正由另一线程上的 Tick 恢复时, 等恢复结束后再返回
+    bool Remove(Detail::WheelNode& node, bool isTimer)
+    {
+        std::unique_lock lock(Mutex);
+        if (!node.IsLinked())
+        {
+            if (InFlight == &node && InFlightThread != std::this_thread::get_id())
+                InFlightDone.wait(lock, [&] { return InFlight != &node; });
+            return false;
+        }
+        node.Unlink();
+        if (isTimer)
+            --TimerCount;
+        return true;
+    }
+
+private:
+    static constexpr size_t   Level0Bits  = 8;
+    static constexpr size_t   LevelNBits  = 6;
+    static constexpr size_t   LevelNCount = 3;
+    static constexpr uint64_t Level0Mask  = (1u << Level0Bits) - 1;
+    static constexpr uint64_t LevelNMask  = (1u << LevelNBits) - 1;
+    static constexpr uint64_t MaxDelta    = (uint64_t{1} << (Level0Bits + LevelNBits * LevelNCount)) - 1;
+
+    using Slot = Detail::WheelNode;
+
+    TimePoint Origin;
+    TimePoint CurrentTime;
+    uint64_t  NextTick   = 1; // 下一个要处理的 tick
+    size_t    TimerCount = 0;
+
+    std::array<Slot, size_t{1} << Level0Bits>                              Level0;
+    std::array<std::array<Slot, size_t{1} << LevelNBits>, LevelNCount>     LevelN;
+    Slot                                                                    FrameWaiters;
+    Slot                                                                    PredicateWaiters;
+
+    mutable std::mutex Mutex;
+
+    // Tick 正在锁外恢复 / 求值的节点 (见 Remove)
+    const Detail::WheelNode* InFlight = nullptr;
+    std::thread::id          InFlightThread;
+    std::condition_variable  InFlightDone;
+
+    /// 在锁内标记 node 为进行中, 析构时 (锁外) 清除并唤醒等待的 Remove
+    class InFlightScope
+    {
+        TimerWheel& Wheel;
+
+    public:
+        InFlightScope(TimerWheel& wheel, const Detail::WheelNode& node) noexcept : Wheel(wheel)
+        {
+            Wheel.InFlight       = &node;
+            Wheel.InFlightThread = std::this_thread::get_id();
+        }
+
+        ~InFlightScope()
+        {
+            {
+                std::lock_guard lock(Wheel.Mutex);
+                Wheel.InFlight = nullptr;
+            }
+            Wheel.InFlightDone.notify_all();
+        }
+
+        InFlightScope(const InFlightScope&)            = delete;
+        InFlightScope& operator=(const InFlightScope&) = delete;
+    };
+
+    [[nodiscard]] uint64_t ToTick(TimePoint time) const noexcept
+    {
+        if (time <= Origin)
+            return 0;
+        return static_cast<uint64_t>((time - Origin) / Resolution);
+    }
+
+    /// 按剩余 tick 数选择层级与槽位 (调用方需持有 Mutex)
+    void Insert(Detail::WheelNode& node) noexcept
+    {
+        uint64_t expire = node.ExpireTick;
+        if (expire < NextTick)
+        {
+            Level0[NextTick & Level0Mask].PushBack(node);
+            return;
+        }
+
+        uint64_t delta = expire - NextTick;
+        if (delta < (uint64_t{1} << Level0Bits))
+        {
+            Level0[expire & Level0Mask].PushBack(node);
+            return;
+        }
+
+        // 超出最大范围时先放在最高层最远的槽, 到期 (cascade) 后重新计算
+        if (delta > MaxDelta)
+            expire = NextTick + MaxDelta;
+
+        for (size_t level = 0; level < LevelNCount; ++level)
+        {
+            size_t shift = Level0Bits + LevelNBits * level;
+            if (delta < (uint64_t{1} << (shift + LevelNBits)) || level + 1 == LevelNCount)
+            {
+                LevelN[level][(expire >> shift) & LevelNMask].PushBack(node);
+                return;
+            }
+        }
+    }
+
+    /// Level 0 转满一圈时, 把上一层对应槽的节点重新分配 (调用方需持有 Mutex)
+    void Cascade() noexcept
+    {
+        if ((NextTick & Level0Mask) != 0)
+            return;
+
+        for (size_t level = 0; level < LevelNCount; ++level)
+        {
+            size_t shift = Level0Bits + LevelNBits * level;
+            size_t index = (NextTick >> shift) & LevelNMask;
+
+            Slot pending;
+            pending.SpliceBack(LevelN[level][index]);
+            while (auto* node = pending.PopFront())
+                Insert(*node);
+
+            // 本层没有转满一圈, 更高层无需处理
+            if (index != 0)
+                break;
+        }
+    }
+
+    /// 恢复一个 Level 0 槽中全部已到期的等待者; 逐个出队, 恢复期间不持锁
+    size_t ExpireSlot(Slot& slot)
+    {
+        size_t resumed = 0;
+        for (;;)
+        {
+            std::coroutine_handle<> handle;
+            std::function<void()>   callback;
+            std::optional<InFlightScope> inFlight;
+            {
+                std::lock_guard lock(Mutex);
+                auto* node = slot.PopFront();
+                if (!node)
+                    break;
+                if (node->ExpireTick > NextTick)
+                {
+                    // 超出最大范围的远期定时器: 重新插入
+                    Insert(*node);
+                    continue;
+                }
+                --TimerCount;
+                if (node->Callback)
+                    callback = node->Callback;
+                else
+                    handle = node->Handle;
+                inFlight.emplace(*this, *node);
+            }
+            if (callback)
+                callback();
+            else
+                handle.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+
+    size_t ResumeFrameWaiters()
+    {
+        Slot ready;
+        {
+            std::lock_guard lock(Mutex);
+            ready.SpliceBack(FrameWaiters);
+        }
+
+        size_t resumed = 0;
+        for (;;)
+        {
+            std::coroutine_handle<> handle;
+            std::optional<InFlightScope> inFlight;
+            {
+                std::lock_guard lock(Mutex);
+                auto* node = ready.PopFront();
+                if (!node)
+                    break;
+                handle = node->Handle;
+                inFlight.emplace(*this, *node);
+            }
+            handle.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+
+    size_t EvaluatePredicates()
+    {
+        Slot checking;
+        {
+            std::lock_guard lock(Mutex);
+            checking.SpliceBack(PredicateWaiters);
+        }
+
+        size_t resumed = 0;
+        for (;;)
+        {
+            Detail::PredicateNode* node;
+            std::optional<InFlightScope> inFlight;
+            {
+                std::lock_guard lock(Mutex);
+                node = static_cast<Detail::PredicateNode*>(checking.PopFront());
+                if (!node)
+                    break;
+                inFlight.emplace(*this, *node);
+            }
+            // 谓词在锁外求值: 其中可以再次使用时间轮
+            if (node->Predicate())
+            {
+                node->Handle.resume();
+                ++resumed;
+            }
+            else
+            {
+                std::lock_guard lock(Mutex);
+                PredicateWaiters.PushBack(*node);
+            }
+        }
+        return resumed;
+    }
+};
+
+
+// ============================================================================
+//  Awaiters
+// ============================================================================
+
+/// co_await Delay(d): 在 d 之后的第一次 Tick 中恢复
+class DelayAwaiter
+{
+    TimerWheel*          Wheel;
+    TimerWheel::Duration Duration;
+    Detail::WheelNode    Node;
+
+public:
+    DelayAwaiter(TimerWheel& wheel, TimerWheel::Duration duration) : Wheel(&wheel), Duration(duration) {}
+
+    // 仅在挂起前可移动 (节点尚未链入时间轮)
+    DelayAwaiter(DelayAwaiter&& other) noexcept : Wheel(other.Wheel), Duration(other.Duration)
+    {
+        assert(!other.Node.IsLinked() && "DelayAwaiter — 不能移动正在等待的 awaiter");
+    }
+
+    ~DelayAwaiter() { Wheel->Remove(Node, /*isTimer=*/true); }
+
+    bool await_ready() const noexcept { return Duration <= TimerWheel::Duration::zero(); }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Node.Handle = handle;
+        Wheel->AddTimer(Node, Duration);
+    }
+
+    void await_resume() const noexcept {}
+
+    /// 取消等待; 返回 true 时保证不会再恢复协程 (供 WhenAny 使用)
+    bool Cancel() { return Wheel->Remove(Node, /*isTimer=*/true); }
+};
+
+/// co_await NextFrame(): 在下一次 Tick 中恢复
+class NextFrameAwaiter
+{
+    TimerWheel*       Wheel;
+    Detail::WheelNode Node;
+
+public:
+    explicit NextFrameAwaiter(TimerWheel& wheel) : Wheel(&wheel) {}
+
+    NextFrameAwaiter(NextFrameAwaiter&& other) noexcept : Wheel(other.Wheel)
+    {
+        assert(!other.Node.IsLinked() && "NextFrameAwaiter — 不能移动正在等待的 awaiter");
+    }
+
+    ~NextFrameAwaiter() { Wheel->Remove(Node, /*isTimer=*/false); }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Node.Handle = handle;
+        Wheel->AddFrameWaiter(Node);
+    }
+
+    void await_resume() const noexcept {}
+
+    bool Cancel() { return Wheel->Remove(Node, /*isTimer=*/false); }
+};
+
+/// co_await Until(pred): 每次 Tick 求值 pred, 成立时恢复; 一开始就成立则不挂起
+class UntilAwaiter
+{
+    TimerWheel*           Wheel;
+    Detail::PredicateNode Node;
+
+public:
+    UntilAwaiter(TimerWheel& wheel, std::function<bool()> predicate) : Wheel(&wheel)
+    {
+        Node.Predicate = std::move(predicate);
+    }
+
+    UntilAwaiter(UntilAwaiter&& other) noexcept : Wheel(other.Wheel)
+    {
+        assert(!other.Node.IsLinked() && "UntilAwaiter — 不能移动正在等待的 awaiter");
+        Node.Predicate = std::move(other.Node.Predicate);
+    }
+
+    ~UntilAwaiter() { Wheel->Remove(Node, /*isTimer=*/false); }
+
+    bool await_ready() const { return Node.Predicate(); }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Node.Handle = handle;
+        Wheel->AddPredicateWaiter(Node);
+    }
+
+    void await_resume() const noexcept {}
+
+    bool Cancel() { return Wheel->Remove(Node, /*isTimer=*/false); }
+};
+
+[[nodiscard]] inline DelayAwaiter Delay(TimerWheel::Duration duration,
+                                        TimerWheel& wheel = TimerWheel::GetDefault())
+{
+    return DelayAwaiter(wheel, duration);
+}
+
+[[nodiscard]] inline NextFrameAwaiter NextFrame(TimerWheel& wheel = TimerWheel::GetDefault())
+{
+    return NextFrameAwaiter(wheel);
+}
+
+[[nodiscard]] inline UntilAwaiter Until(std::function<bool()> predicate,
+                                        TimerWheel& wheel = TimerWheel::GetDefault())
+{
+    return UntilAwaiter(wheel, std::move(predicate));
+}
+
+} // namespace Core
@@ -6,13 +6,19 @@
 #include <random>
 #include <chrono>
 #include <numeric>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
 
 #include "Math/Vector.h"
 #include "BoundingBox.h"
+#include "EndpointRadixSort.h"
 
 namespace Runtime::Core{
 
-using namespace Runtime::Core::Math;
+using namespace ::Core::Math; // Vector 定义在 Core::Math (Math/Vector.h)
 template <typename Ty, std::size_t Dimensions>
     requires std::is_arithmetic_v<Ty>
 struct AABB : public BoundingBox<Ty, Dimensions>
@@ -75,150 +81,212 @@ inline bool IsOverlap(const AABB<Ty, Dimensions>& a,
     return a.IsOverlap(&b);
 }
 /**
- * @brief Sweep and Prune 算法实现
- * @param aabbs: 场景中所有 AABB 构成的列表
- * @param check_order: 测量轴的顺序, 通常来说根据物品的分布从稀疏到密集选择轴会有更好效果, 默认就是 { 0, 1, 2 } 依次检查 x, y, z 轴
- * @return
+ * @brief SweepAndPrune 的临时内存, 只增不减
+ * @note 同一个 scratch (与同一个输出 vector) 反复传给 SweepAndPrune 时, 预热之后每次调用不再分配内存;
+ *       不同线程需要各自的 scratch
  */
-template <typename Ty, std::size_t Dimensions>
+template <typename Ty>
     requires std::is_arithmetic_v<Ty>
-static std::vector<HitInfo> SweepAndPrune(const std::vector<AABB<Ty, Dimensions>>& aabbs, std::array<uint8_t, Dimensions> check_order)
-{
-    // 记录当前轴上 "端点" 信息
-    struct EndPoint {
-        Ty       min;
-        Ty       max;
-        uint64_t idx; // 该端点是 aabbs 中第几个
-    };
+struct SweepAndPruneScratch {
+    using key_type = Detail::SortableKeyType<Ty>;
 
-    using IndexType      = std::uint64_t;
-    using CollisionGroup = std::vector<IndexType>;   // 一组可能发生碰撞的 AABB 索引列表
-    using CollisionList  = std::vector<CollisionGroup>; // 可疑碰撞列表
+    // 可疑碰撞列表以 CSR 形式存放: 组 g 为 indices[offsets[g], offsets[g + 1]), 逐轴在两套缓冲间交替
+    std::vector<std::uint32_t> indices;
+    std::vector<std::uint32_t> next_indices;
+    std::vector<std::size_t>   offsets;
+    std::vector<std::size_t>   next_offsets;
 
-    const std::size_t size = aabbs.size();
+    std::vector<key_type>                  keys;  // 与 indices 对齐的排序键
+    Detail::RadixSortScratch<key_type>     radix;
+};
 
-    std::vector<HitInfo> hits;
-    hits.reserve(size);
+namespace Detail {
 
-    if (size <= 1) {
-        return hits;
-    }
+/**
+ * @brief Sweep and Prune 的分组阶段: 逐轴排序并按「轴向连通」切分可疑碰撞组
+ * @param size: 盒子数量 (>= 2)
+ * @param check_order: 测量轴的顺序
+ * @param scratch: 结果以 CSR 形式留在 scratch.indices / scratch.offsets; 没有可疑组时 offsets.size() == 1
+ * @param min_of, max_of: (下标, 轴) -> 该盒子在该轴上的 min / max
+ * @return 最后一个参与排序的轴, 每个组内已按该轴的 min 有序
+ * @throw std::length_error size 超出 uint32_t 下标范围
+ * @note 供 std::vector<AABB> 与 AABBBatch 两种存储的 SweepAndPrune 共用
+ */
+template <typename Ty, std::size_t Dimensions, typename MinFn, typename MaxFn>
+std::size_t BuildSweepGroups(std::size_t size, const std::array<uint8_t, Dimensions>& check_order,
+                             SweepAndPruneScratch<Ty>& scratch, MinFn&& min_of, MaxFn&& max_of)
+{
+    using IndexType = std::uint32_t;
+    using KeyType   = typename SweepAndPruneScratch<Ty>::key_type;
+
+    CheckSortIndexRange(size, "SweepAndPrune");
+
+    // 缓冲只增不减: resize 到更小的长度不会释放容量
+    auto& indices = scratch.indices;
+    auto& offsets = scratch.offsets;
+    scratch.next_indices.resize(size);
+    scratch.keys.resize(size);
 
     // 初始化的时候整个场景的所有 aabb 就是一个可疑碰撞组
-    CollisionList suspicious_collision_list;
-    CollisionGroup suspicious_collision_group;
-    suspicious_collision_group.resize(size); // 必须 resize 而不是 reserve
-    std::iota(suspicious_collision_group.begin(),
-              suspicious_collision_group.end(),
-              IndexType{0});
-    suspicious_collision_list.push_back(std::move(suspicious_collision_group));
+    indices.resize(size);
+    std::iota(indices.begin(), indices.end(), IndexType{0});
+    offsets.assign({ std::size_t{0}, size });
 
-    // 针对每一个测量轴依次进行 Sweep and Prune
+    // 有效的测量轴; 一个都没有时仍按 0 轴排序, 最终的组内扫描需要一个有序轴
+    std::size_t sweep_axis = 0;
+    bool any_axis = false;
     for (const auto& axis_raw : check_order) {
-        const auto axis = static_cast<std::size_t>(axis_raw);
+        any_axis = any_axis || static_cast<std::size_t>(axis_raw) < Dimensions;
+    }
+
+    // 针对每一个测量轴依次进行 Sweep and Prune
+    for (std::size_t k = 0; k < (any_axis ? Dimensions : 1); ++k) {
+        const auto axis = any_axis ? static_cast<std::size_t>(check_order[k]) : std::size_t{0};
         if (axis >= Dimensions) {
             // 非法轴，直接跳过
             continue;
         }
+        sweep_axis = axis;
 
-        CollisionList next_collision_list;
-        next_collision_list.reserve(suspicious_collision_list.size());
+        auto& next_indices = scratch.next_indices;
+        auto& next_offsets = scratch.next_offsets;
+        next_offsets.clear();
+        next_offsets.push_back(0);
+        std::size_t write = 0;
 
         // 对于每一个 group, 按照组进行逐个细分
-        for (const auto& group : suspicious_collision_list) {
-            if (group.size() <= 1) {
-                // 组内不足两个元素，不可能产生碰撞
-                continue;
-            }
-
-            std::vector<EndPoint> endpoints;
-            endpoints.reserve(group.size());
-
-            // 注册每一个 AABB 在当前轴上的最小值和最大值, 与其对应的索引
-            for (const IndexType idx : group) {
-                const auto& box = aabbs[static_cast<std::size_t>(idx)];
-                endpoints.push_back(EndPoint{
-                    box.min[axis],
-                    box.max[axis],
-                    idx
-                });
-            }
-
-            // 针对当前轴进行排序
-            // todo: 排序可以进一步优化, 因为每一帧的物体位置变化不大, 他们的相对轴的排序可能差别并不大
-            std::sort(endpoints.begin(), endpoints.end(),
-                      [](const EndPoint& a, const EndPoint& b) {
-                          return a.min < b.min;
-                      });
-
-            if (endpoints.empty()) {
-                continue; // 当前 group 在该轴上没有任何 endpoint，跳过
+        const std::size_t group_count = offsets.size() - 1;
+        for (std::size_t g = 0; g < group_count; ++g) {
+            const std::size_t begin = offsets[g];
+            const std::size_t end   = offsets[g + 1];
+
+            // 针对当前轴进行排序: 坐标映射为保序整数键后做基数排序, 组内下标原地随键移动
+            for (std::size_t p = begin; p < end; ++p) {
+                scratch.keys[p] = ToSortableKey(min_of(indices[p], axis));
             }
+            RadixSortPairs(std::span<KeyType>(scratch.keys.data() + begin, end - begin),
+                           std::span<IndexType>(indices.data() + begin, end - begin), scratch.radix);
 
             // 扫描当前轴, 按「轴向连通」切分出更小的 group
             // - 从左到右扫描, 维护一个当前"连通段"
             // - 如果下一个 AABB 的 min > 当前段中所有 AABB 的 max，说明当前段在该轴上已经不再与后面的有重叠，
-            //   可以把当前段作为一个新的子 group 推入 next_collision_list，并重新开始新的段
-            CollisionGroup current_sub_group;
-            current_sub_group.reserve(endpoints.size());
-
-            Ty current_segment_max = endpoints.front().max;
-            current_sub_group.push_back(endpoints.front().idx);
-
-            for (std::size_t i = 1; i < endpoints.size(); ++i) {
-                // 当前轴上的这个 AABB 与之前段中所有 AABB 都不再重叠, 当前段形成一个 group
-                // 换句话说, 一个 group 就是一个基于相交的连通分量
-                // 即 在第一个 AABB 当前轴的 [min, max] 中, 整个组的 min 坐标都在该组中
-                // |---<--------o1-------o1-----o2--------o3--------o2------->--------o3-------o4--------o4---|
-                //     ^        ^        ^      ^         ^         ^        ^        ^        ^         ^
-                //  cur_min   o1_min  o1_max  o2_min   o3_min   o2_max    cur_max  o3_max    o4_min    o4_max
-                // 该组的中 cur, o1, o2, o3 在该轴上都有一定程度的重叠, 但是 o4 在该轴上与他们完全不重叠, 因此 o4 不在该组中
-                if (const auto& ep = endpoints[i]; ep.min > current_segment_max) {
-                    if (current_sub_group.size() > 1) {
-                        next_collision_list.push_back(current_sub_group);
-                    }
-
-                    // 开启新的段
-                    current_sub_group.clear();
-                    current_sub_group.push_back(ep.idx);
-                    current_segment_max = ep.max;
-                } else {
-                    // 当前轴上的这个 AABB 与当前段中至少一个 AABB 仍然重叠, 加入当前段
-                    current_sub_group.push_back(ep.idx);
-                    if (ep.max > current_segment_max) {
-                        current_segment_max = ep.max;
-                    }
+            //   当前段作为一个新的子 group 写入 next_indices (不足两个元素的段直接丢弃)，并重新开始新的段
+            // 一个 group 就是一个基于相交的连通分量:
+            // |---<--------o1-------o1-----o2--------o3--------o2------->--------o3-------o4--------o4---|
+            //     ^        ^        ^      ^         ^         ^        ^        ^        ^         ^
+            //  cur_min   o1_min  o1_max  o2_min   o3_min   o2_max    cur_max  o3_max    o4_min    o4_max
+            // 该组的中 cur, o1, o2, o3 在该轴上都有一定程度的重叠, 但是 o4 在该轴上与他们完全不重叠, 因此 o4 不在该组中
+            std::size_t segment_begin = begin;
+            Ty current_segment_max = max_of(indices[begin], axis);
+            auto flush_segment = [&](std::size_t segment_end) {
+                if (segment_end - segment_begin > 1) {
+                    std::copy(indices.begin() + segment_begin, indices.begin() + segment_end, next_indices.begin() + write);
+                    write += segment_end - segment_begin;
+                    next_offsets.push_back(write);
+                }
+            };
+
+            for (std::size_t p = begin + 1; p < end; ++p) {
+                const Ty box_min = min_of(indices[p], axis);
+                const Ty box_max = max_of(indices[p], axis);
+                if (box_min > current_segment_max) {
+                    // 当前轴上的这个 AABB 与之前段中所有 AABB 都不再重叠, 当前段形成一个 group, 开启新的段
+                    flush_segment(p);
+                    segment_begin = p;
+                    current_segment_max = box_max;
+                } else if (box_max > current_segment_max) {
+                    // 与当前段中至少一个 AABB 仍然重叠, 加入当前段
+                    current_segment_max = box_max;
                 }
             }
-
-            if (current_sub_group.size() > 1) {
-                next_collision_list.push_back(std::move(current_sub_group));
-            }
+            flush_segment(end);
         }
 
         // 用新的一轮结果替代旧的可疑碰撞列表
-        suspicious_collision_list = std::move(next_collision_list);
+        indices.swap(next_indices);
+        offsets.swap(next_offsets);
+        next_indices.resize(size);
 
         // 如果经过这一轴筛选后已经没有可疑组了，可以提前结束
-        if (suspicious_collision_list.empty()) break;
+        if (offsets.size() == 1) {
+            break;
+        }
+    }
+    return sweep_axis;
+}
+
+} // namespace Detail
+
+/**
+ * @brief Sweep and Prune 算法实现
+ * @param aabbs: 场景中所有 AABB 构成的列表
+ * @param check_order: 测量轴的顺序, 通常来说根据物品的分布从稀疏到密集选择轴会有更好效果, 默认就是 { 0, 1, 2 } 依次检查 x, y, z 轴
+ * @param scratch: 跨调用复用的临时内存
+ * @param hits: 输出, 先被清空; idx1 < idx2
+ * @throw std::length_error AABB 数量超出 uint32_t 下标范围
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+static void SweepAndPrune(const std::vector<AABB<Ty, Dimensions>>& aabbs, std::array<uint8_t, Dimensions> check_order,
+                          SweepAndPruneScratch<Ty>& scratch, std::vector<HitInfo>& hits)
+{
+    using IndexType = std::uint32_t;
+
+    const std::size_t size = aabbs.size();
+    hits.clear();
+
+    if (size <= 1) {
+        return;
     }
 
+    const std::size_t sweep_axis = Detail::BuildSweepGroups<Ty, Dimensions>(
+        size, check_order, scratch,
+        [&](IndexType idx, std::size_t axis) { return aabbs[idx].min[axis]; },
+        [&](IndexType idx, std::size_t axis) { return aabbs[idx].max[axis]; });
+    const auto& indices = scratch.indices;
+    const auto& offsets = scratch.offsets;
+
     // 最终从 group 中生成具体的碰撞对
-    // 此时 suspicious_collision_list 中的每个 group 表示: 在所有经过的轴上都存在一定程度连通性的 AABB 集合
-    // 我们再在每个 group 内做一次多轴 AABB 重叠检查(IsOverlap), 把真正宽相重叠的 AABB 对输出为 HitInfo
-    for (const auto& group : suspicious_collision_list) {
-        const std::size_t group_size = group.size();
-        for (std::size_t i = 0; i < group_size; ++i) {
-            for (std::size_t j = i + 1; j < group_size; ++j) {
-                const auto idx1 = group[i];
-                const auto idx2 = group[j];
-                if (aabbs[idx1].IsOverlap(&aabbs[idx2])) {
-                    hits.push_back(HitInfo{ idx1, idx2 });
+    // 此时每个 group 表示: 在所有经过的轴上都存在一定程度连通性的 AABB 集合, 且组内已按最后一个测量轴的 min 有序.
+    // 组内每个 AABB 只需向后扫描到 min 超过自身 max 为止, 再做一次多轴重叠检查
+    const std::size_t group_count = offsets.size() - 1;
+    for (std::size_t g = 0; g < group_count; ++g) {
+        const std::size_t end = offsets[g + 1];
+        for (std::size_t p = offsets[g]; p < end; ++p) {
+            const IndexType idx1 = indices[p];
+            const auto& box1 = aabbs[idx1];
+            for (std::size_t q = p + 1; q < end; ++q) {
+                const IndexType idx2 = indices[q];
+                const auto& box2 = aabbs[idx2];
+                if (box2.min[sweep_axis] > box1.max[sweep_axis]) {
+                    break;
+                }
+                bool overlap = true;
+                for (std::size_t axis = 0; axis < Dimensions && overlap; ++axis) {
+                    overlap = !(box1.max[axis] < box2.min[axis] || box2.max[axis] < box1.min[axis]);
+                }
+                if (overlap) {
+                    hits.push_back(HitInfo{ std::min(idx1, idx2), std::max(idx1, idx2) });
                 }
             }
         }
     }
+}
 
+/**
+ * @brief Sweep and Prune 算法实现, 每次调用使用新的临时内存
+ * @param aabbs: 场景中所有 AABB 构成的列表
+ * @param check_order: 测量轴的顺序, 同上
+ * @return
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+static std::vector<HitInfo> SweepAndPrune(const std::vector<AABB<Ty, Dimensions>>& aabbs, std::array<uint8_t, Dimensions> check_order)
+{
+    SweepAndPruneScratch<Ty> scratch;
+    std::vector<HitInfo> hits;
+    hits.reserve(aabbs.size());
+    SweepAndPrune(aabbs, check_order, scratch, hits);
     return hits;
 }
 
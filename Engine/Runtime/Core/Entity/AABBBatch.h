@@ -0,0 +1,507 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CORE_AABB_BATCH_SSE2 1
+#endif
+
+#include "AABB.h"
+#include "SoA/SoaDynamicArray.h"
+
+namespace Runtime::Core{
+
+namespace Detail {
+
+// 2 * Dimensions 列: [0, Dimensions) 为各轴 min, [Dimensions, 2 * Dimensions) 为各轴 max
+template <typename Ty, typename Indices>
+struct AABBBatchStorage;
+
+template <typename Ty, std::size_t... Is>
+struct AABBBatchStorage<Ty, std::index_sequence<Is...>>
+{
+    template <std::size_t>
+    using column = Ty;
+    using type = ::Core::SoaDynamicArray<column<Is>...>;
+};
+
+/**
+ * @brief 一个盒子与 rows[first, first + 8) 的重叠测试
+ * @return 位掩码, 第 k 位为 1 表示与 first + k 行重叠; 判定与 AABB::IsOverlap 完全一致 (含 NaN)
+ * @note 调用方保证 first + 8 <= 列长度. float 在 AVX2 下一条比较指令处理 8 个盒子, SSE2 下两条
+ */
+template <typename Ty, std::size_t Dimensions>
+inline std::uint32_t OverlapMask8(const std::array<const Ty*, Dimensions>& mins,
+                                  const std::array<const Ty*, Dimensions>& maxs,
+                                  const Ty* box_min, const Ty* box_max, std::size_t first) noexcept
+{
+    if constexpr (std::is_same_v<Ty, float>) {
+#if defined(__AVX2__)
+        __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            const __m256 lo = _mm256_loadu_ps(mins[axis] + first);
+            const __m256 hi = _mm256_loadu_ps(maxs[axis] + first);
+            // !(box_max < lo) && !(hi < box_min)
+            mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_set1_ps(box_max[axis]), lo, _CMP_NLT_UQ));
+            mask = _mm256_and_ps(mask, _mm256_cmp_ps(hi, _mm256_set1_ps(box_min[axis]), _CMP_NLT_UQ));
+        }
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(mask));
+#elif defined(CORE_AABB_BATCH_SSE2)
+        __m128 mask_lo = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        __m128 mask_hi = mask_lo;
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            const __m128 bmax = _mm_set1_ps(box_max[axis]);
+            const __m128 bmin = _mm_set1_ps(box_min[axis]);
+            mask_lo = _mm_and_ps(mask_lo, _mm_cmpnlt_ps(bmax, _mm_loadu_ps(mins[axis] + first)));
+            mask_lo = _mm_and_ps(mask_lo, _mm_cmpnlt_ps(_mm_loadu_ps(maxs[axis] + first), bmin));
+            mask_hi = _mm_and_ps(mask_hi, _mm_cmpnlt_ps(bmax, _mm_loadu_ps(mins[axis] + first + 4)));
+            mask_hi = _mm_and_ps(mask_hi, _mm_cmpnlt_ps(_mm_loadu_ps(maxs[axis] + first + 4), bmin));
+        }
+        return static_cast<std::uint32_t>(_mm_movemask_ps(mask_lo) | (_mm_movemask_ps(mask_hi) << 4));
+#endif
+    }
+
+    std::uint32_t mask = 0;
+    for (std::size_t k = 0; k < 8; ++k) {
+        bool overlap = true;
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            overlap &= !(box_max[axis] < mins[axis][first + k]) && !(maxs[axis][first + k] < box_min[axis]);
+        }
+        mask |= static_cast<std::uint32_t>(overlap) << k;
+    }
+    return mask;
+}
+
+/**
+ * @brief rows[first, first + 8) 中 min <= limit 的位掩码 (扫描轴上仍与当前盒子区间相交)
+ */
+template <typename Ty>
+inline std::uint32_t NotAfterMask8(const Ty* mins, Ty limit, std::size_t first) noexcept
+{
+    if constexpr (std::is_same_v<Ty, float>) {
+#if defined(__AVX2__)
+        return static_cast<std::uint32_t>(_mm256_movemask_ps(
+            _mm256_cmp_ps(_mm256_set1_ps(limit), _mm256_loadu_ps(mins + first), _CMP_NLT_UQ)));
+#elif defined(CORE_AABB_BATCH_SSE2)
+        const __m128 l = _mm_set1_ps(limit);
+        return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpnlt_ps(l, _mm_loadu_ps(mins + first))) |
+                                           (_mm_movemask_ps(_mm_cmpnlt_ps(l, _mm_loadu_ps(mins + first + 4))) << 4));
+#endif
+    }
+
+    std::uint32_t mask = 0;
+    for (std::size_t k = 0; k < 8; ++k) {
+        mask |= static_cast<std::uint32_t>(!(limit < mins[first + k])) << k;
+    }
+    return mask;
+}
+
+} // namespace Detail
+
+/**
+ * @brief AABB 的 SoA 批量容器: 每个轴的 min / max 各占一列 (minX[], minY[], ..., maxX[], ...)
+ * @note 列按 64 字节对齐连续存放, 重叠测试一次处理 8 个盒子 (float + AVX2 / SSE2, 其他类型为标量);
+ *       没有虚函数与 dynamic_cast. 下方的 SweepAndPrune / BruteForcePairs 等重载直接接受该容器.
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+class AABBBatch
+{
+    using Storage = typename Detail::AABBBatchStorage<Ty, std::make_index_sequence<2 * Dimensions>>::type;
+
+public:
+    using value_type = Ty;
+    using aabb_type  = AABB<Ty, Dimensions>;
+    static constexpr std::size_t dimensions = Dimensions;
+    static constexpr std::size_t lanes = 8; // 单次重叠测试处理的盒子数
+
+    AABBBatch() = default;
+    explicit AABBBatch(const std::vector<aabb_type>& aabbs) { Assign(aabbs); }
+
+    /**
+     * @brief 用 AoS 形式的 AABB 列表重建, 按列逐轴拷贝
+     */
+    void Assign(const std::vector<aabb_type>& aabbs)
+    {
+        columns.Clear();
+        columns.Resize(aabbs.size());
+        auto mins = MinColumns();
+        auto maxs = MaxColumns();
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            for (std::size_t i = 0; i < aabbs.size(); ++i) {
+                mins[axis][i] = aabbs[i].min[axis];
+                maxs[axis][i] = aabbs[i].max[axis];
+            }
+        }
+    }
+
+    void PushBack(const aabb_type& box)
+    {
+        columns.Resize(columns.Size() + 1);
+        Set(columns.Size() - 1, box);
+    }
+
+    void Set(std::size_t index, const aabb_type& box) noexcept
+    {
+        auto mins = MinColumns();
+        auto maxs = MaxColumns();
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            mins[axis][index] = box.min[axis];
+            maxs[axis][index] = box.max[axis];
+        }
+    }
+
+    [[nodiscard]] aabb_type Get(std::size_t index) const noexcept
+    {
+        aabb_type box;
+        auto mins = MinColumns();
+        auto maxs = MaxColumns();
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            box.min[axis] = mins[axis][index];
+            box.max[axis] = maxs[axis][index];
+        }
+        return box;
+    }
+
+    void Reserve(std::size_t capacity) { columns.Reserve(capacity); }
+    void Resize(std::size_t size) { columns.Resize(size); }
+    void Clear() noexcept { columns.Clear(); }
+
+    [[nodiscard]] std::size_t Size() const noexcept { return columns.Size(); }
+    [[nodiscard]] bool IsEmpty() const noexcept { return columns.IsEmpty(); }
+
+    [[nodiscard]] std::span<const Ty> Min(std::size_t axis) const noexcept { return { MinColumns()[axis], Size() }; }
+    [[nodiscard]] std::span<const Ty> Max(std::size_t axis) const noexcept { return { MaxColumns()[axis], Size() }; }
+    [[nodiscard]] std::span<Ty> Min(std::size_t axis) noexcept { return { MinColumns()[axis], Size() }; }
+    [[nodiscard]] std::span<Ty> Max(std::size_t axis) noexcept { return { MaxColumns()[axis], Size() }; }
+
+    [[nodiscard]] bool IsOverlap(std::size_t i, std::size_t j) const noexcept
+    {
+        auto mins = MinColumns();
+        auto maxs = MaxColumns();
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            if (maxs[axis][i] < mins[axis][j] || maxs[axis][j] < mins[axis][i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 对 rows[first, last) 中与盒子 (box_min, box_max) 重叠的每一行调用 fn(row)
+     * @note 每 8 行一次 SIMD 测试, 尾部不足 8 行时逐个测试
+     */
+    template <typename Fn>
+    void ForEachOverlap(const Ty* box_min, const Ty* box_max, std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        const auto mins = ConstMinColumns();
+        const auto maxs = ConstMaxColumns();
+        std::size_t j = first;
+        for (; j + lanes <= last; j += lanes) {
+            for (std::uint32_t mask = Detail::OverlapMask8<Ty, Dimensions>(mins, maxs, box_min, box_max, j);
+                 mask != 0; mask &= mask - 1) {
+                fn(j + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+        }
+        for (; j < last; ++j) {
+            bool overlap = true;
+            for (std::size_t axis = 0; axis < Dimensions && overlap; ++axis) {
+                overlap = !(box_max[axis] < mins[axis][j]) && !(maxs[axis][j] < box_min[axis]);
+            }
+            if (overlap) {
+                fn(j);
+            }
+        }
+    }
+
+    /**
+     * @brief 对与第 index 行重叠的 rows[first, last) 调用 fn(row)
+     */
+    template <typename Fn>
+    void ForEachOverlap(std::size_t index, std::size_t first, std::size_t last, Fn&& fn) const
+    {
+        const auto box = LoadBox(index);
+        ForEachOverlap(box.first.data(), box.second.data(), first, last, std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief 对与 box 重叠的所有行调用 fn(row)
+     */
+    template <typename Fn>
+    void ForEachOverlap(const aabb_type& box, Fn&& fn) const
+    {
+        std::array<Ty, Dimensions> box_min{}, box_max{};
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            box_min[axis] = box.min[axis];
+            box_max[axis] = box.max[axis];
+        }
+        ForEachOverlap(box_min.data(), box_max.data(), 0, Size(), std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief 把第 indices[k] 行拷贝为本容器的第 k 行 (用于按扫描轴排序或抽取分组)
+     */
+    void GatherFrom(const AABBBatch& source, std::span<const std::uint64_t> indices)
+    {
+        GatherRows(source, indices);
+    }
+
+    void GatherFrom(const AABBBatch& source, std::span<const std::uint32_t> indices)
+    {
+        GatherRows(source, indices);
+    }
+
+    [[nodiscard]] std::array<const Ty*, Dimensions> ConstMinColumns() const noexcept { return ColumnPointers<0>(); }
+    [[nodiscard]] std::array<const Ty*, Dimensions> ConstMaxColumns() const noexcept { return ColumnPointers<Dimensions>(); }
+
+private:
+    Storage columns;
+
+    template <typename Index>
+    void GatherRows(const AABBBatch& source, std::span<const Index> indices)
+    {
+        columns.Clear();
+        columns.Resize(indices.size());
+        auto dst_min = MinColumns();
+        auto dst_max = MaxColumns();
+        const auto src_min = source.ConstMinColumns();
+        const auto src_max = source.ConstMaxColumns();
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            for (std::size_t k = 0; k < indices.size(); ++k) {
+                dst_min[axis][k] = src_min[axis][indices[k]];
+                dst_max[axis][k] = src_max[axis][indices[k]];
+            }
+        }
+    }
+
+    template <std::size_t Offset>
+    std::array<const Ty*, Dimensions> ColumnPointers() const noexcept
+    {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<const Ty*, Dimensions>{ columns.template Column<Offset + Is>().data()... };
+        }(std::make_index_sequence<Dimensions>{});
+    }
+
+    std::array<Ty*, Dimensions> MinColumns() noexcept { return MutableColumns<0>(); }
+    std::array<Ty*, Dimensions> MaxColumns() noexcept { return MutableColumns<Dimensions>(); }
+    std::array<const Ty*, Dimensions> MinColumns() const noexcept { return ConstMinColumns(); }
+    std::array<const Ty*, Dimensions> MaxColumns() const noexcept { return ConstMaxColumns(); }
+
+    template <std::size_t Offset>
+    std::array<Ty*, Dimensions> MutableColumns() noexcept
+    {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<Ty*, Dimensions>{ columns.template Column<Offset + Is>().data()... };
+        }(std::make_index_sequence<Dimensions>{});
+    }
+
+    std::pair<std::array<Ty, Dimensions>, std::array<Ty, Dimensions>> LoadBox(std::size_t index) const noexcept
+    {
+        std::pair<std::array<Ty, Dimensions>, std::array<Ty, Dimensions>> box;
+        const auto mins = ConstMinColumns();
+        const auto maxs = ConstMaxColumns();
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            box.first[axis]  = mins[axis][index];
+            box.second[axis] = maxs[axis][index];
+        }
+        return box;
+    }
+};
+
+namespace Detail {
+
+/**
+ * @brief 已按 axis 轴 min 升序排列的批量盒子上做前向扫描
+ * @param full_test true: 全维重叠测试; false: 只要求 axis 轴区间相交 (1D SAP 候选)
+ * @param fn fn(i, j), i < j 为 sorted 中的行号
+ * @note 对第 i 行只向后扫描到第一个 min > max_i 的位置; 每 8 行一次 SIMD 测试,
+ *       同一组 8 行里一旦出现 min > max_i 的行, 之后的行不必再看
+ */
+template <typename Ty, std::size_t Dimensions, typename Fn>
+void SweepSortedBatch(const AABBBatch<Ty, Dimensions>& sorted, std::size_t axis, bool full_test, Fn&& fn)
+{
+    const std::size_t n = sorted.Size();
+    const auto mins = sorted.ConstMinColumns();
+    const auto maxs = sorted.ConstMaxColumns();
+    const Ty* sweep_min = mins[axis];
+
+    std::array<Ty, Dimensions> box_min{}, box_max{};
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t a = 0; a < Dimensions; ++a) {
+            box_min[a] = mins[a][i];
+            box_max[a] = maxs[a][i];
+        }
+        const Ty limit = box_max[axis];
+
+        std::size_t j = i + 1;
+        bool done = false;
+        for (; !done && j + AABBBatch<Ty, Dimensions>::lanes <= n; j += AABBBatch<Ty, Dimensions>::lanes) {
+            const std::uint32_t in_range = NotAfterMask8(sweep_min, limit, j);
+            done = in_range != 0xFFu;
+            std::uint32_t mask = full_test
+                ? OverlapMask8<Ty, Dimensions>(mins, maxs, box_min.data(), box_max.data(), j) & in_range
+                : in_range;
+            for (; mask != 0; mask &= mask - 1) {
+                fn(i, j + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+        }
+        for (; !done && j < n; ++j) {
+            if (limit < sweep_min[j]) {
+                break;
+            }
+            bool overlap = true;
+            for (std::size_t a = 0; full_test && a < Dimensions && overlap; ++a) {
+                overlap = !(box_max[a] < mins[a][j]) && !(maxs[a][j] < box_min[a]);
+            }
+            if (overlap) {
+                fn(i, j);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 按 axis 轴 min 排序, 返回排序后的批量盒子与行号映射
+ * @note 与 SweepAndPrune 相同, 坐标先映射为保序整数键 (ToSortableKey) 再做基数排序.
+ *       NaN 也因此有确定的位置, 不会像以 < 比较的 std::sort 那样违反严格弱序;
+ *       含 NaN 的盒子参与扫描时, 与之相关的结果未指定
+ */
+template <typename Ty, std::size_t Dimensions>
+std::vector<std::uint32_t> SortBatchByAxis(const AABBBatch<Ty, Dimensions>& batch, std::size_t axis,
+                                           AABBBatch<Ty, Dimensions>& sorted)
+{
+    using KeyType = SortableKeyType<Ty>;
+
+    const std::size_t n = batch.Size();
+    CheckSortIndexRange(n, "SortBatchByAxis");
+
+    std::vector<std::uint32_t> order(n);
+    std::iota(order.begin(), order.end(), std::uint32_t{0});
+    std::vector<KeyType> keys(n);
+    const auto mins = batch.Min(axis);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = ToSortableKey(mins[i]);
+    }
+    RadixSortScratch<KeyType> radix;
+    RadixSortPairs(std::span<KeyType>(keys), std::span<std::uint32_t>(order), radix);
+
+    sorted.GatherFrom(batch, std::span<const std::uint32_t>(order));
+    return order;
+}
+
+inline HitInfo MakeOrderedHit(std::uint64_t a, std::uint64_t b) noexcept
+{
+    return a < b ? HitInfo{ a, b } : HitInfo{ b, a };
+}
+
+} // namespace Detail
+
+/**
+ * @brief 朴素 O(N^2) 检测的批量版本: 每个盒子与其后的盒子逐 8 个做 SIMD 测试
+ * @return 与 BruteForcePairs(const std::vector<AABB>&) 相同的结果 (idx1 < idx2, 按 idx1, idx2 升序)
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+static std::vector<HitInfo> BruteForcePairs(const AABBBatch<Ty, Dimensions>& batch)
+{
+    std::vector<HitInfo> hits;
+    const std::size_t n = batch.Size();
+    for (std::size_t i = 0; i < n; ++i) {
+        batch.ForEachOverlap(i, i + 1, n, [&](std::size_t j) {
+            hits.push_back(HitInfo{ i, j });
+        });
+    }
+    return hits;
+}
+
+/**
+ * @brief 1D Sweep and Prune 的批量版本: 只在 axis 轴上生成候选对
+ * @return 候选对, idx1 < idx2, 顺序未指定
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+static std::vector<HitInfo> SweepAndPrune1D(const AABBBatch<Ty, Dimensions>& batch, const std::size_t axis)
+{
+    std::vector<HitInfo> candidates;
+    if (batch.Size() <= 1 || axis >= Dimensions) return candidates;
+
+    AABBBatch<Ty, Dimensions> sorted;
+    const auto order = Detail::SortBatchByAxis(batch, axis, sorted);
+    Detail::SweepSortedBatch(sorted, axis, false, [&](std::size_t i, std::size_t j) {
+        candidates.push_back(Detail::MakeOrderedHit(order[i], order[j]));
+    });
+    return candidates;
+}
+
+/**
+ * @brief 1D SAP + 全维重叠的批量版本: 扫描与窄相在同一趟 SIMD 前向扫描中完成
+ * @return 重叠对, idx1 < idx2, 顺序未指定
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+static std::vector<HitInfo> FullAABBCollisionFrom1D(const AABBBatch<Ty, Dimensions>& batch, std::size_t axis)
+{
+    std::vector<HitInfo> hits;
+    if (batch.Size() <= 1 || axis >= Dimensions) return hits;
+
+    AABBBatch<Ty, Dimensions> sorted;
+    const auto order = Detail::SortBatchByAxis(batch, axis, sorted);
+    Detail::SweepSortedBatch(sorted, axis, true, [&](std::size_t i, std::size_t j) {
+        hits.push_back(Detail::MakeOrderedHit(order[i], order[j]));
+    });
+    return hits;
+}
+
+/**
+ * @brief 多轴 Sweep and Prune 的批量版本, 分组规则与 SweepAndPrune(const std::vector<AABB>&, ...) 相同
+ * @note 分组阶段与 AoS 版本共用 Detail::BuildSweepGroups (CSR 分组 + 基数排序), 端点直接从列中读取;
+ *       最终每个分组 (已按最后一个测量轴的 min 有序) 抽取为一个小的 AABBBatch, 组内做前向 SIMD 扫描
+ * @return 重叠对, idx1 < idx2, 顺序未指定
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+static std::vector<HitInfo> SweepAndPrune(const AABBBatch<Ty, Dimensions>& batch, std::array<uint8_t, Dimensions> check_order)
+{
+    using IndexType = std::uint32_t;
+
+    const std::size_t size = batch.Size();
+    std::vector<HitInfo> hits;
+    if (size <= 1) {
+        return hits;
+    }
+
+    const auto mins = batch.ConstMinColumns();
+    const auto maxs = batch.ConstMaxColumns();
+    SweepAndPruneScratch<Ty> scratch;
+    const std::size_t sweep_axis = Detail::BuildSweepGroups<Ty, Dimensions>(
+        size, check_order, scratch,
+        [&](IndexType idx, std::size_t axis) { return mins[axis][idx]; },
+        [&](IndexType idx, std::size_t axis) { return maxs[axis][idx]; });
+
+    // 组内窄相: 抽取为连续的小批量后前向扫描, 每 8 行一次 SIMD 测试
+    AABBBatch<Ty, Dimensions> group_batch;
+    const auto& offsets = scratch.offsets;
+    for (std::size_t g = 0; g + 1 < offsets.size(); ++g) {
+        const std::span<const IndexType> group(scratch.indices.data() + offsets[g], offsets[g + 1] - offsets[g]);
+        group_batch.GatherFrom(batch, group);
+        Detail::SweepSortedBatch(group_batch, sweep_axis, true, [&](std::size_t i, std::size_t j) {
+            hits.push_back(Detail::MakeOrderedHit(group[i], group[j]));
+        });
+    }
+
+    return hits;
+}
+
+} // namespace Runtime::Core
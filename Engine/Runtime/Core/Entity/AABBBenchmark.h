@@ -0,0 +1,154 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "AABB.h"
+#include "AABBBatch.h"
+#include "ParallelSweepAndPrune.h"
+
+namespace Runtime::Core::AABBBenchmark{
+
+/**
+ * 宽相检测性能对比: AoS 的 AABB (虚函数 + dynamic_cast) 与 SoA 的 AABBBatch (SIMD)
+ *
+ * 用法:
+ *   for (std::size_t n : { 10'000, 100'000, 1'000'000 }) {
+ *       auto r = Runtime::Core::AABBBenchmark::CompareBroadphase(n, EBoxDistribution::Corridor);
+ *       std::println("N={} SAP {}us -> batch SAP {}us, 1D batch {}us, consistent={}",
+ *                    r.count, r.sap_us, r.batch_sap_us, r.batch_sap1d_us, r.consistent);
+ *   }
+ */
+
+/**
+ * 盒子分布
+ * - Corridor: 盒子沿 X 轴排成长廊 (X 范围与 N 成正比, Y / Z 固定), X 轴投影上有大量空隙,
+ *             多轴 SAP 能切出很小的组, 每个盒子平均有少量真实重叠
+ * - Dense:    立方体世界, 边长与 N 的立方根成正比, 盒子密度恒定; 单轴投影几乎连成一片,
+ *             多轴 SAP 的分组退化为整体 O(N^2), 只适合较小的 N
+ */
+enum class EBoxDistribution : std::uint8_t {
+    Corridor,
+    Dense,
+};
+
+struct BroadphaseBenchmarkResult {
+    std::size_t count = 0;
+    std::size_t hits  = 0;      // 重叠对数量 (以 batch 1D SAP 为准)
+
+    // 各算法耗时 (微秒), 超过 brute_force_limit 未运行的为 -1
+    std::int64_t brute_us        = -1; // BruteForcePairs(std::vector<AABB>)
+    std::int64_t sap_us          = -1; // SweepAndPrune(std::vector<AABB>)
+    std::int64_t batch_brute_us  = -1; // BruteForcePairs(AABBBatch)
+    std::int64_t batch_sap_us    = -1; // SweepAndPrune(AABBBatch)
+    std::int64_t batch_sap1d_us  = -1; // FullAABBCollisionFrom1D(AABBBatch)
+    std::int64_t parallel_sap_us = -1; // ParallelSweepAndPrune(std::vector<AABB>), GThreadPool()
+    std::int64_t build_batch_us  = -1; // AoS -> AABBBatch 转换
+
+    bool consistent = true;     // 所有运行过的算法结果一致
+};
+
+namespace Detail {
+
+    inline std::vector<AABB<float, 3>> GenerateBoxes(std::size_t count, EBoxDistribution distribution, std::uint32_t seed)
+    {
+        const float n = static_cast<float>(std::max<std::size_t>(count, 1));
+        const bool corridor = distribution == EBoxDistribution::Corridor;
+        const float world_x  = corridor ? 4.0f * n : 10.0f * std::cbrt(n);
+        const float world_yz = corridor ? 20.0f : world_x;
+        std::mt19937 rng{ seed };
+        std::uniform_real_distribution<float> center_x(0.0f, world_x);
+        std::uniform_real_distribution<float> center_yz(0.0f, world_yz);
+        std::uniform_real_distribution<float> half(0.5f, 2.0f);
+
+        std::vector<AABB<float, 3>> aabbs;
+        aabbs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const float cx = center_x(rng), cy = center_yz(rng), cz = center_yz(rng);
+            const float hx = half(rng), hy = half(rng), hz = half(rng);
+            aabbs.emplace_back(Vector<float, 3>{ cx - hx, cy - hy, cz - hz },
+                               Vector<float, 3>{ cx + hx, cy + hy, cz + hz });
+        }
+        return aabbs;
+    }
+
+    inline void Normalize(std::vector<HitInfo>& hits)
+    {
+        for (auto& h : hits) {
+            if (h.idx1 > h.idx2) std::swap(h.idx1, h.idx2);
+        }
+        std::sort(hits.begin(), hits.end(), [](const HitInfo& a, const HitInfo& b) {
+            return a.idx1 != b.idx1 ? a.idx1 < b.idx1 : a.idx2 < b.idx2;
+        });
+    }
+
+    template <typename Fn>
+    std::int64_t MeasureUs(Fn&& fn)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+    }
+
+} // namespace Detail
+
+/**
+ * @brief 在 count 个随机 3D 盒子上运行各宽相算法并计时
+ * @param count 盒子数量
+ * @param distribution 盒子分布, 见 EBoxDistribution
+ * @param brute_force_limit 超过该数量时跳过两个 O(N^2) 的暴力算法
+ * @param sap_limit 超过该数量时跳过两个多轴 SweepAndPrune (Dense 分布下它们同样是 O(N^2))
+ * @param seed 随机种子
+ */
+inline BroadphaseBenchmarkResult CompareBroadphase(std::size_t count,
+                                                   EBoxDistribution distribution = EBoxDistribution::Corridor,
+                                                   std::size_t brute_force_limit = 20'000,
+                                                   std::size_t sap_limit         = std::numeric_limits<std::size_t>::max(),
+                                                   std::uint32_t seed            = 42)
+{
+    BroadphaseBenchmarkResult result;
+    result.count = count;
+
+    const auto aabbs = Detail::GenerateBoxes(count, distribution, seed);
+    const std::array<uint8_t, 3> order{ 0, 1, 2 };
+
+    AABBBatch<float, 3> batch;
+    result.build_batch_us = Detail::MeasureUs([&] { batch.Assign(aabbs); });
+
+    std::vector<HitInfo> reference;
+    result.batch_sap1d_us = Detail::MeasureUs([&] { reference = FullAABBCollisionFrom1D(batch, 0); });
+    Detail::Normalize(reference);
+    result.hits = reference.size();
+
+    auto check = [&](std::vector<HitInfo>& hits) {
+        Detail::Normalize(hits);
+        result.consistent = result.consistent && hits == reference;
+    };
+
+    std::vector<HitInfo> hits;
+    result.parallel_sap_us = Detail::MeasureUs([&] { hits = ParallelSweepAndPrune(aabbs, order); });
+    check(hits);
+
+    if (count <= sap_limit) {
+        result.batch_sap_us = Detail::MeasureUs([&] { hits = SweepAndPrune(batch, order); });
+        check(hits);
+        result.sap_us = Detail::MeasureUs([&] { hits = SweepAndPrune(aabbs, order); });
+        check(hits);
+    }
+
+    if (count <= brute_force_limit) {
+        result.batch_brute_us = Detail::MeasureUs([&] { hits = BruteForcePairs(batch); });
+        check(hits);
+        result.brute_us = Detail::MeasureUs([&] { hits = BruteForcePairs(aabbs); });
+        check(hits);
+    }
+
+    return result;
+}
+
+} // namespace Runtime::Core::AABBBenchmark
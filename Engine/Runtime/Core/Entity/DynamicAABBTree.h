@@ -0,0 +1,672 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AABB.h"
+
+namespace Runtime::Core{
+
+/**
+ * @brief 动态 AABB 树 (动态 BVH)
+ *
+ * SweepAndPrune 系列每次都从全部盒子出发; 对静态物体多, 动态物体少且每帧只动一点的场景, 维护一棵
+ * 包围盒层次树更合适: 插入 / 删除 / 更新都是 O(log N), 区域查询与重叠对查询只访问与之相交的子树.
+ *
+ *   - 叶子保存 "胖" 包围盒 (fat AABB): 真实盒子四周外扩 fat_margin, 并沿位移方向再外扩.
+ *     物体只要仍在胖盒内, MoveProxy 直接返回, 不动树
+ *   - 插入按表面积启发 (SAH) 自根向下选兄弟节点: 比较 "在此处新建父节点" 与 "下探到某个子节点"
+ *     的代价 (合并后表面积 + 祖先因扩张增加的表面积), 选代价最小者
+ *   - 插入 / 删除后沿祖先链回溯, 在每个祖先处按表面积做一次树旋转 (子节点与侄节点互换),
+ *     修复贪心插入造成的劣质分组
+ *   - 节点位于连续数组中并通过空闲链表复用 (节点池), 代理 id 即叶子节点下标, 在其生命周期内不变
+ *
+ * 用法:
+ *   DynamicAABBTree<float, 3> tree(0.1f);
+ *   auto id = tree.CreateProxy(box, entity_index);
+ *   tree.MoveProxy(id, new_box, velocity * dt);           // 返回 true 表示树被修改
+ *   tree.Query(region, [&](auto proxy) { ... });          // 区域查询
+ *   tree.QueryPairs([&](auto a, auto b) { ... });         // 树内重叠对
+ *   dynamic_tree.QueryPairs(static_tree, [&](auto a, auto b) { ... }); // 动态树 vs 静态树
+ *
+ * @note 查询基于胖盒, 得到的是候选对 (包含真实重叠的全部对), 窄相需要再做精确判定;
+ *       fat_margin 为 0 且不传位移时, QueryPairs 的结果与 BruteForcePairs 一致.
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+class DynamicAABBTree
+{
+public:
+    using ProxyId   = std::int32_t;
+    using aabb_type = AABB<Ty, Dimensions>;
+    using vector_type = Vector<Ty, Dimensions>;
+
+    static constexpr ProxyId NullNode = -1;
+
+    /**
+     * @param fat_margin 胖盒在每个方向上的外扩量
+     * @param displacement_multiplier MoveProxy 中沿位移方向额外外扩的倍数 (预测下一帧的运动)
+     */
+    explicit DynamicAABBTree(Ty fat_margin = static_cast<Ty>(0.1), Ty displacement_multiplier = static_cast<Ty>(2))
+        : fat_margin(fat_margin), displacement_multiplier(displacement_multiplier) {}
+
+    /**
+     * @brief 插入一个代理
+     * @param box 真实包围盒
+     * @param user_data 用户数据, 通常为场景中的物体下标
+     */
+    ProxyId CreateProxy(const aabb_type& box, std::uint64_t user_data = 0)
+    {
+        const ProxyId id = AllocateNode();
+        Node& node = nodes[id];
+        node.box       = Fatten(box);
+        node.user_data = user_data;
+        node.height    = 0;
+        node.moved     = true;
+        InsertLeaf(id);
+        ++proxy_count;
+        return id;
+    }
+
+    /**
+     * @brief 删除代理, 其节点回到节点池
+     */
+    void DestroyProxy(ProxyId id)
+    {
+        assert(IsLeaf(id));
+        RemoveLeaf(id);
+        FreeNode(id);
+        --proxy_count;
+    }
+
+    /**
+     * @brief 更新代理的包围盒
+     * @param box 新的真实包围盒
+     * @param displacement 本帧位移, 胖盒沿该方向额外外扩 displacement * displacement_multiplier
+     * @return 代理被重新插入时返回 true; 新盒子仍在胖盒内 (且胖盒没有大得过分) 时什么都不做, 返回 false
+     */
+    bool MoveProxy(ProxyId id, const aabb_type& box, const vector_type& displacement = vector_type{})
+    {
+        assert(IsLeaf(id));
+        const aabb_type& fat = nodes[id].box;
+        if (Contains(fat, box)) {
+            // 高速运动之后胖盒可能远大于物体, 此时也重新插入以免查询结果过于保守
+            aabb_type huge = box;
+            for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+                huge.min[axis] -= 4 * fat_margin;
+                huge.max[axis] += 4 * fat_margin;
+            }
+            if (Contains(huge, fat)) {
+                return false;
+            }
+        }
+
+        RemoveLeaf(id);
+
+        aabb_type fattened = Fatten(box);
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            const Ty d = displacement_multiplier * displacement[axis];
+            if (d < Ty{}) {
+                fattened.min[axis] += d;
+            } else {
+                fattened.max[axis] += d;
+            }
+        }
+        nodes[id].box   = fattened;
+        nodes[id].moved = true;
+
+        InsertLeaf(id);
+        return true;
+    }
+
+    /**
+     * @brief 区域查询: 对每个胖盒与 box 相交的代理调用 fn(ProxyId)
+     * @note fn 返回 bool 时, 返回 false 提前结束查询
+     */
+    template <typename Fn>
+    void Query(const aabb_type& box, Fn&& fn) const
+    {
+        if (root == NullNode) {
+            return;
+        }
+        TraversalStack<ProxyId> stack;
+        stack.Push(root);
+        while (!stack.Empty()) {
+            const ProxyId index = stack.Pop();
+            const Node& node = nodes[index];
+            if (!Overlap(node.box, box)) {
+                continue;
+            }
+            if (node.IsLeaf()) {
+                if (!Invoke(fn, index)) {
+                    return;
+                }
+            } else {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    /**
+     * @brief 树内所有胖盒相交的代理对, 对每一对调用一次 fn(ProxyId a, ProxyId b), a < b
+     * @note 自碰撞的同步下降: 每个内部节点只比较其两棵子树, 不会重复报告同一对
+     */
+    template <typename Fn>
+    void QueryPairs(Fn&& fn) const
+    {
+        if (root == NullNode) {
+            return;
+        }
+        PairStack stack;
+        stack.Push({ root, root });
+        while (!stack.Empty()) {
+            const auto [a, b] = stack.Pop();
+            const Node& node_a = nodes[a];
+            if (a == b) {
+                if (!node_a.IsLeaf()) {
+                    stack.Push({ node_a.child1, node_a.child1 });
+                    stack.Push({ node_a.child2, node_a.child2 });
+                    stack.Push({ node_a.child1, node_a.child2 });
+                }
+                continue;
+            }
+            const Node& node_b = nodes[b];
+            if (!Overlap(node_a.box, node_b.box)) {
+                continue;
+            }
+            if (!PushChildren(stack, *this, a, *this, b)) {
+                fn(std::min(a, b), std::max(a, b));
+            }
+        }
+    }
+
+    /**
+     * @brief 与另一棵树的重叠对, 对每一对调用 fn(本树的 ProxyId, other 的 ProxyId)
+     * @note 典型用法是动态物体树对静态物体树: 静态树不必每帧参与更新
+     */
+    template <typename Fn>
+    void QueryPairs(const DynamicAABBTree& other, Fn&& fn) const
+    {
+        if (root == NullNode || other.root == NullNode) {
+            return;
+        }
+        PairStack stack;
+        stack.Push({ root, other.root });
+        while (!stack.Empty()) {
+            const auto [a, b] = stack.Pop();
+            if (!Overlap(nodes[a].box, other.nodes[b].box)) {
+                continue;
+            }
+            if (!PushChildren(stack, *this, a, other, b)) {
+                fn(a, b);
+            }
+        }
+    }
+
+    /**
+     * @brief 树内重叠对, 以代理的 user_data 作为 HitInfo 的下标 (idx1 < idx2)
+     */
+    [[nodiscard]] std::vector<HitInfo> ComputePairs() const
+    {
+        std::vector<HitInfo> hits;
+        QueryPairs([&](ProxyId a, ProxyId b) {
+            const std::uint64_t ua = nodes[a].user_data;
+            const std::uint64_t ub = nodes[b].user_data;
+            hits.push_back(HitInfo{ std::min(ua, ub), std::max(ua, ub) });
+        });
+        return hits;
+    }
+
+    /**
+     * @brief 删除所有代理, 保留节点池容量
+     */
+    void Clear() noexcept
+    {
+        nodes.clear();
+        root        = NullNode;
+        free_list   = NullNode;
+        proxy_count = 0;
+    }
+
+    void Reserve(std::size_t proxy_capacity) { nodes.reserve(proxy_capacity * 2); }
+
+    [[nodiscard]] const aabb_type& GetFatAABB(ProxyId id) const { return nodes[id].box; }
+    [[nodiscard]] std::uint64_t GetUserData(ProxyId id) const { return nodes[id].user_data; }
+
+    /**
+     * @brief 代理自上次 ClearMoved 之后是否被 (重新) 插入过, 可用于只为移动过的代理查询新重叠对
+     */
+    [[nodiscard]] bool WasMoved(ProxyId id) const { return nodes[id].moved; }
+    void ClearMoved(ProxyId id) { nodes[id].moved = false; }
+
+    [[nodiscard]] std::size_t ProxyCount() const noexcept { return proxy_count; }
+    [[nodiscard]] int Height() const noexcept { return root == NullNode ? 0 : nodes[root].height; }
+
+    /**
+     * @brief 所有内部节点的表面积之和与根表面积之比, 越小说明树质量越好 (SAH 代价)
+     */
+    [[nodiscard]] double AreaRatio() const
+    {
+        if (root == NullNode) {
+            return 0.0;
+        }
+        const double root_area = static_cast<double>(SurfaceArea(nodes[root].box));
+        if (root_area <= 0.0) {
+            return 0.0;
+        }
+        double total = 0.0;
+        ForEachNode(root, [&](ProxyId index) {
+            if (!nodes[index].IsLeaf()) total += static_cast<double>(SurfaceArea(nodes[index].box));
+        });
+        return total / root_area;
+    }
+
+    /**
+     * @brief 检查父子链接, 高度与包围盒是否一致 (调试用)
+     */
+    [[nodiscard]] bool Validate() const
+    {
+        if (root == NullNode) {
+            return proxy_count == 0;
+        }
+        if (nodes[root].parent != NullNode) {
+            return false;
+        }
+        bool valid = true;
+        std::size_t leaves = 0;
+        ForEachNode(root, [&](ProxyId index) {
+            const Node& node = nodes[index];
+            if (node.IsLeaf()) {
+                valid = valid && node.height == 0 && node.child2 == NullNode;
+                ++leaves;
+                return;
+            }
+            const Node& c1 = nodes[node.child1];
+            const Node& c2 = nodes[node.child2];
+            valid = valid && c1.parent == index && c2.parent == index;
+            valid = valid && node.height == 1 + std::max(c1.height, c2.height);
+            valid = valid && SameBox(node.box, Union(c1.box, c2.box));
+        });
+        return valid && leaves == proxy_count;
+    }
+
+private:
+    struct Node {
+        aabb_type     box;                  // 叶子为胖盒, 内部节点为两个子节点的并
+        std::uint64_t user_data = 0;
+        ProxyId       parent    = NullNode; // 空闲节点中复用为空闲链表的 next
+        ProxyId       child1    = NullNode;
+        ProxyId       child2    = NullNode;
+        std::int32_t  height    = -1;       // 叶子为 0, 空闲节点为 -1
+        bool          moved     = false;
+
+        [[nodiscard]] bool IsLeaf() const noexcept { return child1 == NullNode; }
+    };
+
+    std::vector<Node> nodes;
+    ProxyId           root        = NullNode;
+    ProxyId           free_list   = NullNode;
+    std::size_t       proxy_count = 0;
+    Ty                fat_margin;
+    Ty                displacement_multiplier;
+
+    /**
+     * @brief 查询用的遍历栈: 前 InlineCount 项放在栈上, 超出部分才分配
+     * @note 每次查询各用一个局部栈, 因此 const 查询可以并发, fn 中也可以再次查询同一棵树
+     */
+    template <typename T>
+    class TraversalStack
+    {
+    public:
+        void Push(const T& item)
+        {
+            if (size < InlineCount) {
+                inline_items[size] = item;
+            } else {
+                overflow.push_back(item);
+            }
+            ++size;
+        }
+
+        T Pop()
+        {
+            --size;
+            if (size < InlineCount) {
+                return inline_items[size];
+            }
+            T item = overflow.back();
+            overflow.pop_back();
+            return item;
+        }
+
+        [[nodiscard]] bool Empty() const noexcept { return size == 0; }
+
+    private:
+        static constexpr std::size_t InlineCount = 64;
+
+        std::array<T, InlineCount> inline_items;
+        std::vector<T>             overflow;
+        std::size_t                size = 0;
+    };
+
+    using PairStack = TraversalStack<std::pair<ProxyId, ProxyId>>;
+
+    // ======================== 包围盒运算 ========================
+
+    static aabb_type Union(const aabb_type& a, const aabb_type& b) noexcept
+    {
+        aabb_type result;
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            result.min[axis] = std::min(a.min[axis], b.min[axis]);
+            result.max[axis] = std::max(a.max[axis], b.max[axis]);
+        }
+        return result;
+    }
+
+    // 表面积 (的一半): 三维及以上为两两棱长乘积之和, 二维及以下退化为半周长 / 长度
+    static Ty SurfaceArea(const aabb_type& box) noexcept
+    {
+        Ty area{};
+        if constexpr (Dimensions <= 2) {
+            for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+                area += box.max[axis] - box.min[axis];
+            }
+        } else {
+            for (std::size_t i = 0; i < Dimensions; ++i) {
+                for (std::size_t j = i + 1; j < Dimensions; ++j) {
+                    area += (box.max[i] - box.min[i]) * (box.max[j] - box.min[j]);
+                }
+            }
+        }
+        return area;
+    }
+
+    static bool Overlap(const aabb_type& a, const aabb_type& b) noexcept
+    {
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            if (a.max[axis] < b.min[axis] || b.max[axis] < a.min[axis]) return false;
+        }
+        return true;
+    }
+
+    static bool Contains(const aabb_type& outer, const aabb_type& inner) noexcept
+    {
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            if (inner.min[axis] < outer.min[axis] || outer.max[axis] < inner.max[axis]) return false;
+        }
+        return true;
+    }
+
+    static bool SameBox(const aabb_type& a, const aabb_type& b) noexcept
+    {
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            if (a.min[axis] != b.min[axis] || a.max[axis] != b.max[axis]) return false;
+        }
+        return true;
+    }
+
+    aabb_type Fatten(const aabb_type& box) const noexcept
+    {
+        aabb_type fat = box;
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            fat.min[axis] -= fat_margin;
+            fat.max[axis] += fat_margin;
+        }
+        return fat;
+    }
+
+    template <typename Fn>
+    static bool Invoke(Fn& fn, ProxyId id)
+    {
+        if constexpr (std::is_same_v<std::invoke_result_t<Fn&, ProxyId>, bool>) {
+            return fn(id);
+        } else {
+            fn(id);
+            return true;
+        }
+    }
+
+    // 两棵子树胖盒相交时继续下降: 优先拆分非叶子中较大的一侧; 两侧都是叶子时返回 false
+    static bool PushChildren(PairStack& stack,
+                             const DynamicAABBTree& tree_a, ProxyId a,
+                             const DynamicAABBTree& tree_b, ProxyId b)
+    {
+        const Node& node_a = tree_a.nodes[a];
+        const Node& node_b = tree_b.nodes[b];
+        if (node_a.IsLeaf() && node_b.IsLeaf()) {
+            return false;
+        }
+        if (node_b.IsLeaf() || (!node_a.IsLeaf() && SurfaceArea(node_a.box) >= SurfaceArea(node_b.box))) {
+            stack.Push({ node_a.child1, b });
+            stack.Push({ node_a.child2, b });
+        } else {
+            stack.Push({ a, node_b.child1 });
+            stack.Push({ a, node_b.child2 });
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    void ForEachNode(ProxyId start, Fn&& fn) const
+    {
+        std::vector<ProxyId> stack{ start };
+        while (!stack.empty()) {
+            const ProxyId index = stack.back();
+            stack.pop_back();
+            fn(index);
+            if (!nodes[index].IsLeaf()) {
+                stack.push_back(nodes[index].child1);
+                stack.push_back(nodes[index].child2);
+            }
+        }
+    }
+
+    [[nodiscard]] bool IsLeaf(ProxyId id) const noexcept
+    {
+        return id >= 0 && static_cast<std::size_t>(id) < nodes.size() && nodes[id].height == 0;
+    }
+
+    // ======================== 节点池 ========================
+
+    ProxyId AllocateNode()
+    {
+        ProxyId id;
+        if (free_list != NullNode) {
+            id = free_list;
+            free_list = nodes[id].parent;
+        } else {
+            id = static_cast<ProxyId>(nodes.size());
+            nodes.emplace_back();
+        }
+        Node& node = nodes[id];
+        node.parent = node.child1 = node.child2 = NullNode;
+        node.height = 0;
+        node.moved  = false;
+        return id;
+    }
+
+    void FreeNode(ProxyId id) noexcept
+    {
+        nodes[id].parent = free_list;
+        nodes[id].height = -1;
+        free_list = id;
+    }
+
+    // ======================== 插入 / 删除 / 旋转 ========================
+
+    void InsertLeaf(ProxyId leaf)
+    {
+        if (root == NullNode) {
+            root = leaf;
+            nodes[root].parent = NullNode;
+            return;
+        }
+
+        // SAH 下降: 在当前节点处建新父节点的代价为 2 * area(合并); 下探则还要付出当前节点扩张的代价
+        const aabb_type leaf_box = nodes[leaf].box;
+        ProxyId index = root;
+        while (!nodes[index].IsLeaf()) {
+            const Node& node = nodes[index];
+            const Ty area          = SurfaceArea(node.box);
+            const Ty combined_area = SurfaceArea(Union(node.box, leaf_box));
+            const Ty cost             = 2 * combined_area;
+            const Ty inheritance_cost = 2 * (combined_area - area);
+
+            auto descend_cost = [&](ProxyId child) {
+                const aabb_type& child_box = nodes[child].box;
+                const Ty merged = SurfaceArea(Union(leaf_box, child_box));
+                return nodes[child].IsLeaf() ? merged + inheritance_cost
+                                             : merged - SurfaceArea(child_box) + inheritance_cost;
+            };
+            const Ty cost1 = descend_cost(node.child1);
+            const Ty cost2 = descend_cost(node.child2);
+
+            if (cost < cost1 && cost < cost2) {
+                break;
+            }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        // 以 sibling 与 leaf 为子节点新建父节点
+        const ProxyId sibling    = index;
+        const ProxyId old_parent = nodes[sibling].parent;
+        const ProxyId new_parent = AllocateNode(); // 可能令 nodes 重新分配, 之后不再持有引用
+        nodes[new_parent].parent    = old_parent;
+        nodes[new_parent].user_data = 0;
+        nodes[new_parent].box       = Union(leaf_box, nodes[sibling].box);
+        nodes[new_parent].height    = nodes[sibling].height + 1;
+        nodes[new_parent].child1    = sibling;
+        nodes[new_parent].child2    = leaf;
+        nodes[sibling].parent = new_parent;
+        nodes[leaf].parent    = new_parent;
+
+        if (old_parent == NullNode) {
+            root = new_parent;
+        } else if (nodes[old_parent].child1 == sibling) {
+            nodes[old_parent].child1 = new_parent;
+        } else {
+            nodes[old_parent].child2 = new_parent;
+        }
+
+        Refit(nodes[leaf].parent);
+    }
+
+    void RemoveLeaf(ProxyId leaf)
+    {
+        if (leaf == root) {
+            root = NullNode;
+            return;
+        }
+
+        const ProxyId parent       = nodes[leaf].parent;
+        const ProxyId grand_parent = nodes[parent].parent;
+        const ProxyId sibling      = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        if (grand_parent == NullNode) {
+            root = sibling;
+            nodes[sibling].parent = NullNode;
+            FreeNode(parent);
+            return;
+        }
+
+        // 父节点由兄弟节点顶替
+        if (nodes[grand_parent].child1 == parent) {
+            nodes[grand_parent].child1 = sibling;
+        } else {
+            nodes[grand_parent].child2 = sibling;
+        }
+        nodes[sibling].parent = grand_parent;
+        FreeNode(parent);
+
+        Refit(grand_parent);
+    }
+
+    // 自 index 向根回溯: 更新包围盒与高度, 并在每个祖先处尝试一次旋转
+    void Refit(ProxyId index)
+    {
+        while (index != NullNode) {
+            UpdateFromChildren(index);
+            if (Rotate(index)) {
+                UpdateFromChildren(index);
+            }
+            index = nodes[index].parent;
+        }
+    }
+
+    void UpdateFromChildren(ProxyId index) noexcept
+    {
+        Node& node = nodes[index];
+        const Node& c1 = nodes[node.child1];
+        const Node& c2 = nodes[node.child2];
+        node.height = 1 + std::max(c1.height, c2.height);
+        node.box    = Union(c1.box, c2.box);
+    }
+
+    /**
+     * 按表面积做树旋转: 尝试把 a 的一个子节点 (uncle) 与另一个子节点 (parent) 的某个孩子 (nephew) 互换,
+     * 选使 parent 表面积下降最多的一种; a 覆盖的叶子不变, 因此 a 的包围盒不变
+     *
+     *           a                    a
+     *          / \                  /      *     uncle   parent    =>  nephew  parent
+     *             /   \                 /        *        nephew   other        uncle   other
+     *
+     * 相比按高度差的 AVL 旋转, 这种旋转同时兼顾平衡与空间紧凑性, 查询时访问的节点更少.
+     * @return 发生旋转时返回 true
+     */
+    bool Rotate(ProxyId a)
+    {
+        const ProxyId b = nodes[a].child1;
+        const ProxyId c = nodes[a].child2;
+
+        ProxyId best_uncle  = NullNode;
+        ProxyId best_parent = NullNode;
+        ProxyId best_nephew = NullNode;
+        Ty      best_gain{};
+
+        auto consider = [&](ProxyId uncle, ProxyId parent) {
+            const Node& p = nodes[parent];
+            if (p.IsLeaf()) {
+                return;
+            }
+            const Ty area = SurfaceArea(p.box);
+            const Ty gain1 = area - SurfaceArea(Union(nodes[uncle].box, nodes[p.child2].box)); // uncle <-> child1
+            const Ty gain2 = area - SurfaceArea(Union(nodes[uncle].box, nodes[p.child1].box)); // uncle <-> child2
+            if (gain1 > best_gain) {
+                best_gain = gain1; best_uncle = uncle; best_parent = parent; best_nephew = p.child1;
+            }
+            if (gain2 > best_gain) {
+                best_gain = gain2; best_uncle = uncle; best_parent = parent; best_nephew = p.child2;
+            }
+        };
+        consider(b, c);
+        consider(c, b);
+
+        if (best_uncle == NullNode) {
+            return false;
+        }
+
+        if (nodes[a].child1 == best_uncle) {
+            nodes[a].child1 = best_nephew;
+        } else {
+            nodes[a].child2 = best_nephew;
+        }
+        nodes[best_nephew].parent = a;
+
+        if (nodes[best_parent].child1 == best_nephew) {
+            nodes[best_parent].child1 = best_uncle;
+        } else {
+            nodes[best_parent].child2 = best_uncle;
+        }
+        nodes[best_uncle].parent = best_parent;
+
+        UpdateFromChildren(best_parent);
+        return true;
+    }
+};
+
+} // namespace Runtime::Core
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Runtime::Core::Detail{
+
+/**
+ * 宽相端点排序用的基数排序
+ *
+ * 端点坐标 (浮点或整数) 先映射为保序的无符号整数键, 再做按字节的 LSD 基数排序, 键与 AABB 下标成对移动.
+ * 与比较排序相比, 每趟只有顺序读 + 分桶写, 不依赖分支预测; 所有键某一字节都相同的趟会被跳过.
+ */
+
+// 4 字节及以下的坐标映射到 uint32_t, 8 字节映射到 uint64_t
+template <typename Ty>
+using SortableKeyType = std::conditional_t<sizeof(Ty) <= 4, std::uint32_t, std::uint64_t>;
+
+/**
+ * @brief 把坐标映射为无符号键, 保持 a < b 则 key(a) < key(b)
+ * @note 浮点: 正数翻转符号位, 负数按位取反; 有符号整数: 翻转符号位. NaN 的位置未定义
+ */
+template <typename Ty>
+    requires std::is_arithmetic_v<Ty>
+constexpr SortableKeyType<Ty> ToSortableKey(Ty value) noexcept
+{
+    using Key = SortableKeyType<Ty>;
+    constexpr Key sign_bit = Key{ 1 } << (sizeof(Key) * 8 - 1);
+    if constexpr (std::is_floating_point_v<Ty>) {
+        static_assert(sizeof(Ty) == sizeof(Key), "ToSortableKey: 仅支持 float / double");
+        const Key bits = std::bit_cast<Key>(value);
+        return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+    } else if constexpr (std::is_signed_v<Ty>) {
+        return static_cast<Key>(static_cast<std::make_signed_t<Key>>(value)) ^ sign_bit;
+    } else {
+        return static_cast<Key>(value);
+    }
+}
+
+/**
+ * @brief 端点排序中 AABB 下标为 uint32_t, 盒子数量超出时抛出 std::length_error
+ * @param caller 调用方名称, 用于异常信息
+ */
+inline void CheckSortIndexRange(std::size_t count, const char* caller)
+{
+    if (count > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error(std::string(caller) + ": AABB 数量超过 uint32_t 下标上限");
+    }
+}
+
+/**
+ * @brief 基数排序的临时缓冲, 只增不减, 跨调用复用以避免重复分配
+ */
+template <typename Key>
+struct RadixSortScratch {
+    std::vector<Key>           keys;
+    std::vector<std::uint32_t> values;
+};
+
+/**
+ * @brief 按 keys 升序稳定排序 (keys, values) 对
+ * @param keys 键, 排序后原地有序
+ * @param values 与 keys 等长, 随键移动
+ * @param scratch 临时缓冲
+ */
+template <typename Key>
+void RadixSortPairs(std::span<Key> keys, std::span<std::uint32_t> values, RadixSortScratch<Key>& scratch)
+{
+    constexpr std::size_t passes = sizeof(Key);
+    const std::size_t n = keys.size();
+    if (n <= 1) {
+        return;
+    }
+    // 小数组比较排序更快
+    if (n <= 64) {
+        for (std::size_t i = 1; i < n; ++i) {
+            const Key key = keys[i];
+            const std::uint32_t value = values[i];
+            std::size_t j = i;
+            for (; j > 0 && key < keys[j - 1]; --j) {
+                keys[j]   = keys[j - 1];
+                values[j] = values[j - 1];
+            }
+            keys[j]   = key;
+            values[j] = value;
+        }
+        return;
+    }
+
+    if (scratch.keys.size() < n) {
+        scratch.keys.resize(n);
+        scratch.values.resize(n);
+    }
+
+    // 一次遍历统计所有字节的直方图
+    std::array<std::array<std::uint32_t, 256>, passes> histograms{};
+    for (const Key key : keys) {
+        for (std::size_t pass = 0; pass < passes; ++pass) {
+            ++histograms[pass][(key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    Key*           src_keys   = keys.data();
+    std::uint32_t* src_values = values.data();
+    Key*           dst_keys   = scratch.keys.data();
+    std::uint32_t* dst_values = scratch.values.data();
+
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+        auto& histogram = histograms[pass];
+        const std::size_t shift = pass * 8;
+        if (histogram[(src_keys[0] >> shift) & 0xFF] == n) {
+            continue; // 该字节全部相同
+        }
+
+        std::uint32_t offset = 0;
+        for (std::uint32_t& count : histogram) {
+            const std::uint32_t c = count;
+            count = offset;
+            offset += c;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint32_t position = histogram[(src_keys[i] >> shift) & 0xFF]++;
+            dst_keys[position]   = src_keys[i];
+            dst_values[position] = src_values[i];
+        }
+        std::swap(src_keys, dst_keys);
+        std::swap(src_values, dst_values);
+    }
+
+    if (src_keys != keys.data()) {
+        std::copy_n(src_keys, n, keys.data());
+        std::copy_n(src_values, n, values.data());
+    }
+}
+
+} // namespace Runtime::Core::Detail
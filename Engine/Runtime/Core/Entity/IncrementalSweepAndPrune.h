@@ -0,0 +1,406 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "AABB.h"
+
+namespace Runtime::Core{
+
+/**
+ * @brief 一帧内重叠状态的变化
+ * @note began / ended 中的 HitInfo 为代理 id, idx1 < idx2, 按 (idx1, idx2) 升序
+ */
+struct OverlapDelta {
+    std::vector<HitInfo> began; // 上次 Flush 后开始重叠的对
+    std::vector<HitInfo> ended; // 上次 Flush 后结束重叠的对 (含被移除代理的所有对)
+};
+
+/**
+ * @brief 时间相干的增量 Sweep and Prune 宽相
+ *
+ * SweepAndPrune / SweepAndPrune1D 每次调用都重建端点数组并从头排序; 而场景中的物体每帧通常只移动一点,
+ * 排好序的端点列表与重叠对在帧间几乎不变. 本类跨帧保存:
+ *   - 每个轴一条按值排序的端点列表 (每个代理一个 min 端点, 一个 max 端点)
+ *   - 当前所有重叠对的集合
+ * 代理移动时只对它自己的端点做插入排序 (向相邻位置逐个交换), 交换到另一个代理的端点时按端点类型
+ * 判断这一对在该轴上是开始还是结束相交, 并据此增删重叠对. 每帧的开销与移动距离内跨过的端点数成正比.
+ *
+ * 用法:
+ *   IncrementalSweepAndPrune<float, 3> broadphase;
+ *   auto id = broadphase.Add(box);
+ *   ...
+ *   broadphase.Move(id, new_box);                 // 或每帧 broadphase.Synchronize(aabbs)
+ *   const auto& delta = broadphase.Flush();
+ *   for (const HitInfo& hit : delta.began) { ... } // 开始重叠
+ *   for (const HitInfo& hit : delta.ended) { ... } // 结束重叠
+ *
+ * @note 重叠判定与 AABB::IsOverlap 一致 (边界相接算重叠): 值相等时 min 端点排在 max 端点之前.
+ *       Add 从端点列表末尾插入排序, Remove 需要遍历重叠对集合与端点列表, 二者都是 O(N + P) 的操作,
+ *       适合低频的增删; 对空的宽相调用 Synchronize 会整体排序建表 (O(N log N)).
+ *       被移除代理的 id 在下一次 Flush 之后才会被复用, 保证同一帧内的增量不会混淆两个代理.
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+class IncrementalSweepAndPrune
+{
+public:
+    using ProxyId   = std::uint32_t;
+    using aabb_type = AABB<Ty, Dimensions>;
+
+    static constexpr ProxyId InvalidProxy = std::numeric_limits<ProxyId>::max();
+
+    /**
+     * @brief 插入一个代理, 返回其 id
+     */
+    ProxyId Add(const aabb_type& box)
+    {
+        ProxyId id;
+        if (!free_ids.empty()) {
+            id = free_ids.back();
+            free_ids.pop_back();
+        } else {
+            id = static_cast<ProxyId>(proxies.size());
+            proxies.emplace_back();
+        }
+        Insert(id, box);
+        return id;
+    }
+
+    /**
+     * @brief 移除代理, 它参与的所有重叠对会出现在下一次 Flush 的 ended 中
+     */
+    void Remove(ProxyId id)
+    {
+        assert(IsValid(id));
+        std::erase_if(pairs, [&](std::uint64_t key) {
+            if (static_cast<ProxyId>(key >> 32) != id && static_cast<ProxyId>(key) != id) {
+                return false;
+            }
+            changed.try_emplace(key, true);
+            return true;
+        });
+
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            auto& list = endpoints[axis];
+            std::erase_if(list, [&](const Endpoint& ep) { return ep.Proxy() == id; });
+            for (std::uint32_t i = 0; i < list.size(); ++i) {
+                SetIndex(axis, list[i], i);
+            }
+        }
+
+        proxies[id].alive = false;
+        --alive_count;
+        pending_free_ids.push_back(id);
+    }
+
+    /**
+     * @brief 更新代理的包围盒, 用插入排序把它的端点移动到新位置
+     */
+    void Move(ProxyId id, const aabb_type& box)
+    {
+        assert(IsValid(id));
+        Proxy& proxy = proxies[id];
+        const aabb_type old_box = proxy.box;
+        proxy.box = box;
+
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            endpoints[axis][proxy.min_index[axis]].value = box.min[axis];
+            endpoints[axis][proxy.max_index[axis]].value = box.max[axis];
+
+            // 先扩张 (可能产生新重叠), 再收缩 (可能结束重叠)
+            if (box.min[axis] < old_box.min[axis]) SortDown(axis, proxy.min_index[axis]);
+            if (box.max[axis] > old_box.max[axis]) SortUp(axis, proxy.max_index[axis]);
+            if (box.min[axis] > old_box.min[axis]) SortUp(axis, proxy.min_index[axis]);
+            if (box.max[axis] < old_box.max[axis]) SortDown(axis, proxy.max_index[axis]);
+        }
+    }
+
+    /**
+     * @brief 以 aabbs 的下标作为代理 id, 同步整个场景
+     * @note 只能与 Synchronize 单独使用 (不要混用 Add / Remove): 新增的下标插入, 超出的下标移除,
+     *       其余包围盒有变化的代理执行 Move
+     */
+    void Synchronize(const std::vector<aabb_type>& aabbs)
+    {
+        const std::size_t count = aabbs.size();
+        if (alive_count == 0 && count != 0) {
+            Build(aabbs);
+            return;
+        }
+        for (std::size_t id = count; id < proxies.size(); ++id) {
+            if (proxies[id].alive) Remove(static_cast<ProxyId>(id));
+        }
+        for (std::size_t id = 0; id < count; ++id) {
+            if (id >= proxies.size()) {
+                proxies.emplace_back();
+            }
+            if (!proxies[id].alive) {
+                // 该 id 可能在空闲列表或本帧的待回收列表中, 两处都要移除, 否则 Flush 后会被再次分配
+                std::erase(free_ids, static_cast<ProxyId>(id));
+                std::erase(pending_free_ids, static_cast<ProxyId>(id));
+                Insert(static_cast<ProxyId>(id), aabbs[id]);
+            } else if (!SameBox(proxies[id].box, aabbs[id])) {
+                Move(static_cast<ProxyId>(id), aabbs[id]);
+            }
+        }
+    }
+
+    /**
+     * @brief 汇总自上次 Flush 以来的重叠变化; 同一帧内先开始又结束 (或反之) 的对互相抵消
+     * @return 内部缓冲的引用, 在下一次 Flush 前有效
+     */
+    const OverlapDelta& Flush()
+    {
+        delta.began.clear();
+        delta.ended.clear();
+        for (const auto& [key, was_overlapping] : changed) {
+            const bool is_overlapping = pairs.contains(key);
+            if (is_overlapping != was_overlapping) {
+                (is_overlapping ? delta.began : delta.ended).push_back(HitInfo{ key >> 32, key & 0xFFFFFFFFu });
+            }
+        }
+        changed.clear();
+
+        auto less = [](const HitInfo& a, const HitInfo& b) {
+            return a.idx1 != b.idx1 ? a.idx1 < b.idx1 : a.idx2 < b.idx2;
+        };
+        std::sort(delta.began.begin(), delta.began.end(), less);
+        std::sort(delta.ended.begin(), delta.ended.end(), less);
+
+        free_ids.insert(free_ids.end(), pending_free_ids.begin(), pending_free_ids.end());
+        pending_free_ids.clear();
+        return delta;
+    }
+
+    [[nodiscard]] bool IsValid(ProxyId id) const noexcept { return id < proxies.size() && proxies[id].alive; }
+
+    [[nodiscard]] bool IsOverlapping(ProxyId a, ProxyId b) const { return pairs.contains(PairKey(a, b)); }
+
+    [[nodiscard]] std::size_t ProxyCount() const noexcept { return alive_count; }
+
+    [[nodiscard]] std::size_t PairCount() const noexcept { return pairs.size(); }
+
+    [[nodiscard]] const aabb_type& GetBox(ProxyId id) const { return proxies[id].box; }
+
+    /**
+     * @brief 对当前每个重叠对调用 fn(HitInfo), 顺序未指定
+     */
+    template <typename Fn>
+    void ForEachPair(Fn&& fn) const
+    {
+        for (const std::uint64_t key : pairs) {
+            fn(HitInfo{ key >> 32, key & 0xFFFFFFFFu });
+        }
+    }
+
+private:
+    struct Endpoint {
+        Ty            value;
+        std::uint32_t data; // proxy << 1 | is_max
+
+        [[nodiscard]] ProxyId Proxy() const noexcept { return data >> 1; }
+        [[nodiscard]] bool IsMax() const noexcept { return data & 1u; }
+
+        // 值相等时 min 排在 max 之前, 使相接的盒子在端点顺序上也算相交
+        [[nodiscard]] bool Before(const Endpoint& other) const noexcept
+        {
+            return value < other.value || (!(other.value < value) && !IsMax() && other.IsMax());
+        }
+    };
+
+    struct Proxy {
+        aabb_type                              box;
+        std::array<std::uint32_t, Dimensions> min_index{};
+        std::array<std::uint32_t, Dimensions> max_index{};
+        bool                                   alive = false;
+    };
+
+    std::array<std::vector<Endpoint>, Dimensions> endpoints;
+    std::vector<Proxy>                            proxies;
+    std::vector<ProxyId>                          free_ids;
+    std::vector<ProxyId>                          pending_free_ids; // 本帧移除, Flush 后才可复用
+    std::size_t                                   alive_count = 0;
+
+    std::unordered_set<std::uint64_t>       pairs;
+    std::unordered_map<std::uint64_t, bool> changed; // 本帧状态变化过的对 -> 上次 Flush 时是否重叠
+    OverlapDelta                            delta;
+
+    static std::uint64_t PairKey(ProxyId a, ProxyId b) noexcept
+    {
+        if (a > b) std::swap(a, b);
+        return (static_cast<std::uint64_t>(a) << 32) | b;
+    }
+
+    static bool SameBox(const aabb_type& a, const aabb_type& b) noexcept
+    {
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            if (a.min[axis] != b.min[axis] || a.max[axis] != b.max[axis]) return false;
+        }
+        return true;
+    }
+
+    // 以当前包围盒做全维测试 (移动中的代理已写入新值, 其余代理不动, 因此结果就是最终状态)
+    bool TestOverlap(ProxyId a, ProxyId b) const noexcept
+    {
+        const aabb_type& box_a = proxies[a].box;
+        const aabb_type& box_b = proxies[b].box;
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            if (box_a.max[axis] < box_b.min[axis] || box_b.max[axis] < box_a.min[axis]) return false;
+        }
+        return true;
+    }
+
+    void AddPair(ProxyId a, ProxyId b)
+    {
+        const std::uint64_t key = PairKey(a, b);
+        if (pairs.insert(key).second) {
+            changed.try_emplace(key, false);
+        }
+    }
+
+    void RemovePair(ProxyId a, ProxyId b)
+    {
+        const std::uint64_t key = PairKey(a, b);
+        if (pairs.erase(key) != 0) {
+            changed.try_emplace(key, true);
+        }
+    }
+
+    void SetIndex(std::size_t axis, const Endpoint& ep, std::uint32_t index) noexcept
+    {
+        Proxy& proxy = proxies[ep.Proxy()];
+        (ep.IsMax() ? proxy.max_index : proxy.min_index)[axis] = index;
+    }
+
+    void Insert(ProxyId id, const aabb_type& box)
+    {
+        Proxy& proxy = proxies[id];
+        proxy.box   = box;
+        proxy.alive = true;
+        ++alive_count;
+
+        // 两个端点追加到末尾后依次向下插入: min 越过他人的 max 时按最终包围盒判定是否重叠,
+        // 随后 max 越过他人的 min 时撤销该轴上并不相交的对; min 不会越过自身仍在末尾的 max
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            auto& list = endpoints[axis];
+            const auto min_index = static_cast<std::uint32_t>(list.size());
+            list.push_back(Endpoint{ box.min[axis], id << 1 });
+            list.push_back(Endpoint{ box.max[axis], (id << 1) | 1u });
+            SortDown(axis, min_index);
+            SortDown(axis, min_index + 1);
+        }
+    }
+
+    // 空宽相的整体建表: 各轴端点一次排序, 再沿 0 轴扫描一遍得到初始重叠对
+    void Build(const std::vector<aabb_type>& aabbs)
+    {
+        const auto count = static_cast<ProxyId>(aabbs.size());
+        proxies.resize(std::max<std::size_t>(proxies.size(), count));
+        // 下标 < count 的 id 全部被占用, 其余 id 都空闲; 本帧移除的 id 也不再等 Flush, 以免重复进入 free_ids
+        free_ids.clear();
+        pending_free_ids.clear();
+        for (ProxyId id = 0; id < count; ++id) {
+            proxies[id].box   = aabbs[id];
+            proxies[id].alive = true;
+        }
+        for (std::size_t id = proxies.size(); id-- > count;) {
+            proxies[id].alive = false;
+            free_ids.push_back(static_cast<ProxyId>(id));
+        }
+        alive_count = count;
+
+        for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+            auto& list = endpoints[axis];
+            list.clear();
+            list.reserve(2 * static_cast<std::size_t>(count));
+            for (ProxyId id = 0; id < count; ++id) {
+                list.push_back(Endpoint{ aabbs[id].min[axis], id << 1 });
+                list.push_back(Endpoint{ aabbs[id].max[axis], (id << 1) | 1u });
+            }
+            std::sort(list.begin(), list.end(), [](const Endpoint& a, const Endpoint& b) { return a.Before(b); });
+            for (std::uint32_t i = 0; i < list.size(); ++i) {
+                SetIndex(axis, list[i], i);
+            }
+        }
+
+        // active 中保存 0 轴上已打开区间的代理, slot 记录其在 active 中的位置以便 O(1) 移除
+        std::vector<ProxyId>       active;
+        std::vector<std::uint32_t> slot(count);
+        for (const Endpoint& ep : endpoints[0]) {
+            const ProxyId id = ep.Proxy();
+            if (!ep.IsMax()) {
+                for (const ProxyId other : active) {
+                    if (TestOverlap(id, other)) AddPair(id, other);
+                }
+                slot[id] = static_cast<std::uint32_t>(active.size());
+                active.push_back(id);
+            } else {
+                const ProxyId last = active.back();
+                active[slot[id]] = last;
+                slot[last] = slot[id];
+                active.pop_back();
+            }
+        }
+    }
+
+    // 端点向低索引方向插入排序
+    void SortDown(std::size_t axis, std::uint32_t index)
+    {
+        auto& list = endpoints[axis];
+        const Endpoint moving = list[index];
+        const ProxyId  self   = moving.Proxy();
+        while (index > 0 && moving.Before(list[index - 1])) {
+            const Endpoint& prev = list[index - 1];
+            const ProxyId other = prev.Proxy();
+            if (other != self) {
+                if (!moving.IsMax() && prev.IsMax()) {
+                    // min 向左越过他人的 max: 该轴开始相交
+                    if (TestOverlap(self, other)) AddPair(self, other);
+                } else if (moving.IsMax() && !prev.IsMax()) {
+                    // max 向左越过他人的 min: 该轴不再相交
+                    RemovePair(self, other);
+                }
+            }
+            list[index] = prev;
+            SetIndex(axis, prev, index);
+            --index;
+        }
+        list[index] = moving;
+        SetIndex(axis, moving, index);
+    }
+
+    // 端点向高索引方向插入排序
+    void SortUp(std::size_t axis, std::uint32_t index)
+    {
+        auto& list = endpoints[axis];
+        const Endpoint moving = list[index];
+        const ProxyId  self   = moving.Proxy();
+        while (index + 1 < list.size() && list[index + 1].Before(moving)) {
+            const Endpoint& next = list[index + 1];
+            const ProxyId other = next.Proxy();
+            if (other != self) {
+                if (moving.IsMax() && !next.IsMax()) {
+                    // max 向右越过他人的 min: 该轴开始相交
+                    if (TestOverlap(self, other)) AddPair(self, other);
+                } else if (!moving.IsMax() && next.IsMax()) {
+                    // min 向右越过他人的 max: 该轴不再相交
+                    RemovePair(self, other);
+                }
+            }
+            list[index] = next;
+            SetIndex(axis, next, index);
+            ++index;
+        }
+        list[index] = moving;
+        SetIndex(axis, moving, index);
+    }
+};
+
+} // namespace Runtime::Core
@@ -0,0 +1,361 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "AABB.h"
+#include "EndpointRadixSort.h"
+#include "ThreadPool/ThreadPool.h"
+
+namespace Runtime::Core{
+
+namespace Detail {
+
+    /**
+     * @brief 在线程池上做 LSD 基数排序: 每趟各块并行统计直方图 -> 串行求各块各桶的起始位置 -> 各块并行分桶写出
+     * @note 块内按顺序写出, 块按下标顺序占据每个桶的连续区间, 因此排序是稳定的
+     */
+    template <typename Key>
+    void ParallelRadixSortPairs(ThreadPool& pool, std::span<Key> keys, std::span<std::uint32_t> values,
+                                RadixSortScratch<Key>& scratch)
+    {
+        constexpr std::size_t passes          = sizeof(Key);
+        constexpr std::size_t min_block_size  = 1 << 14;
+        const std::size_t n = keys.size();
+        const std::size_t blocks = std::min(pool.GetThreadCount() + 1, n / min_block_size);
+        if (blocks <= 1) {
+            RadixSortPairs(keys, values, scratch);
+            return;
+        }
+
+        if (scratch.keys.size() < n) {
+            scratch.keys.resize(n);
+            scratch.values.resize(n);
+        }
+        const std::size_t block_size = (n + blocks - 1) / blocks;
+        std::vector<std::array<std::size_t, 256>> histograms(blocks);
+
+        Key*           src_keys   = keys.data();
+        std::uint32_t* src_values = values.data();
+        Key*           dst_keys   = scratch.keys.data();
+        std::uint32_t* dst_values = scratch.values.data();
+
+        for (std::size_t pass = 0; pass < passes; ++pass) {
+            const std::size_t shift = pass * 8;
+
+            pool.ParallelFor(blocks, 1, [&](std::size_t block_begin, std::size_t block_end) {
+                for (std::size_t block = block_begin; block < block_end; ++block) {
+                    auto& histogram = histograms[block];
+                    histogram.fill(0);
+                    const std::size_t end = std::min(n, (block + 1) * block_size);
+                    for (std::size_t i = block * block_size; i < end; ++i) {
+                        ++histogram[(src_keys[i] >> shift) & 0xFF];
+                    }
+                }
+            });
+
+            // 桶优先, 块其次: 得到每个块在每个桶中的写出起点
+            std::size_t offset = 0;
+            bool trivial = false;
+            for (std::size_t digit = 0; digit < 256 && !trivial; ++digit) {
+                std::size_t digit_total = 0;
+                for (std::size_t block = 0; block < blocks; ++block) {
+                    const std::size_t count = histograms[block][digit];
+                    histograms[block][digit] = offset;
+                    offset += count;
+                    digit_total += count;
+                }
+                trivial = digit_total == n;
+            }
+            if (trivial) {
+                continue; // 该字节全部相同
+            }
+
+            pool.ParallelFor(blocks, 1, [&](std::size_t block_begin, std::size_t block_end) {
+                for (std::size_t block = block_begin; block < block_end; ++block) {
+                    auto& cursor = histograms[block];
+                    const std::size_t end = std::min(n, (block + 1) * block_size);
+                    for (std::size_t i = block * block_size; i < end; ++i) {
+                        const std::size_t position = cursor[(src_keys[i] >> shift) & 0xFF]++;
+                        dst_keys[position]   = src_keys[i];
+                        dst_values[position] = src_values[i];
+                    }
+                }
+            });
+            std::swap(src_keys, dst_keys);
+            std::swap(src_values, dst_values);
+        }
+
+        if (src_keys != keys.data()) {
+            pool.ParallelFor(n, block_size, [&](std::size_t begin, std::size_t end) {
+                std::copy(src_keys + begin, src_keys + end, keys.data() + begin);
+                std::copy(src_values + begin, src_values + end, values.data() + begin);
+            });
+        }
+    }
+
+} // namespace Detail
+
+/**
+ * @brief 多线程 Sweep and Prune, 分组规则与 SweepAndPrune 相同, 结果与 BruteForcePairs 一致 (idx1 < idx2)
+ *
+ * SweepAndPrune 中同一轴上的各个可疑组互不相关, 这里把它们分发到线程池:
+ *   1. 把 AABB 的各轴 min / max 并行拷贝成 SoA 数组
+ *   2. 对每个测量轴: 大组 (整个场景通常就是一个大组) 用并行基数排序, 并行求前缀 max 后切分;
+ *      其余小组按组分块, 每块在一个线程上串行排序与切分
+ *      组只是下标数组上的一段区间 (排序在段内原地进行), 切分只产生新的区间, 不拷贝下标
+ *   3. 最终每个组已按最后一个测量轴的 min 有序, 组内对每个盒子向后扫描到 min 超过其 max 为止,
+ *      做全维测试; 扫描按位置均匀分块并行
+ *   4. 每块的结果写入各自的缓冲, 再按块序求前缀和并行拷贝到输出, 全程无锁, 结果顺序与线程数无关
+ *
+ * @param aabbs 场景中所有 AABB
+ * @param check_order 测量轴的顺序, 同 SweepAndPrune
+ * @param pool 线程池, 调用线程也参与计算
+ * @throw std::length_error AABB 数量超出 uint32_t 下标范围
+ */
+template <typename Ty, std::size_t Dimensions>
+    requires std::is_arithmetic_v<Ty>
+static std::vector<HitInfo> ParallelSweepAndPrune(const std::vector<AABB<Ty, Dimensions>>& aabbs,
+                                                  std::array<uint8_t, Dimensions> check_order,
+                                                  ThreadPool& pool = GThreadPool())
+{
+    using Key       = Detail::SortableKeyType<Ty>;
+    using IndexType = std::uint32_t;
+
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+        [[nodiscard]] std::size_t Size() const noexcept { return end - begin; }
+    };
+
+    constexpr std::size_t large_group_size = 1 << 16; // 不小于该大小的组在组内并行
+
+    std::vector<HitInfo> hits;
+    const std::size_t size = aabbs.size();
+    if (size <= 1) {
+        return hits;
+    }
+    Detail::CheckSortIndexRange(size, "ParallelSweepAndPrune");
+
+    const std::size_t workers = pool.GetThreadCount() + 1;
+    const std::size_t grain   = std::max<std::size_t>(size / (workers * 8), 1024);
+
+    // 1. SoA 拷贝 + 初始下标
+    std::array<std::vector<Ty>, Dimensions> mins;
+    std::array<std::vector<Ty>, Dimensions> maxs;
+    for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+        mins[axis].resize(size);
+        maxs[axis].resize(size);
+    }
+    std::vector<IndexType> order(size);
+    std::vector<Key>       keys(size);
+    pool.ParallelFor(size, grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::size_t axis = 0; axis < Dimensions; ++axis) {
+                mins[axis][i] = aabbs[i].min[axis];
+                maxs[axis][i] = aabbs[i].max[axis];
+            }
+            order[i] = static_cast<IndexType>(i);
+        }
+    });
+
+    std::vector<std::uint8_t> axes;
+    for (const auto axis_raw : check_order) {
+        if (static_cast<std::size_t>(axis_raw) < Dimensions) {
+            axes.push_back(axis_raw);
+        }
+    }
+    if (axes.empty()) {
+        axes.push_back(0); // 至少需要一个有序轴来做最终扫描
+    }
+
+    // 区间 [begin, end) 已按 axis 的 min 排序, 把轴向连通段的起点追加到 starts
+    auto find_segment_starts = [&](std::size_t axis, std::size_t begin, std::size_t end, Ty running_max,
+                                   std::vector<std::size_t>& starts) {
+        const Ty* lo = mins[axis].data();
+        const Ty* hi = maxs[axis].data();
+        for (std::size_t p = begin; p < end; ++p) {
+            const IndexType idx = order[p];
+            if (lo[idx] > running_max) {
+                starts.push_back(p);
+                running_max = hi[idx];
+            } else if (hi[idx] > running_max) {
+                running_max = hi[idx];
+            }
+        }
+    };
+
+    // 相邻起点之间是一个组, 只保留两个以上元素的组
+    auto append_groups = [](const std::vector<std::size_t>& starts, std::size_t end, std::vector<Range>& out) {
+        for (std::size_t k = 0; k < starts.size(); ++k) {
+            const std::size_t group_end = k + 1 < starts.size() ? starts[k + 1] : end;
+            if (group_end - starts[k] > 1) {
+                out.push_back(Range{ starts[k], group_end });
+            }
+        }
+    };
+
+    auto sort_range = [&](std::size_t axis, const Range& range, Detail::RadixSortScratch<Key>& scratch) {
+        const Ty* lo = mins[axis].data();
+        for (std::size_t p = range.begin; p < range.end; ++p) {
+            keys[p] = Detail::ToSortableKey(lo[order[p]]);
+        }
+        Detail::RadixSortPairs(std::span<Key>(keys.data() + range.begin, range.Size()),
+                               std::span<IndexType>(order.data() + range.begin, range.Size()), scratch);
+    };
+
+    std::vector<Range> groups{ Range{ 0, size } };
+    std::vector<Range> next_groups;
+    Detail::RadixSortScratch<Key> shared_scratch;
+
+    // 2. 逐轴细分
+    for (const std::size_t axis : axes) {
+        next_groups.clear();
+
+        std::vector<Range> small_groups;
+        for (const Range& group : groups) {
+            if (group.Size() < large_group_size) {
+                small_groups.push_back(group);
+                continue;
+            }
+
+            // 大组: 组内并行生成键 -> 并行基数排序 -> 分块求前缀 max 后并行找切分点
+            pool.ParallelFor(group.Size(), grain, [&](std::size_t begin, std::size_t end) {
+                const Ty* lo = mins[axis].data();
+                for (std::size_t p = group.begin + begin; p < group.begin + end; ++p) {
+                    keys[p] = Detail::ToSortableKey(lo[order[p]]);
+                }
+            });
+            Detail::ParallelRadixSortPairs(pool,
+                                           std::span<Key>(keys.data() + group.begin, group.Size()),
+                                           std::span<IndexType>(order.data() + group.begin, group.Size()),
+                                           shared_scratch);
+
+            const std::size_t blocks     = std::min(workers, (group.Size() + grain - 1) / grain);
+            const std::size_t block_size = (group.Size() + blocks - 1) / blocks;
+            std::vector<Ty> block_max(blocks);
+            pool.ParallelFor(blocks, 1, [&](std::size_t block_begin, std::size_t block_end) {
+                const Ty* hi = maxs[axis].data();
+                for (std::size_t block = block_begin; block < block_end; ++block) {
+                    const std::size_t begin = group.begin + block * block_size;
+                    const std::size_t end   = std::min(group.end, begin + block_size);
+                    Ty value = hi[order[begin]];
+                    for (std::size_t p = begin + 1; p < end; ++p) {
+                        value = std::max(value, hi[order[p]]);
+                    }
+                    block_max[block] = value;
+                }
+            });
+
+            std::vector<std::vector<std::size_t>> block_starts(blocks);
+            pool.ParallelFor(blocks, 1, [&](std::size_t block_begin, std::size_t block_end) {
+                for (std::size_t block = block_begin; block < block_end; ++block) {
+                    const std::size_t begin = group.begin + block * block_size;
+                    const std::size_t end   = std::min(group.end, begin + block_size);
+                    if (block == 0) {
+                        // 组的第一个元素总是一个段的起点
+                        block_starts[0].push_back(begin);
+                        find_segment_starts(axis, begin + 1, end, maxs[axis][order[begin]], block_starts[0]);
+                    } else {
+                        const Ty running_max = *std::max_element(block_max.begin(), block_max.begin() + block);
+                        find_segment_starts(axis, begin, end, running_max, block_starts[block]);
+                    }
+                }
+            });
+
+            std::vector<std::size_t> starts;
+            for (const auto& block : block_starts) {
+                starts.insert(starts.end(), block.begin(), block.end());
+            }
+            append_groups(starts, group.end, next_groups);
+        }
+
+        // 小组: 按组分块, 每块在一个线程内串行排序切分, 结果写入各自的缓冲后按块序合并
+        if (!small_groups.empty()) {
+            const std::size_t group_grain  = std::max<std::size_t>(small_groups.size() / (workers * 4), 1);
+            const std::size_t group_chunks = (small_groups.size() + group_grain - 1) / group_grain;
+            std::vector<std::vector<Range>> chunk_groups(group_chunks);
+            pool.ParallelFor(small_groups.size(), group_grain, [&](std::size_t begin, std::size_t end) {
+                Detail::RadixSortScratch<Key> scratch;
+                std::vector<std::size_t> starts;
+                auto& out = chunk_groups[begin / group_grain];
+                for (std::size_t g = begin; g < end; ++g) {
+                    const Range& group = small_groups[g];
+                    sort_range(axis, group, scratch);
+                    starts.clear();
+                    starts.push_back(group.begin);
+                    find_segment_starts(axis, group.begin + 1, group.end, maxs[axis][order[group.begin]], starts);
+                    append_groups(starts, group.end, out);
+                }
+            });
+            for (const auto& chunk : chunk_groups) {
+                next_groups.insert(next_groups.end(), chunk.begin(), chunk.end());
+            }
+        }
+
+        groups.swap(next_groups);
+        if (groups.empty()) {
+            return hits;
+        }
+    }
+
+    // 3. 组内沿最后一个轴扫描; 按组内位置 (而不是按组) 均匀分块, 避免一个大组拖慢整体
+    const std::size_t sweep_axis = axes.back();
+    std::vector<std::size_t> group_offsets(groups.size() + 1, 0);
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        group_offsets[g + 1] = group_offsets[g] + groups[g].Size();
+    }
+    const std::size_t total       = group_offsets.back();
+    const std::size_t sweep_grain = std::max<std::size_t>(total / (workers * 16), 256);
+    const std::size_t chunks      = (total + sweep_grain - 1) / sweep_grain;
+    std::vector<std::vector<HitInfo>> chunk_hits(chunks);
+
+    pool.ParallelFor(total, sweep_grain, [&](std::size_t begin, std::size_t end) {
+        auto& out = chunk_hits[begin / sweep_grain];
+        const Ty* lo = mins[sweep_axis].data();
+        const Ty* hi = maxs[sweep_axis].data();
+        std::size_t g = static_cast<std::size_t>(
+            std::upper_bound(group_offsets.begin(), group_offsets.end(), begin) - group_offsets.begin() - 1);
+        for (std::size_t k = begin; k < end; ++k) {
+            while (k >= group_offsets[g + 1]) {
+                ++g;
+            }
+            const std::size_t p         = groups[g].begin + (k - group_offsets[g]);
+            const std::size_t group_end = groups[g].end;
+            const IndexType   i         = order[p];
+            const Ty          i_max     = hi[i];
+            for (std::size_t q = p + 1; q < group_end; ++q) {
+                const IndexType j = order[q];
+                if (lo[j] > i_max) {
+                    break;
+                }
+                bool overlap = true;
+                for (std::size_t axis = 0; axis < Dimensions && overlap; ++axis) {
+                    overlap = !(maxs[axis][i] < mins[axis][j] || maxs[axis][j] < mins[axis][i]);
+                }
+                if (overlap) {
+                    out.push_back(HitInfo{ std::min<std::uint64_t>(i, j), std::max<std::uint64_t>(i, j) });
+                }
+            }
+        }
+    });
+
+    // 4. 无锁合并: 前缀和确定每块的写出位置, 各块并行拷贝
+    std::vector<std::size_t> hit_offsets(chunks + 1, 0);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        hit_offsets[c + 1] = hit_offsets[c] + chunk_hits[c].size();
+    }
+    hits.resize(hit_offsets.back());
+    pool.ParallelFor(chunks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            std::copy(chunk_hits[c].begin(), chunk_hits[c].end(), hits.begin() + hit_offsets[c]);
+        }
+    });
+    return hits;
+}
+
+} // namespace Runtime::Core
@@ -1,8 +1,70 @@
+#pragma once
+// ============================================================================
+// GameObject.h — World 中实体的轻量句柄
+// ============================================================================
+//
+// GameObject 只保存 (World*, EntityId), 可按值传递; 组件数据存放在 World 的
+// archetype 中 (见 World.h). 实体销毁后句柄失效, IsValid() 返回 false.
+//
+//   Core::GameObject player(world, world.Spawn(Transform{}, Health{100}));
+//   player.Add(Velocity{});
+//   if (auto* hp = player.Get<Health>()) hp->Value -= 10;
+// ============================================================================
+
+#include "Core/GameObject/World.h"
 
 namespace Core
 {
 
 class GameObject
 {
+public:
+    GameObject() = default;
+    GameObject(World& world, EntityId entity) : Owner(&world), Entity(entity) {}
+
+    [[nodiscard]] bool IsValid() const noexcept { return Owner && Owner->IsAlive(Entity); }
+
+    [[nodiscard]] EntityId GetEntity() const noexcept { return Entity; }
+    [[nodiscard]] World*   GetWorld() const noexcept { return Owner; }
+
+    /// 组件指针; 句柄失效或不含 T 时返回 nullptr
+    template<typename T>
+    [[nodiscard]] T* Get() const noexcept
+    {
+        return Owner ? Owner->TryGet<T>(Entity) : nullptr;
+    }
+
+    template<typename T>
+    [[nodiscard]] bool Has() const noexcept
+    {
+        return Owner && Owner->Has<T>(Entity);
+    }
+
+    template<typename T>
+    void Add(T component)
+    {
+        assert(Owner && "GameObject::Add — 空句柄");
+        Owner->AddComponent(Entity, std::move(component));
+    }
+
+    template<typename T>
+    void Remove()
+    {
+        if (Owner)
+            Owner->RemoveComponent<T>(Entity);
+    }
+
+    void Destroy()
+    {
+        if (Owner)
+            Owner->Destroy(Entity);
+    }
+
+    friend bool operator==(const GameObject&, const GameObject&) = default;
+
+private:
+    World*   Owner = nullptr;
+    EntityId Entity;
 };
-}
\ No newline at end of file
+
+} // namespace Core
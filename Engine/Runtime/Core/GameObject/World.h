@@ -0,0 +1,900 @@
+#pragma once
+// ============================================================================
+// World.h — 基于 Archetype 的 ECS 存储
+// ============================================================================
+//
+// 实体 (Entity) 只是一个带代数 (generation) 的 id; 组件按 "组件组合" (archetype)
+// 分组存放, 每个 archetype 是一个 SoaDynamicArray<EntityId, Components...>
+// (或运行时按组件元数据建立的等价列存储): 同一组合的所有实体的同一组件在内存中连续,
+// 查询时按列线性遍历.
+//
+//   Core::World world;
+//   auto e = world.Spawn(Transform{...}, Velocity{...});
+//   world.AddComponent(e, Health{100});          // 迁移到 {Transform, Velocity, Health}
+//
+//   auto& movers = world.GetQuery<Transform, const Velocity>();
+//   movers.ForEach([](Transform& t, const Velocity& v) { t.Position += v.Value; });
+//
+//   // 百万实体: 按块分发到线程池, 每块是若干列上的连续 span
+//   movers.ParallelForEachChunk(GThreadPool(),
+//       [](std::span<const Core::EntityId>, std::span<Transform> t, std::span<const Velocity> v) { ... });
+//
+// ■ 实体 id:
+//   EntityId{Index, Generation}. 销毁实体时该槽位的代数加一, 旧 id 随即失效
+//   (IsAlive 返回 false, TryGet 返回 nullptr); 槽位之后被新实体复用.
+//
+// ■ Archetype:
+//   - Spawn<Ts...> 第一次遇到某个组件组合时按 Ts 的顺序创建对应 archetype
+//   - 组件的增删会把实体迁移到目标组合的 archetype: 先在目标 archetype 构造新行,
+//     成功后旧行与末行交换移除 (O(组件数)). 构造新行失败 (异常) 时实体保持原状
+//   - 迁移目标组合尚不存在时, 按 World 记录的组件元数据 (ComponentTypeInfo:
+//     大小 / 对齐 / 移动 / 析构) 现场创建一个类型擦除的 DynamicArchetype;
+//     RegisterArchetype<Ts...>() 仍可用于预先创建以 SoaDynamicArray 存储的 archetype
+//
+// ■ 查询:
+//   GetQuery<Ts...>() 返回缓存的查询对象, 其中保存所有包含 Ts 的 archetype.
+//   archetype 只增不删, 查询每次遍历前只检查新增的 archetype.
+//   Ts 可带 const, 表示只读访问.
+//
+// ■ 线程模型:
+//   World 本身不加锁. 遍历 (含 ParallelForEach*) 期间不得创建 / 销毁实体或增删组件;
+//   ParallelForEach* 的各块互不重叠, 回调可以并发写各自块内的组件.
+//
+// ■ 限制:
+//   组件类型最多 MaxComponentTypes 种, 组件须可移动构造.
+//   迁移时组件按 std::move_if_noexcept 取出 (移动可能抛异常时改为拷贝);
+//   交换移除要求移动赋值不抛异常.
+// ============================================================================
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Core/SoA/SoaDynamicArray.h"
+#include "Core/ThreadPool/ThreadPool.h"
+
+namespace Core
+{
+
+// ============================================================================
+//  EntityId / 组件类型 id
+// ============================================================================
+
+struct EntityId
+{
+    uint32_t Index      = std::numeric_limits<uint32_t>::max();
+    uint32_t Generation = 0;
+
+    [[nodiscard]] bool IsValid() const noexcept { return Index != std::numeric_limits<uint32_t>::max(); }
+
+    friend bool operator==(const EntityId&, const EntityId&) = default;
+};
+
+inline constexpr EntityId InvalidEntity{};
+
+using ComponentTypeId = uint32_t;
+
+inline constexpr size_t MaxComponentTypes = 128;
+
+/// 组件组合: 每种组件类型占一位
+using ComponentMask = std::bitset<MaxComponentTypes>;
+
+namespace Detail
+{
+    inline std::atomic<ComponentTypeId> NextComponentTypeId{0};
+}
+
+/// 组件类型 T 的 id (进程内首次使用时分配)
+template<typename T>
+ComponentTypeId ComponentTypeOf()
+{
+    static_assert(std::is_same_v<T, std::remove_cvref_t<T>>, "ComponentTypeOf — 请使用去除 cv / 引用后的类型");
+    static const ComponentTypeId id = []
+    {
+        ComponentTypeId next = Detail::NextComponentTypeId.fetch_add(1, std::memory_order_relaxed);
+        if (next >= MaxComponentTypes)
+            throw std::length_error("ComponentTypeOf — 组件类型数量超过 MaxComponentTypes");
+        return next;
+    }();
+    return id;
+}
+
+/// 组件类型的擦除元数据, 用于在运行时为任意组件组合建立列存储
+struct ComponentTypeInfo
+{
+    size_t Size  = 0; // 0 表示尚未登记
+    size_t Align = 0;
+
+    /// Take 是否可能抛异常 (即走拷贝构造, 或移动构造本身可能抛异常)
+    bool TakeMayThrow = false;
+
+    /// 在 dst 处以 std::move_if_noexcept(*src) 构造
+    void (*Take)(void* dst, void* src)       = nullptr;
+    void (*MoveAssign)(void* dst, void* src) = nullptr;
+    void (*Destroy)(void* object)            = nullptr;
+
+    template<typename T>
+    static ComponentTypeInfo Of() noexcept
+    {
+        ComponentTypeInfo info;
+        info.Size         = sizeof(T);
+        info.Align        = alignof(T);
+        info.TakeMayThrow = !std::is_nothrow_constructible_v<T, decltype(std::move_if_noexcept(std::declval<T&>()))>;
+        info.Take         = [](void* dst, void* src) { ::new (dst) T(std::move_if_noexcept(*static_cast<T*>(src))); };
+        info.MoveAssign   = [](void* dst, void* src) { *static_cast<T*>(dst) = std::move(*static_cast<T*>(src)); };
+        info.Destroy      = [](void* object) { std::destroy_at(static_cast<T*>(object)); };
+        return info;
+    }
+};
+
+template<typename... Ts>
+ComponentMask MakeComponentMask()
+{
+    ComponentMask mask;
+    (mask.set(ComponentTypeOf<std::remove_const_t<Ts>>()), ...);
+    return mask;
+}
+
+
+// ============================================================================
+//  IArchetype — 一个组件组合的存储 (类型擦除接口)
+// ============================================================================
+class IArchetype
+{
+public:
+    /// 按组件类型 id 返回用于移动构造新行的对象地址
+    struct ComponentSource
+    {
+        void* (*Fetch)(const void* context, ComponentTypeId id) = nullptr;
+        const void* Context = nullptr;
+
+        void* operator()(ComponentTypeId id) const { return Fetch(Context, id); }
+    };
+
+    explicit IArchetype(ComponentMask mask) : Mask(mask) {}
+    virtual ~IArchetype() = default;
+
+    IArchetype(const IArchetype&)            = delete;
+    IArchetype& operator=(const IArchetype&) = delete;
+
+    [[nodiscard]] const ComponentMask& GetMask() const noexcept { return Mask; }
+
+    [[nodiscard]] virtual size_t Size() const noexcept = 0;
+
+    /// 各行对应的实体 (长度为 Size())
+    [[nodiscard]] virtual const EntityId* Entities() const noexcept = 0;
+
+    /// 组件列的首地址; 不含该组件时返回 nullptr
+    [[nodiscard]] virtual void* ColumnData(ComponentTypeId id) noexcept = 0;
+
+    /// 第 row 行的组件地址; 不含该组件时返回 nullptr
+    [[nodiscard]] virtual void* ComponentAt(ComponentTypeId id, uint32_t row) noexcept = 0;
+
+    /// 追加一行, 每个组件以 std::move_if_noexcept(*source(id)) 构造; 返回新行号.
+    /// 失败 (异常) 时 archetype 不变, 且 source 中的对象只有在不会再抛异常时才被移走.
+    virtual uint32_t EmplaceMoved(EntityId entity, ComponentSource source) = 0;
+
+    /// 移除第 row 行 (末行移入该位置); 返回被移入的实体, 移除的就是末行时返回 InvalidEntity
+    virtual EntityId SwapRemove(uint32_t row) = 0;
+
+private:
+    ComponentMask Mask;
+};
+
+
+// ============================================================================
+//  Archetype<Ts...> — 以 SoaDynamicArray<EntityId, Ts...> 存储的组件组合
+// ============================================================================
+template<typename... Ts>
+class Archetype final : public IArchetype
+{
+    using Storage = SoaDynamicArray<EntityId, Ts...>;
+
+public:
+    Archetype() : IArchetype(MakeComponentMask<Ts...>()) {}
+
+    [[nodiscard]] size_t Size() const noexcept override { return Rows.Size(); }
+
+    [[nodiscard]] const EntityId* Entities() const noexcept override { return Rows.template Column<0>().data(); }
+
+    [[nodiscard]] void* ColumnData(ComponentTypeId id) noexcept override
+    {
+        return FindColumn(id, 0);
+    }
+
+    [[nodiscard]] void* ComponentAt(ComponentTypeId id, uint32_t row) noexcept override
+    {
+        return FindColumn(id, row);
+    }
+
+    uint32_t EmplaceMoved(EntityId entity, ComponentSource source) override
+    {
+        uint32_t row = static_cast<uint32_t>(Rows.Size());
+        // EmplaceBack 先构造可能抛异常的列, 因此失败时 source 不会丢失已移走的组件
+        Rows.EmplaceBack(entity, std::move_if_noexcept(*static_cast<Ts*>(source(ComponentTypeOf<Ts>())))...);
+        return row;
+    }
+
+    EntityId SwapRemove(uint32_t row) override
+    {
+        size_t last = Rows.Size() - 1;
+        EntityId moved = row == last ? InvalidEntity : Rows.template Column<0>()[last];
+        Rows.SwapRemoveAt(row);
+        return moved;
+    }
+
+    [[nodiscard]] Storage& GetStorage() noexcept { return Rows; }
+
+private:
+    Storage Rows;
+
+    void* FindColumn(ComponentTypeId id, uint32_t row) noexcept
+    {
+        void* found = nullptr;
+        [&]<size_t... Is>(std::index_sequence<Is...>)
+        {
+            // 列 0 是 EntityId, 组件从列 1 开始
+            ((ComponentTypeOf<Ts>() == id
+                  ? (void)(found = Rows.template Column<Is + 1>().data() + row)
+                  : void()), ...);
+        }(std::index_sequence_for<Ts...>{});
+        return found;
+    }
+};
+
+
+// ============================================================================
+//  DynamicArchetype — 按 ComponentTypeInfo 建立列存储的组件组合
+// ============================================================================
+//
+// 用于运行时才出现的组合 (如 AddComponent 到未注册的组合). 内存布局与
+// Archetype<Ts...> 相同: 每个组件一列连续数组, 列按组件类型 id 升序排列.
+//
+class DynamicArchetype final : public IArchetype
+{
+public:
+    DynamicArchetype(ComponentMask mask, const std::array<ComponentTypeInfo, MaxComponentTypes>& infos)
+        : IArchetype(mask)
+    {
+        for (ComponentTypeId id = 0; id < MaxComponentTypes; ++id)
+        {
+            if (!mask.test(id))
+                continue;
+            assert(infos[id].Size != 0 && "DynamicArchetype — 组件类型尚未在 World 中登记");
+            Columns.push_back(Column{id, infos[id], nullptr});
+        }
+    }
+
+    ~DynamicArchetype() override
+    {
+        for (Column& column : Columns)
+        {
+            DestroyColumn(column, column.Data, RowCount);
+            FreeColumn(column, column.Data);
+        }
+    }
+
+    [[nodiscard]] size_t Size() const noexcept override { return RowCount; }
+
+    [[nodiscard]] const EntityId* Entities() const noexcept override { return EntityRows.data(); }
+
+    [[nodiscard]] void* ColumnData(ComponentTypeId id) noexcept override
+    {
+        const Column* column = FindColumn(id);
+        return column ? column->Data : nullptr;
+    }
+
+    [[nodiscard]] void* ComponentAt(ComponentTypeId id, uint32_t row) noexcept override
+    {
+        const Column* column = FindColumn(id);
+        return column ? At(*column, column->Data, row) : nullptr;
+    }
+
+    uint32_t EmplaceMoved(EntityId entity, ComponentSource source) override
+    {
+        if (RowCount == RowCapacity)
+            GrowTo(RowCapacity == 0 ? 256 : RowCapacity * 2);
+
+        // 与 SoaDynamicArray::EmplaceBack 相同: 可能抛异常的列先构造, 失败时只析构这些列
+        size_t built = 0;
+        try
+        {
+            for (; built < Columns.size(); ++built)
+            {
+                if (Columns[built].Info.TakeMayThrow)
+                    Columns[built].Info.Take(At(Columns[built], Columns[built].Data, RowCount), source(Columns[built].Id));
+            }
+        }
+        catch (...)
+        {
+            for (size_t i = 0; i < built; ++i)
+            {
+                if (Columns[i].Info.TakeMayThrow)
+                    Columns[i].Info.Destroy(At(Columns[i], Columns[i].Data, RowCount));
+            }
+            throw;
+        }
+        for (Column& column : Columns)
+        {
+            if (!column.Info.TakeMayThrow)
+                column.Info.Take(At(column, column.Data, RowCount), source(column.Id));
+        }
+
+        EntityRows.push_back(entity); // 容量已在 GrowTo 中预留, 不会抛出
+        return static_cast<uint32_t>(RowCount++);
+    }
+
+    EntityId SwapRemove(uint32_t row) override
+    {
+        size_t   last  = RowCount - 1;
+        EntityId moved = row == last ? InvalidEntity : EntityRows[last];
+        for (Column& column : Columns)
+        {
+            if (row != last)
+                column.Info.MoveAssign(At(column, column.Data, row), At(column, column.Data, last));
+            column.Info.Destroy(At(column, column.Data, last));
+        }
+        EntityRows[row] = EntityRows[last];
+        EntityRows.pop_back();
+        --RowCount;
+        return moved;
+    }
+
+private:
+    struct Column
+    {
+        ComponentTypeId   Id;
+        ComponentTypeInfo Info;
+        std::byte*        Data;
+    };
+
+    std::vector<Column>   Columns;
+    std::vector<EntityId> EntityRows;
+    size_t                RowCount    = 0;
+    size_t                RowCapacity = 0;
+
+    const Column* FindColumn(ComponentTypeId id) const noexcept
+    {
+        for (const Column& column : Columns)
+        {
+            if (column.Id == id)
+                return &column;
+        }
+        return nullptr;
+    }
+
+    static void* At(const Column& column, std::byte* data, size_t row) noexcept
+    {
+        return data + row * column.Info.Size;
+    }
+
+    static void DestroyColumn(const Column& column, std::byte* data, size_t count) noexcept
+    {
+        for (size_t row = 0; row < count; ++row)
+            column.Info.Destroy(At(column, data, row));
+    }
+
+    static void FreeColumn(const Column& column, std::byte* data) noexcept
+    {
+        if (data)
+            ::operator delete(data, std::align_val_t(column.Info.Align));
+    }
+
+    /// 扩容: 先分配全部新列, 可能抛异常的列先搬运 (拷贝), 全部成功后才析构旧列
+    void GrowTo(size_t capacity)
+    {
+        EntityRows.reserve(capacity);
+
+        std::vector<std::byte*> fresh(Columns.size(), nullptr);
+        size_t                  failed = 0; // 出错时正在处理的列
+        size_t                  built  = 0; // 该列已构造的行数
+        try
+        {
+            for (size_t i = 0; i < Columns.size(); ++i)
+            {
+                fresh[i] = static_cast<std::byte*>(::operator new(
+                    capacity * Columns[i].Info.Size, std::align_val_t(Columns[i].Info.Align)));
+            }
+            for (failed = 0; failed < Columns.size(); ++failed)
+            {
+                const Column& column = Columns[failed];
+                if (!column.Info.TakeMayThrow)
+                    continue;
+                for (built = 0; built < RowCount; ++built)
+                    column.Info.Take(At(column, fresh[failed], built), At(column, column.Data, built));
+            }
+        }
+        catch (...)
+        {
+            for (size_t i = 0; i < Columns.size(); ++i)
+            {
+                if (fresh[i] && Columns[i].Info.TakeMayThrow && i <= failed)
+                    DestroyColumn(Columns[i], fresh[i], i < failed ? RowCount : built);
+                FreeColumn(Columns[i], fresh[i]);
+            }
+            throw;
+        }
+
+        for (size_t i = 0; i < Columns.size(); ++i)
+        {
+            Column& column = Columns[i];
+            if (!column.Info.TakeMayThrow)
+            {
+                for (size_t row = 0; row < RowCount; ++row)
+                    column.Info.Take(At(column, fresh[i], row), At(column, column.Data, row));
+            }
+            DestroyColumn(column, column.Data, RowCount);
+            FreeColumn(column, column.Data);
+            column.Data = fresh[i];
+        }
+        RowCapacity = capacity;
+    }
+};
+
+
+class World;
+
+// ============================================================================
+//  ArchetypeQuery<Ts...> — 缓存的组件查询
+// ============================================================================
+class IArchetypeQuery
+{
+public:
+    virtual ~IArchetypeQuery() = default;
+};
+
+template<typename... Ts>
+class ArchetypeQuery final : public IArchetypeQuery
+{
+public:
+    /// 并行遍历的默认块行数
+    static constexpr size_t DefaultChunkRows = 16 * 1024;
+
+    explicit ArchetypeQuery(World& world) : Owner(&world), Mask(MakeComponentMask<Ts...>()) {}
+
+    /// 当前匹配的 archetype 列表
+    [[nodiscard]] const std::vector<IArchetype*>& GetArchetypes()
+    {
+        Refresh();
+        return Matches;
+    }
+
+    /// 匹配的实体总数
+    [[nodiscard]] size_t Count()
+    {
+        Refresh();
+        size_t total = 0;
+        for (IArchetype* archetype : Matches)
+            total += archetype->Size();
+        return total;
+    }
+
+    // ----------------------------------------------------------------
+    // ForEach — 逐实体遍历: fn(Ts&...)
+    // ----------------------------------------------------------------
+    template<typename Fn>
+    void ForEach(Fn&& fn)
+    {
+        ForEachChunk([&](std::span<const EntityId>, std::span<Ts>... columns)
+        {
+            size_t count = (columns.size(), ...);
+            for (size_t i = 0; i < count; ++i)
+                fn(columns[i]...);
+        }, std::numeric_limits<size_t>::max());
+    }
+
+    // ----------------------------------------------------------------
+    // ForEachChunk — 按块遍历: fn(span<const EntityId>, span<Ts>...)
+    //
+    // 每块来自同一个 archetype, 各 span 长度相同、行一一对应.
+    // ----------------------------------------------------------------
+    template<typename Fn>
+    void ForEachChunk(Fn&& fn, size_t chunkRows = DefaultChunkRows)
+    {
+        Refresh();
+        chunkRows = std::max<size_t>(chunkRows, 1);
+        for (IArchetype* archetype : Matches)
+        {
+            size_t size = archetype->Size();
+            for (size_t first = 0; first < size; first += chunkRows)
+                InvokeChunk(fn, archetype, first, std::min(chunkRows, size - first));
+        }
+    }
+
+    // ----------------------------------------------------------------
+    // ParallelForEachChunk — 把所有匹配 archetype 切成块, 通过 pool.ParallelFor 分发
+    // ----------------------------------------------------------------
+    template<typename Fn>
+    void ParallelForEachChunk(ThreadPool& pool, Fn&& fn, size_t chunkRows = DefaultChunkRows)
+    {
+        Refresh();
+        chunkRows = std::max<size_t>(chunkRows, 1);
+
+        struct ChunkRange
+        {
+            IArchetype* Archetype;
+            size_t      First;
+            size_t      Count;
+        };
+        std::vector<ChunkRange> chunks;
+        for (IArchetype* archetype : Matches)
+        {
+            size_t size = archetype->Size();
+            for (size_t first = 0; first < size; first += chunkRows)
+                chunks.push_back({archetype, first, std::min(chunkRows, size - first)});
+        }
+
+        pool.ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                InvokeChunk(fn, chunks[i].Archetype, chunks[i].First, chunks[i].Count);
+        });
+    }
+
+    /// 并行逐实体遍历: fn(Ts&...)
+    template<typename Fn>
+    void ParallelForEach(ThreadPool& pool, Fn&& fn, size_t chunkRows = DefaultChunkRows)
+    {
+        ParallelForEachChunk(pool, [&](std::span<const EntityId>, std::span<Ts>... columns)
+        {
+            size_t count = (columns.size(), ...);
+            for (size_t i = 0; i < count; ++i)
+                fn(columns[i]...);
+        }, chunkRows);
+    }
+
+private:
+    World*                   Owner;
+    ComponentMask            Mask;
+    std::vector<IArchetype*> Matches;
+    size_t                   ScannedArchetypes = 0;
+
+    void Refresh();
+
+    template<typename Fn>
+    static void InvokeChunk(Fn& fn, IArchetype* archetype, size_t first, size_t count)
+    {
+        fn(std::span<const EntityId>(archetype->Entities() + first, count),
+           std::span<Ts>(static_cast<Ts*>(archetype->ColumnData(ComponentTypeOf<std::remove_const_t<Ts>>())) + first,
+                         count)...);
+    }
+};
+
+
+// ============================================================================
+//  World — 实体与 archetype 的容器
+// ============================================================================
+class World
+{
+public:
+    World() = default;
+    World(const World&)            = delete;
+    World& operator=(const World&) = delete;
+
+    // ----------------------------------------------------------------
+    // Spawn — 创建实体, 组件按值传入 (移动到 archetype 中)
+    // ----------------------------------------------------------------
+    template<typename... Ts>
+    EntityId Spawn(Ts... components)
+    {
+        static_assert((std::is_same_v<Ts, std::remove_cvref_t<Ts>> && ...), "World::Spawn — 组件须为值类型");
+        static_assert(AreUnique<Ts...>(), "World::Spawn — 组件类型不能重复");
+
+        IArchetype& archetype = FindOrCreateArchetype<Ts...>();
+
+        std::array<ComponentTypeId, sizeof...(Ts)> ids{ComponentTypeOf<Ts>()...};
+        std::array<void*, sizeof...(Ts)>           values{static_cast<void*>(&components)...};
+        struct SpawnContext
+        {
+            const ComponentTypeId* Ids;
+            void* const*           Values;
+        } context{ids.data(), values.data()};
+
+        EntityId entity = AllocateEntity();
+        IArchetype::ComponentSource source{
+            [](const void* ctx, ComponentTypeId id) -> void*
+            {
+                auto* spawn = static_cast<const SpawnContext*>(ctx);
+                for (size_t i = 0; i < sizeof...(Ts); ++i)
+                {
+                    if (spawn->Ids[i] == id)
+                        return spawn->Values[i];
+                }
+                return nullptr;
+            },
+            &context};
+
+        try
+        {
+            uint32_t row = archetype.EmplaceMoved(entity, source);
+            Records[entity.Index].Archetype = &archetype;
+            Records[entity.Index].Row       = row;
+        }
+        catch (...)
+        {
+            ReleaseEntity(entity);
+            throw;
+        }
+        ++AliveCount;
+        return entity;
+    }
+
+    /// 销毁实体; 已失效的 id 直接忽略
+    void Destroy(EntityId entity)
+    {
+        if (!IsAlive(entity))
+            return;
+        EntityRecord& record = Records[entity.Index];
+        RemoveRow(*record.Archetype, record.Row);
+        ReleaseEntity(entity);
+        --AliveCount;
+    }
+
+    [[nodiscard]] bool IsAlive(EntityId entity) const noexcept
+    {
+        return entity.Index < Records.size()
+            && Records[entity.Index].Generation == entity.Generation
+            && Records[entity.Index].Archetype != nullptr;
+    }
+
+    /// 存活实体数
+    [[nodiscard]] size_t EntityCount() const noexcept { return AliveCount; }
+
+    /// 已创建的 archetype 数
+    [[nodiscard]] size_t ArchetypeCount() const noexcept { return ArchetypeList.size(); }
+
+    // ----------------------------------------------------------------
+    // 组件访问
+    // ----------------------------------------------------------------
+
+    /// 返回实体的组件 T; 实体已失效或不含 T 时返回 nullptr.
+    /// 指针在下一次结构性修改 (Spawn / Destroy / 增删组件) 前有效.
+    template<typename T>
+    [[nodiscard]] T* TryGet(EntityId entity) noexcept
+    {
+        if (!IsAlive(entity))
+            return nullptr;
+        EntityRecord& record = Records[entity.Index];
+        return static_cast<T*>(record.Archetype->ComponentAt(ComponentTypeOf<T>(), record.Row));
+    }
+
+    template<typename T>
+    [[nodiscard]] bool Has(EntityId entity) const noexcept
+    {
+        return IsAlive(entity) && Records[entity.Index].Archetype->GetMask().test(ComponentTypeOf<T>());
+    }
+
+    // ----------------------------------------------------------------
+    // AddComponent / RemoveComponent — 迁移到相邻的 archetype
+    //
+    // 目标组合不存在时现场创建 (见文件头); 已含 T 时 AddComponent 直接赋值.
+    // 迁移失败 (异常) 时实体保持原来的组合与组件值.
+    // ----------------------------------------------------------------
+    template<typename T>
+    void AddComponent(EntityId entity, T component)
+    {
+        if (!IsAlive(entity))
+            throw std::invalid_argument("World::AddComponent — 实体已失效");
+        if (T* existing = TryGet<T>(entity))
+        {
+            *existing = std::move(component);
+            return;
+        }
+
+        RegisterComponent<T>();
+        EntityRecord& record = Records[entity.Index];
+        ComponentMask target = record.Archetype->GetMask();
+        target.set(ComponentTypeOf<T>());
+        Migrate(entity, FindOrCreateArchetype(target), ComponentTypeOf<T>(), &component);
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityId entity)
+    {
+        if (!Has<T>(entity))
+            return;
+
+        ComponentMask target = Records[entity.Index].Archetype->GetMask();
+        target.reset(ComponentTypeOf<T>());
+        Migrate(entity, FindOrCreateArchetype(target), ComponentTypeOf<T>(), nullptr);
+    }
+
+    /// 预先创建组合 Ts 的 archetype (以 SoaDynamicArray 存储, 列顺序为 Ts 的顺序)
+    template<typename... Ts>
+    void RegisterArchetype()
+    {
+        static_assert(AreUnique<Ts...>(), "World::RegisterArchetype — 组件类型不能重复");
+        FindOrCreateArchetype<Ts...>();
+    }
+
+    // ----------------------------------------------------------------
+    // GetQuery — 返回缓存的查询 (同一 Ts... 返回同一对象)
+    // ----------------------------------------------------------------
+    template<typename... Ts>
+    [[nodiscard]] ArchetypeQuery<Ts...>& GetQuery()
+    {
+        auto& slot = Queries[std::type_index(typeid(ArchetypeQuery<Ts...>))];
+        if (!slot)
+            slot = std::make_unique<ArchetypeQuery<Ts...>>(*this);
+        return static_cast<ArchetypeQuery<Ts...>&>(*slot);
+    }
+
+    /// 按创建顺序排列的全部 archetype (只增不删)
+    [[nodiscard]] const std::vector<IArchetype*>& GetArchetypes() const noexcept { return ArchetypeList; }
+
+private:
+    struct EntityRecord
+    {
+        uint32_t    Generation = 0;
+        uint32_t    Row        = 0;
+        IArchetype* Archetype  = nullptr; // 为空表示槽位空闲
+    };
+
+    std::vector<EntityRecord>                                     Records;
+    std::vector<uint32_t>                                         FreeIndices;
+    size_t                                                        AliveCount = 0;
+    std::unordered_map<ComponentMask, std::unique_ptr<IArchetype>> Archetypes;
+    std::vector<IArchetype*>                                      ArchetypeList;
+    std::unordered_map<std::type_index, std::unique_ptr<IArchetypeQuery>> Queries;
+    std::array<ComponentTypeInfo, MaxComponentTypes>              ComponentInfos{}; // 按 ComponentTypeId 索引
+
+    template<typename... Ts>
+    static constexpr bool AreUnique()
+    {
+        if constexpr (sizeof...(Ts) <= 1)
+            return true;
+        else
+            return []<typename First, typename... Rest>(std::type_identity<First>, std::type_identity<Rest>...)
+            {
+                return !(std::is_same_v<First, Rest> || ...) && AreUnique<Rest...>();
+            }(std::type_identity<Ts>{}...);
+    }
+
+    /// 记录组件 T 的元数据, 供 DynamicArchetype 使用
+    template<typename T>
+    void RegisterComponent()
+    {
+        ComponentTypeInfo& info = ComponentInfos[ComponentTypeOf<T>()];
+        if (info.Size == 0)
+            info = ComponentTypeInfo::Of<T>();
+    }
+
+    template<typename... Ts>
+    IArchetype& FindOrCreateArchetype()
+    {
+        (RegisterComponent<Ts>(), ...);
+        return FindOrAddArchetype(MakeComponentMask<Ts...>(), [] { return std::make_unique<Archetype<Ts...>>(); });
+    }
+
+    /// 按组件组合查找 archetype, 不存在时以已登记的组件元数据创建 DynamicArchetype
+    IArchetype& FindOrCreateArchetype(const ComponentMask& mask)
+    {
+        return FindOrAddArchetype(mask, [&] { return std::make_unique<DynamicArchetype>(mask, ComponentInfos); });
+    }
+
+    template<typename Factory>
+    IArchetype& FindOrAddArchetype(const ComponentMask& mask, Factory&& create)
+    {
+        auto& slot = Archetypes[mask];
+        if (!slot)
+        {
+            try
+            {
+                ArchetypeList.reserve(ArchetypeList.size() + 1);
+                slot = create();
+                ArchetypeList.push_back(slot.get());
+            }
+            catch (...)
+            {
+                Archetypes.erase(mask);
+                throw;
+            }
+        }
+        return *slot;
+    }
+
+    EntityId AllocateEntity()
+    {
+        if (!FreeIndices.empty())
+        {
+            uint32_t index = FreeIndices.back();
+            FreeIndices.pop_back();
+            return {index, Records[index].Generation};
+        }
+        if (Records.size() >= std::numeric_limits<uint32_t>::max())
+            throw std::length_error("World — 实体数量超出上限");
+        Records.emplace_back();
+        return {static_cast<uint32_t>(Records.size() - 1), 0};
+    }
+
+    /// 槽位代数加一并放回空闲列表
+    void ReleaseEntity(EntityId entity)
+    {
+        EntityRecord& record = Records[entity.Index];
+        record.Archetype = nullptr;
+        ++record.Generation;
+        FreeIndices.push_back(entity.Index);
+    }
+
+    /// 移除 archetype 的一行, 并修正被移入该行的实体的记录
+    void RemoveRow(IArchetype& archetype, uint32_t row)
+    {
+        EntityId moved = archetype.SwapRemove(row);
+        if (moved.IsValid())
+            Records[moved.Index].Row = row;
+    }
+
+    /// 把实体从当前 archetype 移到 target: 共有组件移动构造, extra 为新增组件 (extraId 对应).
+    /// 先构造目标行 (失败时 EmplaceMoved 自行回滚, 源行不受影响), 成功后才移除源行并更新记录.
+    void Migrate(EntityId entity, IArchetype& target, ComponentTypeId extraId, void* extra)
+    {
+        EntityRecord& record = Records[entity.Index];
+        IArchetype&   source = *record.Archetype;
+
+        struct MigrateContext
+        {
+            IArchetype*     Source;
+            uint32_t        Row;
+            ComponentTypeId ExtraId;
+            void*           Extra;
+        } context{&source, record.Row, extraId, extra};
+
+        IArchetype::ComponentSource fetch{
+            [](const void* ctx, ComponentTypeId id) -> void*
+            {
+                auto* migrate = static_cast<const MigrateContext*>(ctx);
+                if (migrate->Extra && id == migrate->ExtraId)
+                    return migrate->Extra;
+                return migrate->Source->ComponentAt(id, migrate->Row);
+            },
+            &context};
+
+        uint32_t newRow = target.EmplaceMoved(entity, fetch);
+        try
+        {
+            RemoveRow(source, record.Row);
+        }
+        catch (...)
+        {
+            // 仅在组件的移动赋值抛异常时发生 (违反文件头的限制): 至少不留下重复的行
+            target.SwapRemove(newRow);
+            throw;
+        }
+        record.Archetype = &target;
+        record.Row       = newRow;
+    }
+
+    template<typename... Ts>
+    friend class ArchetypeQuery;
+};
+
+
+template<typename... Ts>
+void ArchetypeQuery<Ts...>::Refresh()
+{
+    const auto& archetypes = Owner->ArchetypeList;
+    for (; ScannedArchetypes < archetypes.size(); ++ScannedArchetypes)
+    {
+        IArchetype* archetype = archetypes[ScannedArchetypes];
+        if ((archetype->GetMask() & Mask) == Mask)
+            Matches.push_back(archetype);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+
+#include "SoaDynamicArray.h"
+#include "SoaMemoryResource.h"
+
+#if defined(__linux__)
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#define CORE_SOA_HAS_PERF_EVENTS 1
+#else
+	#define CORE_SOA_HAS_PERF_EVENTS 0
+#endif
+
+// SoA 列扫描的 TLB 对比：同一列分别放在默认内存与 2MB 大页上，测量
+//   - 顺序扫描整列的 ns/行
+//   - 伪随机访问（每次跨页）的 ns/次
+//   - 两者期间的 dTLB 读缺失次数（Linux perf_event；不可用时为 -1）
+//
+//   auto r = Core::SoaBenchmark::CompareColumnScanPages(100'000'000);
+//   SDL_Log("scan %.2f / %.2f ns/row, dTLB misses %lld / %lld",
+//           r.default_pages.scan_ns_per_row, r.huge_pages.scan_ns_per_row,
+//           r.default_pages.dtlb_misses, r.huge_pages.dtlb_misses);
+
+namespace Core::SoaBenchmark
+{
+struct ColumnScanResult
+{
+	double scan_ns_per_row = 0.0;
+	double random_ns_per_access = 0.0;
+	int64_t dtlb_misses = -1; // 扫描 + 随机访问期间的 dTLB 读缺失，-1 表示计数器不可用
+};
+
+struct ColumnScanComparison
+{
+	size_t rows = 0;
+	size_t random_accesses = 0;
+	ColumnScanResult default_pages;
+	ColumnScanResult huge_pages;
+	bool huge_tlb = false;   // 大页来自 MAP_HUGETLB（否则为透明大页，是否生效取决于内核配置）
+	uint64_t checksum = 0;   // 防止扫描被优化掉，两次测量应一致
+};
+
+namespace Detail
+{
+	// dTLB 读缺失计数器，只统计用户态
+	class DtlbMissCounter
+	{
+	public:
+		DtlbMissCounter()
+		{
+#if CORE_SOA_HAS_PERF_EVENTS
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.size = sizeof(attr);
+			attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+				(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+		}
+
+		~DtlbMissCounter()
+		{
+#if CORE_SOA_HAS_PERF_EVENTS
+			if (fd >= 0) ::close(fd);
+#endif
+		}
+
+		DtlbMissCounter(const DtlbMissCounter&) = delete;
+		DtlbMissCounter& operator=(const DtlbMissCounter&) = delete;
+
+		void Start()
+		{
+#if CORE_SOA_HAS_PERF_EVENTS
+			if (fd < 0) return;
+			::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+		}
+
+		// 返回 Start() 以来的缺失次数，不可用时返回 -1
+		int64_t Stop()
+		{
+#if CORE_SOA_HAS_PERF_EVENTS
+			if (fd < 0) return -1;
+			::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+			uint64_t count = 0;
+			if (::read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+			return static_cast<int64_t>(count);
+#else
+			return -1;
+#endif
+		}
+
+	private:
+		int fd = -1;
+	};
+
+	inline double ElapsedNs(std::chrono::steady_clock::time_point begin, size_t iterations)
+	{
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(end - begin).count() /
+			static_cast<double>(iterations == 0 ? 1 : iterations);
+	}
+
+	inline ColumnScanResult MeasureColumn(std::pmr::memory_resource* resource, size_t rows, size_t random_accesses,
+		uint64_t& checksum)
+	{
+		ColumnScanResult result;
+		SoaDynamicArray<uint32_t> array(resource);
+		array.Resize(rows); // 同时完成首次触页，测量中不含缺页开销
+		std::span<uint32_t> column = array.Column<0>();
+		for (size_t i = 0; i < rows; ++i)
+			column[i] = static_cast<uint32_t>(i);
+
+		DtlbMissCounter counter;
+		counter.Start();
+
+		uint64_t sum = 0;
+		auto begin = std::chrono::steady_clock::now();
+		for (uint32_t value : column)
+			sum += value;
+		result.scan_ns_per_row = ElapsedNs(begin, rows);
+
+		// xorshift 伪随机下标：几乎每次访问都落在不同的 4KB 页上
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		begin = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < random_accesses && rows != 0; ++i)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			sum += column[state % rows];
+		}
+		result.random_ns_per_access = ElapsedNs(begin, random_accesses);
+
+		result.dtlb_misses = counter.Stop();
+		checksum = sum;
+		return result;
+	}
+}
+
+// @brief 对比默认分配与大页分配下的列扫描开销。
+// @param rows 列行数（uint32_t 列，1 亿行约 400MB，两次测量不会同时驻留）。
+// @param random_accesses 随机访问次数。
+inline ColumnScanComparison CompareColumnScanPages(size_t rows = 100'000'000, size_t random_accesses = 10'000'000)
+{
+	ColumnScanComparison comparison;
+	comparison.rows = rows;
+	comparison.random_accesses = random_accesses;
+
+	uint64_t default_sum = 0;
+	uint64_t huge_sum = 0;
+	comparison.default_pages = Detail::MeasureColumn(std::pmr::new_delete_resource(), rows, random_accesses, default_sum);
+
+	SoaHugePageResource huge_resource;
+	comparison.huge_pages = Detail::MeasureColumn(&huge_resource, rows, random_accesses, huge_sum);
+	comparison.huge_tlb = huge_resource.HugeTlbAllocations() != 0;
+
+	comparison.checksum = default_sum == huge_sum ? default_sum : 0;
+	return comparison;
+}
+}
@@ -0,0 +1,491 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+// @brief 固定大小内存块的缓存池，供 SoaChunkedArray 复用 Chunk。
+// @note 线程安全；缓存的块在 Trim() 或池析构时才归还 upstream（默认为 get_default_resource()）。
+//       upstream 可以是 SoaHugePageResource 等，须比池活得更久且线程安全。
+class SoaChunkPool
+{
+public:
+	SoaChunkPool(size_t chunk_bytes, size_t alignment,
+		std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: chunk_bytes(chunk_bytes), alignment(alignment), upstream(upstream)
+	{
+	}
+
+	~SoaChunkPool() { Trim(); }
+
+	SoaChunkPool(const SoaChunkPool&) = delete;
+	SoaChunkPool& operator=(const SoaChunkPool&) = delete;
+
+	// @brief 取一个块：优先复用缓存，否则向系统申请。
+	[[nodiscard]] std::byte* Acquire()
+	{
+		{
+			std::lock_guard lock(mutex);
+			if (!free_chunks.empty())
+			{
+				std::byte* chunk = free_chunks.back();
+				free_chunks.pop_back();
+				return chunk;
+			}
+		}
+		return static_cast<std::byte*>(upstream->allocate(chunk_bytes, alignment));
+	}
+
+	// @brief 归还一个块到缓存。
+	void Release(std::byte* chunk)
+	{
+		if (!chunk) return;
+		std::lock_guard lock(mutex);
+		free_chunks.push_back(chunk);
+	}
+
+	// @brief 将缓存中超出 keep 的块归还系统。
+	void Trim(size_t keep = 0)
+	{
+		std::vector<std::byte*> released;
+		{
+			std::lock_guard lock(mutex);
+			while (free_chunks.size() > keep)
+			{
+				released.push_back(free_chunks.back());
+				free_chunks.pop_back();
+			}
+		}
+		for (std::byte* chunk : released)
+		{
+			upstream->deallocate(chunk, chunk_bytes, alignment);
+		}
+	}
+
+	size_t CachedCount() const
+	{
+		std::lock_guard lock(mutex);
+		return free_chunks.size();
+	}
+
+	size_t ChunkBytes() const noexcept { return chunk_bytes; }
+	size_t Alignment() const noexcept { return alignment; }
+
+private:
+	size_t chunk_bytes;
+	size_t alignment;
+	std::pmr::memory_resource* upstream;
+	mutable std::mutex mutex;
+	std::vector<std::byte*> free_chunks;
+};
+
+// @brief 分页（AoSoA）SoA 数组：行按 ChunkRows 分块，每块内各列连续存放。
+// @tparam ChunkRows 每块行数，必须是 2 的幂。
+// @tparam Types 存储的列类型列表。
+// @note 与 SoaDynamicArray 的区别：
+//       - 扩容只追加新块，已有行永不移动，元素地址在其被移除前保持稳定；
+//       - 没有整体搬迁，百万行级别的数组扩容也不会产生卡顿；
+//       - 列只在块内连续，遍历请使用 ForEachChunk / ChunkColumn；
+//       - ShrinkToFit 把多余的块归还 SoaChunkPool，而不是释放给系统。
+//       块内每列起始地址按 ColumnAlignment（64 字节）对齐，块从池中以固定大小分配。
+template <size_t ChunkRows, typename... Types>
+class BasicSoaChunkedArray
+{
+	static_assert(ChunkRows > 0 && std::has_single_bit(ChunkRows), "BasicSoaChunkedArray — ChunkRows 必须是 2 的幂");
+
+public:
+	using value_types = std::tuple<Types...>;
+	static constexpr size_t NumTypes = sizeof...(Types);
+	static constexpr size_t RowsPerChunk = ChunkRows;
+
+	// 块内列起始地址的对齐（字节）
+	static constexpr size_t ColumnAlignment = 64;
+
+private:
+	static constexpr size_t ChunkShift = std::countr_zero(ChunkRows);
+	static constexpr size_t RowMask = ChunkRows - 1;
+
+	// 块内各列的对齐与偏移（编译期计算）
+	static constexpr std::array<size_t, NumTypes> ColumnAligns = {std::max(alignof(Types), ColumnAlignment)...};
+	static constexpr std::array<size_t, NumTypes> ColumnSizes = {sizeof(Types)...};
+
+	static constexpr std::array<size_t, NumTypes> ColumnOffsets = []
+	{
+		std::array<size_t, NumTypes> offsets{};
+		size_t offset = 0;
+		for (size_t i = 0; i < NumTypes; ++i)
+		{
+			offset = (offset + ColumnAligns[i] - 1) / ColumnAligns[i] * ColumnAligns[i];
+			offsets[i] = offset;
+			offset += ColumnSizes[i] * ChunkRows;
+		}
+		return offsets;
+	}();
+
+public:
+	// 单个块的字节数与对齐
+	static constexpr size_t ChunkAlignment = std::max({ColumnAlignment, alignof(Types)...});
+	static constexpr size_t ChunkBytes = []
+	{
+		size_t end = NumTypes == 0 ? 0 : ColumnOffsets[NumTypes - 1] + ColumnSizes[NumTypes - 1] * ChunkRows;
+		return (end + ChunkAlignment - 1) / ChunkAlignment * ChunkAlignment;
+	}();
+
+	// @brief 本类型默认使用的块池（进程内共享，永不析构）。
+	static SoaChunkPool& DefaultPool()
+	{
+		static SoaChunkPool* pool = new SoaChunkPool(ChunkBytes, ChunkAlignment);
+		return *pool;
+	}
+
+	// ---------- 构造 / 析构 ----------
+	BasicSoaChunkedArray() : pool(&DefaultPool()) {}
+
+	// @param chunk_pool 块池，其块大小须为 ChunkBytes，且生命周期长于本数组。
+	explicit BasicSoaChunkedArray(SoaChunkPool& chunk_pool) : pool(&chunk_pool)
+	{
+		if (chunk_pool.ChunkBytes() != ChunkBytes || chunk_pool.Alignment() < ChunkAlignment)
+			throw std::invalid_argument("SoaChunkedArray — 块池的块大小或对齐不匹配");
+	}
+
+	~BasicSoaChunkedArray()
+	{
+		Clear();
+		ReleaseChunksFrom(0);
+	}
+
+	BasicSoaChunkedArray(const BasicSoaChunkedArray& other) : pool(other.pool)
+	{
+		Append(other);
+	}
+
+	BasicSoaChunkedArray& operator=(const BasicSoaChunkedArray& other)
+	{
+		if (this != &other)
+		{
+			BasicSoaChunkedArray temp(other);
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	BasicSoaChunkedArray(BasicSoaChunkedArray&& other) noexcept
+		: chunks(std::move(other.chunks))
+		, pool(other.pool)
+		, size(std::exchange(other.size, 0))
+	{
+		other.chunks.clear();
+	}
+
+	BasicSoaChunkedArray& operator=(BasicSoaChunkedArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			BasicSoaChunkedArray temp(std::move(other));
+			Swap(temp);
+		}
+		return *this;
+	}
+
+	// ---------- 元素访问 ----------
+	// @brief 返回第 index 行的只读视图（tuple<const Types&...>）。
+	auto operator[](size_t index) const noexcept
+	{
+		return [&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			return std::tuple<const Types&...>(Get<Is>(index)...);
+		}(std::index_sequence_for<Types...>{});
+	}
+
+	// @brief 返回第 index 行的可读写视图（tuple<Types&...>）。
+	auto operator[](size_t index) noexcept
+	{
+		return [&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			return std::tuple<Types&...>(Get<Is>(index)...);
+		}(std::index_sequence_for<Types...>{});
+	}
+
+	auto At(size_t index) const
+	{
+		if (index >= size)
+			throw std::out_of_range("SoaChunkedArray::At");
+		return (*this)[index];
+	}
+
+	auto At(size_t index)
+	{
+		if (index >= size)
+			throw std::out_of_range("SoaChunkedArray::At");
+		return (*this)[index];
+	}
+
+	// @brief 第 index 行第 I 列的引用；地址在该行被移除前保持不变。
+	template <size_t I>
+	auto& Get(size_t index) noexcept
+	{
+		return ChunkColumnData<I>(index >> ChunkShift)[index & RowMask];
+	}
+
+	template <size_t I>
+	const auto& Get(size_t index) const noexcept
+	{
+		return ChunkColumnData<I>(index >> ChunkShift)[index & RowMask];
+	}
+
+	// ---------- 按块访问 ----------
+	// @brief 含有元素的块数。
+	size_t ChunkCount() const noexcept { return (size + RowMask) >> ChunkShift; }
+
+	// @brief 第 chunk 块中第 I 列的连续视图（长度为该块的实际行数）。
+	template <size_t I>
+	std::span<std::tuple_element_t<I, value_types>> ChunkColumn(size_t chunk) noexcept
+	{
+		return {ChunkColumnData<I>(chunk), RowsInChunk(chunk)};
+	}
+
+	template <size_t I>
+	std::span<const std::tuple_element_t<I, value_types>> ChunkColumn(size_t chunk) const noexcept
+	{
+		return {ChunkColumnData<I>(chunk), RowsInChunk(chunk)};
+	}
+
+	// @brief 逐块遍历列 Is...（为空时遍历全部列），fn(size_t first_row, std::span<T>... columns)。
+	// @note 除最后一块外每块恰好 ChunkRows 行，各列视图起始地址按 ColumnAlignment 对齐。
+	template <size_t... Is, typename Fn>
+	void ForEachChunk(Fn&& fn)
+	{
+		if constexpr (sizeof...(Is) == 0)
+		{
+			[&]<size_t... All>(std::index_sequence<All...>)
+			{
+				ForEachChunk<All...>(std::forward<Fn>(fn));
+			}(std::index_sequence_for<Types...>{});
+		}
+		else
+		{
+			for (size_t chunk = 0, count = ChunkCount(); chunk < count; ++chunk)
+			{
+				fn(chunk << ChunkShift, ChunkColumn<Is>(chunk)...);
+			}
+		}
+	}
+
+	template <size_t... Is, typename Fn>
+	void ForEachChunk(Fn&& fn) const
+	{
+		if constexpr (sizeof...(Is) == 0)
+		{
+			[&]<size_t... All>(std::index_sequence<All...>)
+			{
+				ForEachChunk<All...>(std::forward<Fn>(fn));
+			}(std::index_sequence_for<Types...>{});
+		}
+		else
+		{
+			for (size_t chunk = 0, count = ChunkCount(); chunk < count; ++chunk)
+			{
+				fn(chunk << ChunkShift, ChunkColumn<Is>(chunk)...);
+			}
+		}
+	}
+
+	// ---------- 容量操作 ----------
+	size_t Size() const noexcept { return size; }
+	size_t Capacity() const noexcept { return chunks.size() << ChunkShift; }
+	bool IsEmpty() const noexcept { return size == 0; }
+
+	// @brief 预留至少 new_capacity 行；只追加块，不移动已有行。
+	void Reserve(size_t new_capacity)
+	{
+		size_t needed = (new_capacity + RowMask) >> ChunkShift;
+		chunks.reserve(needed);
+		while (chunks.size() < needed)
+		{
+			chunks.push_back(pool->Acquire());
+		}
+	}
+
+	// @brief 将 Size() 之后的空块归还块池。
+	void ShrinkToFit()
+	{
+		ReleaseChunksFrom(ChunkCount());
+		chunks.shrink_to_fit();
+	}
+
+	// ---------- 修改操作 ----------
+	// @brief 清空所有元素（块保留）。
+	void Clear()
+	{
+		DestroyRange(0, size);
+		size = 0;
+	}
+
+	// @brief 改变行数：新增行默认构造，多余行析构（块保留，需要时调用 ShrinkToFit）。
+	void Resize(size_t new_size)
+	{
+		if (new_size < size)
+		{
+			DestroyRange(new_size, size);
+			size = new_size;
+			return;
+		}
+
+		Reserve(new_size);
+		while (size < new_size)
+		{
+			EmplaceRow([&]<size_t... Is>(std::index_sequence<Is...>, size_t row)
+			{
+				(std::construct_at(&Get<Is>(row)), ...);
+			});
+		}
+	}
+
+	void PushBack(Types... args)
+	{
+		PushBack(std::make_tuple(std::forward<Types>(args)...));
+	}
+
+	void PushBack(std::tuple<Types...> args)
+	{
+		EmplaceRow([&]<size_t... Is>(std::index_sequence<Is...>, size_t row)
+		{
+			(std::construct_at(&Get<Is>(row), std::get<Is>(std::move(args))), ...);
+		});
+	}
+
+	// @brief 移除末尾一行。
+	void PopBack()
+	{
+		if (size == 0)
+			throw std::out_of_range("SoaChunkedArray::PopBack");
+		DestroyRange(size - 1, size);
+		--size;
+	}
+
+	// @brief 将另一个数组的所有行拷贝追加到末尾。
+	void Append(const BasicSoaChunkedArray& other)
+	{
+		Reserve(size + other.size);
+		for (size_t i = 0, count = other.size; i < count; ++i)
+		{
+			EmplaceRow([&]<size_t... Is>(std::index_sequence<Is...>, size_t row)
+			{
+				(std::construct_at(&Get<Is>(row), other.template Get<Is>(i)), ...);
+			});
+		}
+	}
+
+	void Swap(BasicSoaChunkedArray& other) noexcept
+	{
+		std::swap(chunks, other.chunks);
+		std::swap(pool, other.pool);
+		std::swap(size, other.size);
+	}
+
+private:
+	std::vector<std::byte*> chunks;
+	SoaChunkPool* pool = nullptr;
+	size_t size = 0;
+
+	size_t RowsInChunk(size_t chunk) const noexcept
+	{
+		size_t first = chunk << ChunkShift;
+		return std::min(ChunkRows, size - first);
+	}
+
+	template <size_t I>
+	auto* ChunkColumnData(size_t chunk) noexcept
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		return std::assume_aligned<ColumnAligns[I]>(reinterpret_cast<Type*>(chunks[chunk] + ColumnOffsets[I]));
+	}
+
+	template <size_t I>
+	const auto* ChunkColumnData(size_t chunk) const noexcept
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		return std::assume_aligned<ColumnAligns[I]>(reinterpret_cast<const Type*>(chunks[chunk] + ColumnOffsets[I]));
+	}
+
+	// 在末尾构造一行：construct(index_sequence, row) 依次构造各列；
+	// 某列构造抛出异常时析构该行已构造的列
+	template <typename ConstructFn>
+	void EmplaceRow(ConstructFn&& construct)
+	{
+		if (size == Capacity())
+		{
+			// 先为块指针预留空间再取块：push_back 不会再抛出，取到的块不会泄漏
+			if (chunks.size() == chunks.capacity())
+				chunks.reserve(std::max<size_t>(4, chunks.capacity() * 2));
+			std::byte* chunk = pool->Acquire();
+			chunks.push_back(chunk);
+		}
+
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			size_t constructed = 0;
+			try
+			{
+				((construct(std::index_sequence<Is>{}, size), ++constructed), ...);
+			}
+			catch (...)
+			{
+				size_t column = 0;
+				((column++ < constructed ? std::destroy_at(&Get<Is>(size)) : void()), ...);
+				throw;
+			}
+		}(std::index_sequence_for<Types...>{});
+		++size;
+	}
+
+	// 逐行析构 [begin, end)
+	void DestroyRange(size_t begin, size_t end)
+	{
+		if constexpr (!(std::is_trivially_destructible_v<Types> && ...))
+		{
+			for (size_t row = begin; row < end; ++row)
+			{
+				[&]<size_t... Is>(std::index_sequence<Is...>)
+				{
+					(std::destroy_at(&Get<Is>(row)), ...);
+				}(std::index_sequence_for<Types...>{});
+			}
+		}
+	}
+
+	// 将第 first 块及之后的块归还块池
+	void ReleaseChunksFrom(size_t first)
+	{
+		while (chunks.size() > first)
+		{
+			pool->Release(chunks.back());
+			chunks.pop_back();
+		}
+	}
+};
+
+// 默认分块：每块 1024 行
+template <typename... Types>
+using SoaChunkedArray = BasicSoaChunkedArray<1024, Types...>;
+
+template <size_t ChunkRows, typename... Types>
+void swap(BasicSoaChunkedArray<ChunkRows, Types...>& a, BasicSoaChunkedArray<ChunkRows, Types...>& b) noexcept
+{
+	a.Swap(b);
+}
+} // namespace Core
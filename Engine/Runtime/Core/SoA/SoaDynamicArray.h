@@ -1,48 +1,100 @@
 #pragma once
 
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <type_traits>
 #include <tuple>
 #include <stdexcept>
 #include <new>
 #include <utility>
 #include <algorithm>
+#include <functional>
+#include <vector>
 
 namespace Core
 {
+// @brief SoA 数组的列内存布局。
+enum class ESoaLayout : uint8_t
+{
+	SeparateColumns, // 每列独立分配，扩容时每列一次分配 / 释放
+	SingleBlock,     // 所有列位于同一块内存，按偏移排布，扩容时只分配 / 释放一次
+};
+
+// @brief 可平凡重定位（trivially relocatable）：对象可以按字节搬到新地址，旧位置无需析构。
+// @note 默认等价于 is_trivially_copyable；对 std::unique_ptr 等自身不含内部指针的类型可特化为 true_type，
+//       扩容时该列退化为一次 memcpy。含自引用指针的类型（如 libstdc++ 的 std::string）不可特化。
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
 // @brief 高性能 SoA（Structure of Arrays）动态数组。
+// @tparam Layout 列内存布局，见 ESoaLayout。
 // @tparam Types 存储的列类型列表。
-// @note 内存布局：每列独立分配，确保类型对齐；支持非平凡析构类型。
-template <typename... Types>
-class alignas(std::max_align_t) SoaDynamicArray
+// @note 内存布局：每列起始地址按 ColumnAlignment（64 字节）对齐，
+//       列大小向上取整到 ColumnAlignment 的倍数（SIMD 尾部填充）；支持非平凡析构类型。
+//       列内存来自构造时传入的 std::pmr::memory_resource（默认为 get_default_resource()），
+//       例如每帧重置的 SoaFrameArena 或大页支持的 SoaHugePageResource（见 SoaMemoryResource.h）。
+//       通常通过别名 SoaDynamicArray（每列独立分配）或 SoaBlockArray（单块分配）使用。
+template <ESoaLayout Layout, typename... Types>
+class alignas(std::max_align_t) BasicSoaDynamicArray
 {
 public:
 	using value_types = std::tuple<Types...>;
 	static constexpr size_t NumTypes = sizeof...(Types);
+	static constexpr ESoaLayout LayoutMode = Layout;
+
+	// 列起始地址的对齐（字节），一条缓存行，也满足 AVX2 / AVX-512 的对齐加载
+	static constexpr size_t ColumnAlignment = 64;
+
+	// ForEachColumnChunk 的默认块行数
+	static constexpr size_t DefaultChunkRows = 1024;
+
+	// 类型 T 在 Types 中的下标；不存在时为 NumTypes
+	template <typename T>
+	static constexpr size_t IndexOfType = []
+	{
+		size_t index = NumTypes, i = 0;
+		((index = (index == NumTypes && std::is_same_v<T, Types>) ? i : index, ++i), ...);
+		return index;
+	}();
 
 	// ---------- 构造 / 析构 ----------
-	SoaDynamicArray() = default;
+	BasicSoaDynamicArray() = default;
 
-	~SoaDynamicArray()
+	// @brief 使用指定的内存资源分配列内存；resource 须比数组活得更久。
+	explicit BasicSoaDynamicArray(std::pmr::memory_resource* resource) noexcept
+		: resource(resource)
+	{
+	}
+
+	~BasicSoaDynamicArray()
 	{
 		DestroyAllElements();
 		FreeAllColumns();
 	}
 
-	// 拷贝构造（深拷贝）
-	SoaDynamicArray(const SoaDynamicArray& other)
-		: capacity(other.size), size(other.size)
+	// 拷贝构造（深拷贝），与 std::pmr 容器一致，副本使用默认内存资源
+	BasicSoaDynamicArray(const BasicSoaDynamicArray& other)
+		: BasicSoaDynamicArray(other, std::pmr::get_default_resource())
+	{
+	}
+
+	// 拷贝构造到指定内存资源
+	BasicSoaDynamicArray(const BasicSoaDynamicArray& other, std::pmr::memory_resource* resource)
+		: resource(resource), capacity(other.size), size(other.size)
 	{
 		if (size == 0) return;
 
 		// 分配内存
-		for (size_t i = 0; i < NumTypes; ++i)
-		{
-			data_arrays[i] = static_cast<std::byte*>(
-				::operator new(size * GetElementSize(i), GetElementAlign(i)));
-		}
+		data_arrays = AllocateColumns(size);
 
 		// 拷贝构造每个元素
 		try
@@ -61,30 +113,31 @@ public:
 		}
 	}
 
-	SoaDynamicArray& operator=(const SoaDynamicArray& other)
+	BasicSoaDynamicArray& operator=(const BasicSoaDynamicArray& other)
 	{
 		if (this != &other)
 		{
-			// 使用 copy-and-swap 惯用法提供强异常保证
-			SoaDynamicArray temp(other);
+			// 使用 copy-and-swap 惯用法提供强异常保证；保留本数组的内存资源
+			BasicSoaDynamicArray temp(other, resource);
 			Swap(temp);
 		}
 		return *this;
 	}
 
-	// 移动构造 / 赋值
-	SoaDynamicArray(SoaDynamicArray&& other) noexcept
-		: data_arrays(std::exchange(other.data_arrays, {}))
+	// 移动构造 / 赋值：内存连同其内存资源一起转移
+	BasicSoaDynamicArray(BasicSoaDynamicArray&& other) noexcept
+		: resource(other.resource)
+		, data_arrays(std::exchange(other.data_arrays, {}))
 		, capacity(std::exchange(other.capacity, 0))
 		, size(std::exchange(other.size, 0))
 	{
 	}
 
-	SoaDynamicArray& operator=(SoaDynamicArray&& other) noexcept
+	BasicSoaDynamicArray& operator=(BasicSoaDynamicArray&& other) noexcept
 	{
 		if (this != &other)
 		{
-			SoaDynamicArray temp(std::move(other));
+			BasicSoaDynamicArray temp(std::move(other));
 			Swap(temp);
 		}
 		return *this;
@@ -119,12 +172,94 @@ public:
 		return (*this)[index];
 	}
 
+	// ---------- 列访问 ----------
+	// @brief 返回第 I 列的连续视图，长度为 Size()。
+	// @note 起始地址按 ColumnAlignment 对齐，分配大小是 ColumnAlignment 的倍数：
+	//       从列内任一对齐位置开始的整块 SIMD 加载不会越过分配边界（Size() 之后的值未定义）。
+	//       扩容（PushBack / Reserve / Resize）后视图失效。
+	template <size_t I>
+	std::span<std::tuple_element_t<I, value_types>> Column() noexcept
+	{
+		return {ColumnData<I>(), size};
+	}
+
+	template <size_t I>
+	std::span<const std::tuple_element_t<I, value_types>> Column() const noexcept
+	{
+		return {ColumnData<I>(), size};
+	}
+
+	// @brief 按类型取列，要求 T 在 Types 中恰好出现一次。
+	template <typename T>
+	std::span<T> Column() noexcept
+	{
+		static_assert((std::is_same_v<T, Types> + ...) == 1, "SoaDynamicArray::Column<T> — T 必须在列类型中恰好出现一次");
+		return Column<IndexOfType<T>>();
+	}
+
+	template <typename T>
+	std::span<const T> Column() const noexcept
+	{
+		static_assert((std::is_same_v<T, Types> + ...) == 1, "SoaDynamicArray::Column<T> — T 必须在列类型中恰好出现一次");
+		return Column<IndexOfType<T>>();
+	}
+
+	// @brief 按块遍历列 Is...（为空时遍历全部列），fn(size_t first_row, std::span<T>... columns)。
+	// @param chunk_rows 每块行数，向上取整到 ColumnAlignment 的倍数，
+	//        使每块在所有列中都从 64 字节边界开始；除最后一块外每块恰好 chunk_rows 行。
+	// @note 块内长度为实际行数；最后一块尾部可按 ColumnAlignment 整块读取（见 Column）。
+	template <size_t... Is, typename Fn>
+	void ForEachColumnChunk(Fn&& fn, size_t chunk_rows = DefaultChunkRows)
+	{
+		if constexpr (sizeof...(Is) == 0)
+		{
+			[&]<size_t... All>(std::index_sequence<All...>)
+			{
+				ForEachColumnChunk<All...>(std::forward<Fn>(fn), chunk_rows);
+			}(std::index_sequence_for<Types...>{});
+		}
+		else
+		{
+			chunk_rows = AlignChunkRows(chunk_rows);
+			for (size_t first = 0; first < size; first += chunk_rows)
+			{
+				size_t count = std::min(chunk_rows, size - first);
+				fn(first, std::span<std::tuple_element_t<Is, value_types>>(ColumnData<Is>() + first, count)...);
+			}
+		}
+	}
+
+	template <size_t... Is, typename Fn>
+	void ForEachColumnChunk(Fn&& fn, size_t chunk_rows = DefaultChunkRows) const
+	{
+		if constexpr (sizeof...(Is) == 0)
+		{
+			[&]<size_t... All>(std::index_sequence<All...>)
+			{
+				ForEachColumnChunk<All...>(std::forward<Fn>(fn), chunk_rows);
+			}(std::index_sequence_for<Types...>{});
+		}
+		else
+		{
+			chunk_rows = AlignChunkRows(chunk_rows);
+			for (size_t first = 0; first < size; first += chunk_rows)
+			{
+				size_t count = std::min(chunk_rows, size - first);
+				fn(first, std::span<const std::tuple_element_t<Is, value_types>>(ColumnData<Is>() + first, count)...);
+			}
+		}
+	}
+
 	// ---------- 容量操作 ----------
 	size_t Size() const noexcept { return size; }
 	size_t Capacity() const noexcept { return capacity; }
 	bool IsEmpty() const noexcept { return size == 0; }
 
+	// @brief 列内存所用的内存资源。
+	std::pmr::memory_resource* GetResource() const noexcept { return resource; }
+
 	// @brief 预留至少 new_capacity 的存储空间。
+	// @note 转移元素时抛出异常（不可 nothrow 移动的列拷贝失败）则数组保持不变。
 	void Reserve(size_t new_capacity)
 	{
 		if (new_capacity <= capacity) return;
@@ -138,10 +273,9 @@ public:
 		if (size == 0)
 		{
 			FreeAllColumns();
-			capacity = 0;
 			return;
 		}
-		GrowTo(size); // 重新分配为刚好 size 大小
+		ReallocateTo(size); // 重新分配为刚好 size 大小
 	}
 
 	// ---------- 修改操作 ----------
@@ -192,12 +326,21 @@ public:
 	}
 
 	void PushBack(Types... args) {
-		PushBack(std::make_tuple(std::forward<Types>(args)...));
+		EmplaceBack(std::move(args)...);
 	}
 
 	void PushBack(std::tuple<Types...> args)
 	{
-		static_assert(sizeof...(Types) == NumTypes, "Number of arguments must match number of types");
+		std::apply([this](Types&... values) { EmplaceBack(std::move(values)...); }, args);
+	}
+
+	// @brief 在末尾构造一行，第 I 列由第 I 个参数构造。
+	// @note 构造可能抛异常的列先于 nothrow 列构造；失败时析构已构造的列，数组保持不变。
+	//       因此以右值传入的参数只有在之后不会再抛异常时才会被移走。
+	template <typename... Args>
+	void EmplaceBack(Args&&... args)
+	{
+		static_assert(sizeof...(Args) == NumTypes, "Number of arguments must match number of types");
 
 		if (size >= capacity)
 		{
@@ -205,22 +348,30 @@ public:
 			GrowTo(new_cap);
 		}
 
-		// RAII 守卫：若构造失败，回退已构造的对象
-		struct ConstructGuard
+		auto arg_refs = std::forward_as_tuple(std::forward<Args>(args)...);
+		std::array<bool, NumTypes> constructed{};
+		try
 		{
-			SoaDynamicArray* self;
-			size_t constructed_count = 0;
-			~ConstructGuard() {
-				if (constructed_count < NumTypes) {
-					// 析构已构造的当前元素（索引为 self->size）
-					self->DestroySingleAt(self->size);
-				}
-			}
-		} guard{this, 0};
+			[&]<size_t... Is>(std::index_sequence<Is...>)
+			{
+				((EmplaceMayThrow<Is, Args...>
+					? (void)(ConstructAt<Is>(size, std::get<Is>(std::move(arg_refs))), constructed[Is] = true)
+					: void()), ...);
+			}(std::index_sequence_for<Types...>{});
+		}
+		catch (...)
+		{
+			[&]<size_t... Is>(std::index_sequence<Is...>)
+			{
+				((constructed[Is] ? std::destroy_at((std::tuple_element_t<Is, value_types>*)(data_arrays[Is]) + size)
+				                  : void()), ...);
+			}(std::index_sequence_for<Types...>{});
+			throw;
+		}
 
 		[&]<size_t... Is>(std::index_sequence<Is...>)
 		{
-			((ConstructAt<Is>(size, std::get<Is>(args)), ++guard.constructed_count), ...);
+			((EmplaceMayThrow<Is, Args...> ? void() : ConstructAt<Is>(size, std::get<Is>(std::move(arg_refs)))), ...);
 		}(std::index_sequence_for<Types...>{});
 
 		++size;
@@ -246,8 +397,69 @@ public:
 		--size;
 	}
 
+	// @brief 无序移除：用最后一个元素填补 index 处的空位，O(1)。
+	// @note 会改变原末尾元素的下标（变为 index）。
+	void SwapRemoveAt(size_t index)
+	{
+		if (index >= size)
+			throw std::out_of_range("SoaDynamicArray::SwapRemoveAt");
+
+		size_t last = size - 1;
+		if (index != last)
+		{
+			MoveRow(index, last);
+		}
+		DestroySingleAt(last);
+		--size;
+	}
+
+	// @brief 移除所有满足 pred(row) 的元素，保持其余元素的相对顺序。
+	// @param pred 接收行视图 tuple<Types&...>，返回 true 表示移除。
+	// @return 移除的元素个数。
+	// @note 单次线性遍历：保留的行逐列前移到写指针处，尾部统一析构。
+	template <typename Pred>
+	size_t EraseIf(Pred&& pred)
+	{
+		size_t write = 0;
+		for (size_t read = 0; read < size; ++read)
+		{
+			if (pred((*this)[read]))
+				continue;
+			if (write != read)
+				MoveRow(write, read);
+			++write;
+		}
+		return TruncateTo(write);
+	}
+
+	// @brief 按下标批量移除，保持其余元素的相对顺序。
+	// @param indices 升序且不重复的下标，均须小于 Size()。
+	// @return 移除的元素个数。
+	// @note 单次线性遍历，O(Size())；逐个 RemoveAt 则是 O(Size() * indices.size())。
+	size_t RemoveIndices(std::span<const size_t> indices)
+	{
+		if (indices.empty()) return 0;
+		if (!std::is_sorted(indices.begin(), indices.end()) || indices.back() >= size ||
+			std::adjacent_find(indices.begin(), indices.end()) != indices.end())
+			throw std::invalid_argument("SoaDynamicArray::RemoveIndices — 下标须升序、不重复且小于 Size()");
+
+		size_t write = indices.front();
+		size_t next = 0;
+		for (size_t read = indices.front(); read < size; ++read)
+		{
+			if (next < indices.size() && indices[next] == read)
+			{
+				++next;
+				continue;
+			}
+			MoveRow(write, read);
+			++write;
+		}
+		return TruncateTo(write);
+	}
+
 	// @brief 将另一个数组的所有元素追加到末尾。
-	void Append(const SoaDynamicArray& other)
+	void Append(const BasicSoaDynamicArray& other)
 	{
 		if (other.size == 0) return;
 
@@ -275,9 +487,115 @@ public:
 		size = new_size;
 	}
 
-	// @brief 交换两个数组的内容。
-	void Swap(SoaDynamicArray& other) noexcept
+	// ---------- 重排 ----------
+	// @brief 按第 I 列排序所有列（稳定排序）。
+	// @param cmp 键比较器。键为整数 / 浮点且 cmp 为 std::less / std::greater 时使用基数排序，
+	//        否则对下标排列做 std::stable_sort；不会构造行 tuple。
+	// @note 先求出排列，再对每列做一次 gather（见 ApplyPermutation）。
+	template <size_t I, typename Compare = std::less<>>
+	void SortBy(Compare cmp = {})
+	{
+		if (size < 2) return;
+		std::vector<size_t> order = SortedOrder<I>(std::move(cmp));
+		PermuteRows(order); // order 由本数组生成，必为排列
+	}
+
+	template <typename T, typename Compare = std::less<>>
+	void SortBy(Compare cmp = {})
+	{
+		static_assert((std::is_same_v<T, Types> + ...) == 1, "SoaDynamicArray::SortBy<T> — T 必须在列类型中恰好出现一次");
+		SortBy<IndexOfType<T>>(std::move(cmp));
+	}
+
+	// @brief 返回按第 I 列排序后的行下标排列（不修改数组）。
+	template <size_t I, typename Compare = std::less<>>
+	std::vector<size_t> SortedOrder([[maybe_unused]] Compare cmp = {}) const
+	{
+		using Key = std::tuple_element_t<I, value_types>;
+		const Key* keys = ColumnData<I>();
+
+		if constexpr (IsRadixSortable<Key, Compare>)
+		{
+			return RadixSortOrder(keys, size, IsDescending<Key, Compare>);
+		}
+		else
+		{
+			std::vector<size_t> order(size);
+			for (size_t i = 0; i < size; ++i) order[i] = i;
+			std::stable_sort(order.begin(), order.end(),
+				[&](size_t a, size_t b) { return cmp(keys[a], keys[b]); });
+			return order;
+		}
+	}
+
+	// @brief 原地重排：新的第 k 行为原第 order[k] 行。
+	// @param order [0, Size()) 的一个排列。
+	// @throw std::invalid_argument order 长度不等于 Size()，或含越界 / 重复下标；此时数组不变。
+	// @note 每列一次 gather 到新内存（可平凡重定位的列按字节搬运），随后释放旧内存。
+	void ApplyPermutation(std::span<const size_t> order)
+	{
+		if (order.size() != size)
+			throw std::invalid_argument("SoaDynamicArray::ApplyPermutation — 排列长度须等于 Size()");
+		// 重定位式 gather 每个源行只能搬运一次，越界或重复下标会读越界 / 重复析构
+		std::vector<bool> seen(size);
+		for (size_t index : order)
+		{
+			if (index >= size || seen[index])
+				throw std::invalid_argument("SoaDynamicArray::ApplyPermutation — order 须为 [0, Size()) 的排列");
+			seen[index] = true;
+		}
+		PermuteRows(order);
+	}
+
+	// @brief 按下标选取行，返回新数组：第 k 行为本数组第 indices[k] 行的拷贝。
+	// @param indices 下标均须小于 Size()，可重复、可乱序。
+	BasicSoaDynamicArray Gather(std::span<const size_t> indices) const
+	{
+		for (size_t index : indices)
+		{
+			if (index >= size)
+				throw std::out_of_range("SoaDynamicArray::Gather");
+		}
+
+		BasicSoaDynamicArray result(resource);
+		if (indices.empty()) return result;
+		result.data_arrays = result.AllocateColumns(indices.size());
+		result.capacity = indices.size();
+		try
+		{
+			result.template GatherColumns</*Relocate=*/false>(result.data_arrays, data_arrays, indices);
+		}
+		catch (...)
+		{
+			result.FreeColumns(result.data_arrays, indices.size());
+			throw;
+		}
+		result.size = indices.size();
+		return result;
+	}
+
+	// @brief 按下标回写：本数组第 indices[k] 行被赋值为 source 第 k 行。
+	// @param indices 长度须等于 source.Size()，下标均须小于 Size()；重复下标以最后一次为准。
+	void Scatter(std::span<const size_t> indices, const BasicSoaDynamicArray& source)
+	{
+		if (indices.size() != source.size)
+			throw std::invalid_argument("SoaDynamicArray::Scatter — 下标个数须等于 source.Size()");
+		for (size_t index : indices)
+		{
+			if (index >= size)
+				throw std::out_of_range("SoaDynamicArray::Scatter");
+		}
+
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			(ScatterColumn<Is>(indices, source), ...);
+		}(std::index_sequence_for<Types...>{});
+	}
+
+	// @brief 交换两个数组的内容（连同内存资源）。
+	void Swap(BasicSoaDynamicArray& other) noexcept
 	{
+		std::swap(resource, other.resource);
 		std::swap(data_arrays, other.data_arrays);
 		std::swap(capacity, other.capacity);
 		std::swap(size, other.size);
@@ -285,6 +603,7 @@ public:
 
 private:
 	// ---------- 内部辅助函数 ----------
+	std::pmr::memory_resource* resource = std::pmr::get_default_resource();
 	std::array<std::byte*, NumTypes> data_arrays{};
 	size_t capacity = 0;
 	size_t size = 0;
@@ -299,17 +618,138 @@ private:
 	template <size_t I>
 	static constexpr size_t GetElementSize() { return sizeof(std::tuple_element_t<I, value_types>); }
 
-	// 获取第 I 列的对齐要求
+	// 按已校验的排列重排所有列
+	void PermuteRows(std::span<const size_t> order)
+	{
+		if (size == 0) return;
+
+		std::array<std::byte*, NumTypes> new_arrays = AllocateColumns(capacity);
+		try
+		{
+			GatherColumns</*Relocate=*/true>(new_arrays, data_arrays, order);
+		}
+		catch (...)
+		{
+			FreeColumns(new_arrays, capacity);
+			throw;
+		}
+		FreeColumns(data_arrays, capacity);
+		data_arrays = new_arrays;
+	}
+
+	// 获取第 I 列内存的对齐要求（不低于 ColumnAlignment）
 	static constexpr std::align_val_t GetElementAlign(size_t i)
 	{
-		constexpr std::array<std::align_val_t, NumTypes> aligns = {std::align_val_t(alignof(Types))...};
+		constexpr std::array<std::align_val_t, NumTypes> aligns = {
+			std::align_val_t(std::max(alignof(Types), ColumnAlignment))...};
 		return aligns[i];
 	}
 
 	template <size_t I>
 	static constexpr std::align_val_t GetElementAlign()
 	{
-		return std::align_val_t(alignof(std::tuple_element_t<I, value_types>));
+		return std::align_val_t(std::max(alignof(std::tuple_element_t<I, value_types>), ColumnAlignment));
+	}
+
+	// 第 i 列容纳 count 个元素所需的字节数，向上取整到 ColumnAlignment（尾部填充）
+	static constexpr size_t GetColumnBytes(size_t i, size_t count)
+	{
+		return (count * GetElementSize(i) + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment;
+	}
+
+	// SingleBlock 布局整块的对齐：各列对齐要求的最大值
+	static constexpr std::align_val_t BlockAlign = std::align_val_t(std::max({ColumnAlignment, alignof(Types)...}));
+
+	// SingleBlock 布局：计算 count 行时各列在块内的偏移，返回块的总字节数
+	static constexpr size_t GetBlockLayout(size_t count, std::array<size_t, NumTypes>& offsets)
+	{
+		size_t offset = 0;
+		for (size_t i = 0; i < NumTypes; ++i)
+		{
+			size_t align = static_cast<size_t>(GetElementAlign(i));
+			offset = (offset + align - 1) / align * align;
+			offsets[i] = offset;
+			offset += GetColumnBytes(i, count);
+		}
+		return offset;
+	}
+
+	// 从 resource 为 count 行分配列内存（未构造）
+	std::array<std::byte*, NumTypes> AllocateColumns(size_t count)
+	{
+		std::array<std::byte*, NumTypes> columns{};
+		if constexpr (Layout == ESoaLayout::SingleBlock)
+		{
+			std::array<size_t, NumTypes> offsets{};
+			size_t total = GetBlockLayout(count, offsets);
+			auto* block = static_cast<std::byte*>(resource->allocate(total, static_cast<size_t>(BlockAlign)));
+			for (size_t i = 0; i < NumTypes; ++i)
+			{
+				columns[i] = block + offsets[i];
+			}
+		}
+		else
+		{
+			try
+			{
+				for (size_t i = 0; i < NumTypes; ++i)
+				{
+					columns[i] = static_cast<std::byte*>(
+						resource->allocate(GetColumnBytes(i, count), static_cast<size_t>(GetElementAlign(i))));
+				}
+			}
+			catch (...)
+			{
+				FreeColumns(columns, count);
+				throw;
+			}
+		}
+		return columns;
+	}
+
+	// 释放以 count 行分配的列内存（不析构元素），并将指针清空
+	void FreeColumns(std::array<std::byte*, NumTypes>& columns, size_t count) noexcept
+	{
+		if constexpr (Layout == ESoaLayout::SingleBlock)
+		{
+			// 第 0 列位于块首
+			std::array<size_t, NumTypes> offsets{};
+			if (columns[0])
+				resource->deallocate(columns[0], GetBlockLayout(count, offsets), static_cast<size_t>(BlockAlign));
+		}
+		else
+		{
+			for (size_t i = 0; i < NumTypes; ++i)
+			{
+				if (columns[i])
+					resource->deallocate(columns[i], GetColumnBytes(i, count), static_cast<size_t>(GetElementAlign(i)));
+			}
+		}
+		columns = {};
+	}
+
+	// 块行数向上取整到 ColumnAlignment 的倍数：任意列中块起始偏移都是 64 字节的倍数
+	static constexpr size_t AlignChunkRows(size_t rows)
+	{
+		rows = std::max<size_t>(rows, 1);
+		return (rows + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment;
+	}
+
+	// 获取第 I 列的首元素指针
+	template <size_t I>
+	auto* ColumnData() noexcept
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		return std::assume_aligned<static_cast<size_t>(GetElementAlign<I>())>(
+			reinterpret_cast<Type*>(data_arrays[I]));
+	}
+
+	template <size_t I>
+	const auto* ColumnData() const noexcept
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		return std::assume_aligned<static_cast<size_t>(GetElementAlign<I>())>(
+			reinterpret_cast<const Type*>(data_arrays[I]));
 	}
 
 	// 获取第 I 列第 idx 个元素的引用
@@ -317,14 +757,14 @@ private:
 	auto& GetRef(size_t index)
 	{
 		using Type = std::tuple_element_t<I, value_types>;
-		return (Type*)(data_arrays[I])[index];
+		return reinterpret_cast<Type*>(data_arrays[I])[index];
 	}
 
 	template <size_t I>
 	const auto& GetConstRef(size_t index) const
 	{
 		using Type = std::tuple_element_t<I, value_types>;
-		return (const Type*)(data_arrays[I])[index];
+		return reinterpret_cast<const Type*>(data_arrays[I])[index];
 	}
 
 	// 构建 tuple 返回
@@ -389,107 +829,130 @@ private:
 	// 释放所有列内存
 	void FreeAllColumns()
 	{
-		for (size_t i = 0; i < NumTypes; ++i)
-		{
-			if (data_arrays[i])
-			{
-				::operator delete(data_arrays[i], GetElementAlign(i));
-				data_arrays[i] = nullptr;
-			}
-		}
+		FreeColumns(data_arrays, capacity);
+		capacity = 0;
 	}
 
 	// 扩容至 new_capacity
 	void GrowTo(size_t new_capacity)
 	{
 		if (new_capacity <= capacity) return;
+		ReallocateTo(new_capacity);
+	}
 
-		std::array<std::byte*, NumTypes> new_arrays{};
-		// 分配新内存
-		for (size_t i = 0; i < NumTypes; ++i)
-		{
-			new_arrays[i] = static_cast<std::byte*>(
-				::operator new(new_capacity * GetElementSize(i), GetElementAlign(i)));
-		}
+	// 重新分配为 new_capacity（new_capacity >= size），转移现有元素
+	void ReallocateTo(size_t new_capacity)
+	{
+
+		// 分配新内存（SingleBlock 布局只分配一次）
+		std::array<std::byte*, NumTypes> new_arrays = AllocateColumns(new_capacity);
 
 		// RAII 守卫：若转移过程抛出异常，释放新内存
 		struct NewMemoryGuard
 		{
+			BasicSoaDynamicArray* self;
 			std::array<std::byte*, NumTypes>& arrays;
-			size_t count = NumTypes;
+			size_t count;
+			bool active = true;
 			~NewMemoryGuard()
 			{
-				for (size_t i = 0; i < count; ++i)
-				{
-					::operator delete(arrays[i], GetElementAlign(i));
-				}
+				if (active)
+					self->FreeColumns(arrays, count);
 			}
-		} guard{new_arrays, NumTypes};
+		} guard{this, new_arrays, new_capacity};
 
 		if (size > 0)
 		{
-			// 转移现有元素到新内存
+			// 转移现有元素到新内存。与 GatherColumns 相同分两阶段：
+			// 先拷贝可能抛异常的列，此时旧元素尚未被移动或析构，失败时析构已拷贝的新元素即可回滚；
+			// 其余列的按字节搬运 / nothrow 移动不会抛出。拷贝列的旧元素在全部列转移完成后才析构。
+			std::array<size_t, NumTypes> constructed{};
+			try
+			{
+				[&]<size_t... Is>(std::index_sequence<Is...>)
+				{
+					((GatherMayThrow<std::tuple_element_t<Is, value_types>, true>
+						? TransferColumn<Is>(new_arrays[Is], constructed[Is])
+						: void()), ...);
+				}(std::index_sequence_for<Types...>{});
+			}
+			catch (...)
+			{
+				[&]<size_t... Is>(std::index_sequence<Is...>)
+				{
+					((std::destroy_n((std::tuple_element_t<Is, value_types>*)(new_arrays[Is]), constructed[Is])), ...);
+				}(std::index_sequence_for<Types...>{});
+				throw;
+			}
+
 			[&]<size_t... Is>(std::index_sequence<Is...>)
 			{
-				(TransferColumn<Is>(new_arrays[Is], new_capacity), ...);
+				((GatherMayThrow<std::tuple_element_t<Is, value_types>, true>
+					? void()
+					: TransferColumn<Is>(new_arrays[Is], constructed[Is])), ...);
+				(DestroyCopiedColumn<Is>(), ...);
 			}(std::index_sequence_for<Types...>{});
 		}
 
 		// 释放旧内存
-		for (size_t i = 0; i < NumTypes; ++i)
-		{
-			if (data_arrays[i])
-				::operator delete(data_arrays[i], GetElementAlign(i));
-		}
+		FreeColumns(data_arrays, capacity);
 
 		data_arrays = new_arrays;
 		capacity = new_capacity;
 		// 守卫失效，新内存已移交
-		guard.count = 0;
+		guard.active = false;
 	}
 
-	// 转移第 I 列数据到新内存
+	// 扩容时第 I 列是否走逐元素拷贝（既不可平凡重定位，移动构造也不是 noexcept）
+	template <size_t I>
+	static constexpr bool TransferByCopy = !IsTriviallyRelocatableV<std::tuple_element_t<I, value_types>> &&
+		!std::is_nothrow_move_constructible_v<std::tuple_element_t<I, value_types>>;
+
+	// 转移第 I 列数据到新内存；constructed 记录已在新内存中构造的元素个数
+	// @note 移动构造的旧元素随即析构；拷贝构造的旧元素由 DestroyCopiedColumn 在所有列转移完成后析构
 	template <size_t I>
-	void TransferColumn(std::byte* new_memory, size_t /*new_capacity*/)
+	void TransferColumn(std::byte* new_memory, size_t& constructed)
 	{
 		using Type = std::tuple_element_t<I, value_types>;
 		Type* old_col = (Type*)(data_arrays[I]);
 		Type* new_col = (Type*)(new_memory);
 
-		if constexpr (std::is_trivially_copyable_v<Type>)
+		if constexpr (IsTriviallyRelocatableV<Type>)
 		{
-			// 优化：平凡可复制类型直接 memcpy
-			std::memcpy(new_col, old_col, size * sizeof(Type));
+			// 优化：可平凡重定位类型整列 memcpy，旧位置无需析构
+			std::memcpy(static_cast<void*>(new_col), static_cast<const void*>(old_col), size * sizeof(Type));
+			constructed = size;
 		}
-		else
+		else if constexpr (!TransferByCopy<I>)
 		{
-			// 优先使用移动构造（若 noexcept），否则拷贝构造
-			if constexpr (std::is_nothrow_move_constructible_v<Type>)
+			for (; constructed < size; ++constructed)
 			{
-				for (size_t j = 0; j < size; ++j)
-				{
-					std::construct_at(new_col + j, std::move(old_col[j]));
-				}
+				std::construct_at(new_col + constructed, std::move(old_col[constructed]));
 			}
-			else
-			{
-				for (size_t j = 0; j < size; ++j)
-				{
-					std::construct_at(new_col + j, old_col[j]);
-				}					
-			}
-			// 析构旧对象
-			for (size_t j = 0; j < size; ++j)
+			std::destroy_n(old_col, size);
+		}
+		else
+		{
+			for (; constructed < size; ++constructed)
 			{
-				std::destroy_at(old_col + j);
+				std::construct_at(new_col + constructed, old_col[constructed]);
 			}
-				
+		}
+	}
+
+	// 析构第 I 列中已被拷贝到新内存的旧元素（仅 TransferByCopy 的列）
+	template <size_t I>
+	void DestroyCopiedColumn() noexcept
+	{
+		if constexpr (TransferByCopy<I>)
+		{
+			std::destroy_n((std::tuple_element_t<I, value_types>*)(data_arrays[I]), size);
 		}
 	}
 
 	// 拷贝列（用于拷贝构造）
 	template <size_t I>
-	void CopyColumn(const SoaDynamicArray& other)
+	void CopyColumn(const BasicSoaDynamicArray& other)
 	{
 		using Type = std::tuple_element_t<I, value_types>;
 		const Type* src = (const Type*)(other.data_arrays[I]);
@@ -503,7 +966,7 @@ private:
 
 	// 追加拷贝列（用于 Append）
 	template <size_t I>
-	void CopyAppendColumn(const SoaDynamicArray& other)
+	void CopyAppendColumn(const BasicSoaDynamicArray& other)
 	{
 		using Type = std::tuple_element_t<I, value_types>;
 		const Type* src = (const Type*)(other.data_arrays[I]);
@@ -526,6 +989,228 @@ private:
 		}
 	}
 
+	// ---------- 排序 / gather 辅助 ----------
+	template <typename Key, typename Compare>
+	static constexpr bool IsDescending = std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<Key>>;
+
+	// 整数 / 浮点键配合 std::less / std::greater 时可用基数排序
+	template <typename Key, typename Compare>
+	static constexpr bool IsRadixSortable =
+		(std::is_integral_v<Key> || std::is_floating_point_v<Key>) && !std::is_same_v<Key, bool> &&
+		sizeof(Key) <= sizeof(uint64_t) &&
+		(std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>> ||
+		 std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<Key>>);
+
+	// 将键映射为无符号整数，使无符号比较的顺序与键的 < 一致
+	template <typename Key>
+	static auto RadixKey(Key key) noexcept
+	{
+		using Bits = std::conditional_t<sizeof(Key) <= 4, uint32_t, uint64_t>;
+		constexpr Bits sign_bit = Bits(1) << (sizeof(Key) * 8 - 1);
+		if constexpr (std::is_floating_point_v<Key>)
+		{
+			using Raw = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+			Bits bits = std::bit_cast<Raw>(key);
+			// 负数取反（绝对值越大越小），正数置符号位
+			return (bits & sign_bit) ? Bits(~bits) : Bits(bits | sign_bit);
+		}
+		else if constexpr (std::is_signed_v<Key>)
+		{
+			return Bits(static_cast<std::make_unsigned_t<Key>>(key)) ^ sign_bit;
+		}
+		else
+		{
+			return Bits(key);
+		}
+	}
+
+	// LSD 基数排序（每趟 8 位），返回稳定的行下标排列；所有键在某一字节上相同时跳过该趟
+	template <typename Key>
+	static std::vector<size_t> RadixSortOrder(const Key* keys, size_t count, bool descending)
+	{
+		using Bits = decltype(RadixKey(Key{}));
+		if (count < 2)
+		{
+			// 空数组或单行：恒等排列（下面的直方图趟会读 key_buf[0]）
+			return std::vector<size_t>(count, 0);
+		}
+		std::vector<Bits> key_buf(count), key_tmp(count);
+		std::vector<size_t> order(count), order_tmp(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			// 降序：对取反后的键升序排序，仍保持稳定
+			key_buf[i] = descending ? Bits(~RadixKey(keys[i])) : RadixKey(keys[i]);
+			order[i] = i;
+		}
+
+		for (size_t shift = 0; shift < sizeof(Key) * 8; shift += 8)
+		{
+			std::array<size_t, 256> histogram{};
+			for (size_t i = 0; i < count; ++i)
+			{
+				++histogram[(key_buf[i] >> shift) & 0xFF];
+			}
+			if (histogram[(key_buf[0] >> shift) & 0xFF] == count) continue;
+
+			size_t sum = 0;
+			for (size_t& bucket : histogram)
+			{
+				size_t c = bucket;
+				bucket = sum;
+				sum += c;
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				size_t dst = histogram[(key_buf[i] >> shift) & 0xFF]++;
+				key_tmp[dst] = key_buf[i];
+				order_tmp[dst] = order[i];
+			}
+			key_buf.swap(key_tmp);
+			order.swap(order_tmp);
+		}
+		return order;
+	}
+
+	// 将 src 各列的第 indices[k] 行构造到 dst 各列的第 k 行（dst 为未构造的内存）。
+	// Relocate 为 true 时搬运（src 的所有行随后被析构），否则拷贝。
+	// 搬运时不可 nothrow 移动（且不可平凡重定位）的列改为拷贝，并且先于其余列处理：
+	// 只有这一阶段可能抛异常，此时 src 尚未被移动或按字节搬运，析构 dst 中已拷贝的元素即可回滚；
+	// 第二阶段的 nothrow 移动与按字节搬运不会抛出。
+	template <bool Relocate>
+	void GatherColumns(std::array<std::byte*, NumTypes>& dst, const std::array<std::byte*, NumTypes>& src,
+	                   std::span<const size_t> indices)
+	{
+		std::array<size_t, NumTypes> constructed{};
+		try
+		{
+			[&]<size_t... Is>(std::index_sequence<Is...>)
+			{
+				((GatherMayThrow<std::tuple_element_t<Is, value_types>, Relocate>
+					? GatherColumn<Is, Relocate>(dst[Is], src[Is], indices, constructed[Is])
+					: void()), ...);
+			}(std::index_sequence_for<Types...>{});
+		}
+		catch (...)
+		{
+			[&]<size_t... Is>(std::index_sequence<Is...>)
+			{
+				((std::destroy_n((std::tuple_element_t<Is, value_types>*)(dst[Is]), constructed[Is])), ...);
+			}(std::index_sequence_for<Types...>{});
+			throw;
+		}
+
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			((GatherMayThrow<std::tuple_element_t<Is, value_types>, Relocate>
+				? void()
+				: GatherColumn<Is, Relocate>(dst[Is], src[Is], indices, constructed[Is])), ...);
+		}(std::index_sequence_for<Types...>{});
+
+		if constexpr (Relocate)
+		{
+			// 搬运完成：析构 src 中的旧对象（按字节搬运的列无需析构）
+			[&]<size_t... Is>(std::index_sequence<Is...>)
+			{
+				(DestroyRelocatedColumn<Is>(src[Is]), ...);
+			}(std::index_sequence_for<Types...>{});
+		}
+	}
+
+	// EmplaceBack 中第 I 列由对应参数构造时是否可能抛异常
+	template <size_t I, typename... Args>
+	static constexpr bool EmplaceMayThrow = !std::is_nothrow_constructible_v<
+		std::tuple_element_t<I, value_types>, std::tuple_element_t<I, std::tuple<Args&&...>>>;
+
+	// 该列的 gather 是否可能抛异常（即走逐元素拷贝构造的路径）
+	template <typename Type, bool Relocate>
+	static constexpr bool GatherMayThrow = !std::is_trivially_copyable_v<Type> &&
+		!(Relocate && (IsTriviallyRelocatableV<Type> || std::is_nothrow_move_constructible_v<Type>)) &&
+		!std::is_nothrow_copy_constructible_v<Type>;
+
+	template <size_t I, bool Relocate>
+	void GatherColumn(std::byte* dst_memory, std::byte* src_memory, std::span<const size_t> indices,
+	                  size_t& constructed)
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		Type* dst = (Type*)(dst_memory);
+		Type* src = (Type*)(src_memory);
+
+		if constexpr (std::is_trivially_copyable_v<Type> || (Relocate && IsTriviallyRelocatableV<Type>))
+		{
+			for (size_t k = 0; k < indices.size(); ++k)
+			{
+				std::memcpy(static_cast<void*>(dst + k), static_cast<const void*>(src + indices[k]), sizeof(Type));
+			}
+			constructed = indices.size();
+		}
+		else
+		{
+			for (size_t k = 0; k < indices.size(); ++k)
+			{
+				if constexpr (Relocate && std::is_nothrow_move_constructible_v<Type>)
+					std::construct_at(dst + k, std::move(src[indices[k]]));
+				else
+					std::construct_at(dst + k, std::as_const(src[indices[k]]));
+				++constructed;
+			}
+		}
+	}
+
+	template <size_t I>
+	void DestroyRelocatedColumn(std::byte* memory)
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		if constexpr (!IsTriviallyRelocatableV<Type>)
+		{
+			std::destroy_n((Type*)(memory), size);
+		}
+	}
+
+	template <size_t I>
+	void ScatterColumn(std::span<const size_t> indices, const BasicSoaDynamicArray& source)
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		Type* dst = (Type*)(data_arrays[I]);
+		const Type* src = (const Type*)(source.data_arrays[I]);
+		for (size_t k = 0; k < indices.size(); ++k)
+		{
+			dst[indices[k]] = src[k];
+		}
+	}
+
+	// 将第 src 行的所有列移动赋值到第 dst 行（两行均已构造）
+	void MoveRow(size_t dst, size_t src)
+	{
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			(MoveAssignAt<Is>(dst, src), ...);
+		}(std::index_sequence_for<Types...>{});
+	}
+
+	template <size_t I>
+	void MoveAssignAt(size_t dst, size_t src)
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		Type* col = (Type*)(data_arrays[I]);
+		if constexpr (std::is_nothrow_move_assignable_v<Type>)
+		{
+			col[dst] = std::move(col[src]);
+		}
+		else
+		{
+			col[dst] = col[src];
+		}
+	}
+
+	// 析构 [new_size, size) 并缩小 size，返回移除的元素个数
+	size_t TruncateTo(size_t new_size)
+	{
+		size_t removed = size - new_size;
+		DestroyRange(new_size, size);
+		size = new_size;
+		return removed;
+	}
+
 	// 将索引 index 之后的元素向左移动一位
 	template <size_t I>
 	void MoveElementsLeft(size_t index)
@@ -549,9 +1234,17 @@ private:
 	}
 };
 
-// 全局 swap 特化
+// 每列独立分配的 SoA 数组
+template <typename... Types>
+using SoaDynamicArray = BasicSoaDynamicArray<ESoaLayout::SeparateColumns, Types...>;
+
+// 所有列位于同一块内存的 SoA 数组：扩容只有一次分配
 template <typename... Types>
-void swap(SoaDynamicArray<Types...>& a, SoaDynamicArray<Types...>& b) noexcept
+using SoaBlockArray = BasicSoaDynamicArray<ESoaLayout::SingleBlock, Types...>;
+
+// 全局 swap 特化
+template <ESoaLayout Layout, typename... Types>
+void swap(BasicSoaDynamicArray<Layout, Types...>& a, BasicSoaDynamicArray<Layout, Types...>& b) noexcept
 {
 	a.Swap(b);
 }
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <sys/mman.h>
+	#define CORE_SOA_HAS_MMAP_ANON 1
+#else
+	#define CORE_SOA_HAS_MMAP_ANON 0
+#endif
+
+// SoA 数组可用的 std::pmr::memory_resource 实现。
+//
+//   Core::SoaFrameArena frame_arena(64 << 20);
+//   void Tick()
+//   {
+//       Core::SoaDynamicArray<Vec3, uint32_t> visible(&frame_arena); // 每帧临时数组
+//       ...
+//       // visible 析构后
+//       frame_arena.Reset();
+//   }
+//
+//   // 长期存在的大数组放在 2MB 大页上，减少顺序扫描 / 随机访问时的 TLB 缺失
+//   Core::SoaDynamicArray<float> heights(&Core::GetHugePageResource());
+//
+// 池化分配可直接使用 std::pmr::unsynchronized_pool_resource / synchronized_pool_resource，
+// 或把上述资源作为 SoaChunkPool 的 upstream。
+
+namespace Core
+{
+// @brief 线性（bump）分配器：分配只移动指针，deallocate 为空操作，Reset() 一次性回收全部内存。
+// @note 非线程安全。Reset() 前必须确保从本 arena 分配的数组都已析构（或不再访问）。
+//       容量不足时向 upstream 追加新块；Reset() 会把多个块合并为一个总容量相同的块，
+//       稳定后每帧没有系统分配。
+class SoaFrameArena : public std::pmr::memory_resource
+{
+public:
+	explicit SoaFrameArena(size_t initial_bytes = 1 << 20,
+		std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: upstream(upstream)
+	{
+		AddBlock(std::max<size_t>(initial_bytes, MinBlockBytes));
+	}
+
+	~SoaFrameArena() override { ReleaseBlocks(); }
+
+	SoaFrameArena(const SoaFrameArena&) = delete;
+	SoaFrameArena& operator=(const SoaFrameArena&) = delete;
+
+	// @brief 回收所有分配；若上一帧用到了多个块，合并为一个块。
+	void Reset()
+	{
+		if (blocks.size() > 1)
+		{
+			size_t total = Capacity();
+			ReleaseBlocks();
+			AddBlock(total);
+		}
+		offset = 0;
+		used_before_current = 0;
+	}
+
+	// @brief 自上次 Reset() 以来分配的字节数（含对齐填充）。
+	size_t BytesUsed() const noexcept { return used_before_current + offset; }
+
+	// @brief 所有块的总字节数。
+	size_t Capacity() const noexcept
+	{
+		size_t total = 0;
+		for (const Block& block : blocks)
+			total += block.bytes;
+		return total;
+	}
+
+	size_t BlockCount() const noexcept { return blocks.size(); }
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		Block& current = blocks.back();
+		uintptr_t base = reinterpret_cast<uintptr_t>(current.memory);
+		size_t aligned = (base + offset + alignment - 1) / alignment * alignment - base;
+		if (aligned + bytes > current.bytes)
+		{
+			// 新块至少翻倍，且保证能容纳本次分配
+			used_before_current += current.bytes;
+			AddBlock(std::max(current.bytes * 2, bytes + alignment));
+			return do_allocate(bytes, alignment);
+		}
+		offset = aligned + bytes;
+		return current.memory + aligned;
+	}
+
+	void do_deallocate(void*, size_t, size_t) override {}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+	struct Block
+	{
+		std::byte* memory;
+		size_t bytes;
+	};
+
+	static constexpr size_t MinBlockBytes = 4096;
+	static constexpr size_t BlockAlignment = 4096;
+
+	std::pmr::memory_resource* upstream;
+	std::vector<Block> blocks;
+	size_t offset = 0;              // 当前块（blocks.back()）内已用字节
+	size_t used_before_current = 0; // 之前各块的字节数（用于 BytesUsed）
+
+	void AddBlock(size_t bytes)
+	{
+		bytes = (bytes + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+		blocks.reserve(blocks.size() + 1);
+		blocks.push_back({static_cast<std::byte*>(upstream->allocate(bytes, BlockAlignment)), bytes});
+		offset = 0;
+	}
+
+	void ReleaseBlocks() noexcept
+	{
+		for (const Block& block : blocks)
+			upstream->deallocate(block.memory, block.bytes, BlockAlignment);
+		blocks.clear();
+	}
+};
+
+// @brief 大页内存资源：不小于 threshold 的分配直接映射为 2MB 对齐的匿名内存。
+// @note 优先尝试显式大页（MAP_HUGETLB，需系统预留 vm.nr_hugepages），失败时退化为普通映射
+//       并以 madvise(MADV_HUGEPAGE) 请求透明大页；小分配与不支持 mmap 的平台转给 upstream。
+//       线程安全。映射长度向上取整到 HugePageBytes，适合长期存在的大数组，不适合频繁扩缩容。
+class SoaHugePageResource : public std::pmr::memory_resource
+{
+public:
+	static constexpr size_t HugePageBytes = size_t(2) << 20;
+
+	explicit SoaHugePageResource(size_t threshold = HugePageBytes, bool try_hugetlb = true,
+		std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: threshold(threshold), try_hugetlb(try_hugetlb), upstream(upstream)
+	{
+	}
+
+	SoaHugePageResource(const SoaHugePageResource&) = delete;
+	SoaHugePageResource& operator=(const SoaHugePageResource&) = delete;
+
+	// @brief 通过 MAP_HUGETLB 获得显式大页的分配次数。
+	size_t HugeTlbAllocations() const noexcept { return hugetlb_allocations.load(std::memory_order_relaxed); }
+
+	// @brief 退化为透明大页（MADV_HUGEPAGE）的分配次数。
+	size_t TransparentAllocations() const noexcept { return transparent_allocations.load(std::memory_order_relaxed); }
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		if (!UsesMapping(bytes, alignment))
+			return upstream->allocate(bytes, alignment);
+#if CORE_SOA_HAS_MMAP_ANON
+		size_t length = RoundUp(bytes);
+	#if defined(MAP_HUGETLB)
+		if (try_hugetlb)
+		{
+			void* memory = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (memory != MAP_FAILED)
+			{
+				hugetlb_allocations.fetch_add(1, std::memory_order_relaxed);
+				return memory;
+			}
+		}
+	#endif
+		// 多映射一个大页再裁剪首尾，得到 2MB 对齐、长度为 length 的区域
+		void* raw = ::mmap(nullptr, length + HugePageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED)
+			throw std::bad_alloc();
+		uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+		uintptr_t aligned = (begin + HugePageBytes - 1) / HugePageBytes * HugePageBytes;
+		if (aligned > begin)
+			::munmap(raw, aligned - begin);
+		if (size_t tail = begin + length + HugePageBytes - (aligned + length))
+			::munmap(reinterpret_cast<void*>(aligned + length), tail);
+	#if defined(MADV_HUGEPAGE)
+		::madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+	#endif
+		transparent_allocations.fetch_add(1, std::memory_order_relaxed);
+		return reinterpret_cast<void*>(aligned);
+#else
+		return upstream->allocate(bytes, alignment);
+#endif
+	}
+
+	void do_deallocate(void* memory, size_t bytes, size_t alignment) override
+	{
+		if (!UsesMapping(bytes, alignment))
+		{
+			upstream->deallocate(memory, bytes, alignment);
+			return;
+		}
+#if CORE_SOA_HAS_MMAP_ANON
+		::munmap(memory, RoundUp(bytes));
+#else
+		upstream->deallocate(memory, bytes, alignment);
+#endif
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+	size_t threshold;
+	bool try_hugetlb;
+	std::pmr::memory_resource* upstream;
+	std::atomic<size_t> hugetlb_allocations{0};
+	std::atomic<size_t> transparent_allocations{0};
+
+	// 分配与释放按同一规则分流，释放时无需记录来源
+	bool UsesMapping(size_t bytes, size_t alignment) const noexcept
+	{
+		return bytes >= threshold && alignment <= HugePageBytes;
+	}
+
+	static constexpr size_t RoundUp(size_t bytes) noexcept
+	{
+		return (bytes + HugePageBytes - 1) / HugePageBytes * HugePageBytes;
+	}
+};
+
+// @brief 进程级的大页资源（默认参数），永不析构，可安全用于静态生命周期的数组。
+inline SoaHugePageResource& GetHugePageResource()
+{
+	static SoaHugePageResource* resource = new SoaHugePageResource();
+	return *resource;
+}
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SoaDynamicArray.h"
+
+// 由反射信息生成 SoA 容器：列即结构体经 BEGIN_CLASS / VARIABLES（Reflection/Refect.h）登记的成员，
+// 按登记顺序排列（含基类成员）。列可以按成员指针或成员名访问，不必手动维护列下标。
+//
+//   struct Particle { REFLECT_STATIC_CLASS(); Vec3 position; Vec3 velocity; float life; };
+//   BEGIN_CLASS(Particle, NullBase)
+//       VARIABLES(VARIABLE_FIELD(&Particle::position), VARIABLE_FIELD(&Particle::velocity),
+//                 VARIABLE_FIELD(&Particle::life))
+//   END_CLASS(Particle);
+//
+//   Core::ReflectedSoaArray<Particle> particles;
+//   particles.AppendAoS(spawned);                              // AoS -> SoA，逐列拷贝
+//   for (float& life : particles.Field<&Particle::life>()) ...
+//   auto velocity = particles.Field<"velocity">();             // 按名字取列
+//   particles.ToAoS(std::span(output));                        // SoA -> AoS，逐列写回
+
+// 反射信息主模板（见 Reflection/Refect.h），此处只需声明
+template <typename Ty>
+struct TypeInfo;
+
+namespace Core
+{
+// @brief 编译期成员名，用作 ReflectedSoaArray::Field<"name">() 的模板实参。
+template <size_t N>
+struct SoaFieldName
+{
+	char value[N]{};
+
+	constexpr SoaFieldName(const char (&text)[N])
+	{
+		std::copy_n(text, N, value);
+	}
+
+	constexpr std::string_view View() const { return std::string_view(value, N - 1); }
+};
+
+namespace SoaReflectedDetail
+{
+	template <typename T>
+	inline constexpr auto& Fields = TypeInfo<T>::variables;
+
+	template <typename T>
+	inline constexpr size_t FieldCount = std::tuple_size_v<std::remove_cvref_t<decltype(Fields<T>)>>;
+
+	template <typename T, size_t I>
+	inline constexpr auto FieldPointer = std::get<I>(Fields<T>).pointer;
+
+	template <typename T, size_t I>
+	using FieldType = std::remove_cvref_t<decltype(std::declval<T&>().*FieldPointer<T, I>)>;
+
+	template <ESoaLayout Layout, typename T, typename Indices>
+	struct StorageOf;
+
+	template <ESoaLayout Layout, typename T, size_t... Is>
+	struct StorageOf<Layout, T, std::index_sequence<Is...>>
+	{
+		using type = BasicSoaDynamicArray<Layout, FieldType<T, Is>...>;
+	};
+
+	// 成员指针 Member 在反射列表中的下标；不存在时为 FieldCount
+	template <typename T, auto Member>
+	constexpr size_t IndexOfMember()
+	{
+		return []<size_t... Is>(std::index_sequence<Is...>)
+		{
+			size_t index = FieldCount<T>;
+			auto match = [&]<size_t I>(std::integral_constant<size_t, I>)
+			{
+				if constexpr (std::is_same_v<std::remove_cv_t<decltype(FieldPointer<T, I>)>, decltype(Member)>)
+				{
+					if (index == FieldCount<T> && FieldPointer<T, I> == Member) index = I;
+				}
+			};
+			(match(std::integral_constant<size_t, Is>{}), ...);
+			return index;
+		}(std::make_index_sequence<FieldCount<T>>{});
+	}
+
+	// 成员名在反射列表中的下标；不存在时为 FieldCount
+	template <typename T>
+	constexpr size_t IndexOfName(std::string_view name)
+	{
+		return [name]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			size_t index = FieldCount<T>;
+			((index = (index == FieldCount<T> && std::get<Is>(Fields<T>).name == name) ? Is : index), ...);
+			return index;
+		}(std::make_index_sequence<FieldCount<T>>{});
+	}
+}
+
+// @brief 以反射结构体 T 的成员为列的 SoA 数组。
+// @tparam T 已通过 BEGIN_CLASS / VARIABLES 登记成员的结构体。
+// @tparam Layout 列内存布局，见 ESoaLayout。
+// @note 继承 BasicSoaDynamicArray 的全部接口（按下标的 Column<I>()、SortBy、Gather 等），
+//       另提供按成员访问的 Field 与 AoS / SoA 批量转换。
+//       AoS 转换要求 T 可默认构造，成员可拷贝赋值。
+template <typename T, ESoaLayout Layout = ESoaLayout::SeparateColumns>
+class ReflectedSoaArray
+	: public SoaReflectedDetail::StorageOf<Layout, T, std::make_index_sequence<SoaReflectedDetail::FieldCount<T>>>::type
+{
+public:
+	using Base = typename SoaReflectedDetail::StorageOf<Layout, T,
+		std::make_index_sequence<SoaReflectedDetail::FieldCount<T>>>::type;
+	using struct_type = T;
+	static constexpr size_t NumFields = SoaReflectedDetail::FieldCount<T>;
+
+	using Base::Base;
+
+	// @brief 成员 Member（如 &Particle::life）对应的列下标。
+	template <auto Member>
+	static constexpr size_t IndexOf = SoaReflectedDetail::IndexOfMember<T, Member>();
+
+	// @brief 成员名对应的列下标，不存在时为 NumFields。
+	static constexpr size_t IndexOfName(std::string_view name) { return SoaReflectedDetail::IndexOfName<T>(name); }
+
+	// @brief 按成员指针取列。
+	template <auto Member>
+	auto Field() noexcept
+	{
+		static_assert(IndexOf<Member> < NumFields, "ReflectedSoaArray::Field — 成员未在 VARIABLES 中登记");
+		return this->template Column<IndexOf<Member>>();
+	}
+
+	template <auto Member>
+	auto Field() const noexcept
+	{
+		static_assert(IndexOf<Member> < NumFields, "ReflectedSoaArray::Field — 成员未在 VARIABLES 中登记");
+		return this->template Column<IndexOf<Member>>();
+	}
+
+	// @brief 按成员名取列。
+	template <SoaFieldName Name>
+	auto Field() noexcept
+	{
+		constexpr size_t index = IndexOfName(Name.View());
+		static_assert(index < NumFields, "ReflectedSoaArray::Field — 没有该名字的成员");
+		return this->template Column<index>();
+	}
+
+	template <SoaFieldName Name>
+	auto Field() const noexcept
+	{
+		constexpr size_t index = IndexOfName(Name.View());
+		static_assert(index < NumFields, "ReflectedSoaArray::Field — 没有该名字的成员");
+		return this->template Column<index>();
+	}
+
+	// @brief 第 I 列的成员名。
+	template <size_t I>
+	static constexpr std::string_view FieldName() noexcept
+	{
+		return std::get<I>(SoaReflectedDetail::Fields<T>).name;
+	}
+
+	// @brief 追加一行，各列取自 value 的对应成员。
+	void PushBack(const T& value)
+	{
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			this->Base::PushBack(value.*SoaReflectedDetail::FieldPointer<T, Is>...);
+		}(std::make_index_sequence<NumFields>{});
+	}
+
+	using Base::PushBack;
+
+	// @brief 把 AoS 数据批量追加到末尾：先整体扩容，再逐列拷贝（每列一次顺序遍历源数组）。
+	void AppendAoS(std::span<const T> values)
+	{
+		const size_t first = this->Size();
+		this->Resize(first + values.size());
+		try
+		{
+			[&]<size_t... Is>(std::index_sequence<Is...>)
+			{
+				(CopyFieldIn<Is>(values, first), ...);
+			}(std::make_index_sequence<NumFields>{});
+		}
+		catch (...)
+		{
+			this->Resize(first);
+			throw;
+		}
+	}
+
+	// @brief 由 AoS 数据构造。
+	static ReflectedSoaArray FromAoS(std::span<const T> values)
+	{
+		ReflectedSoaArray result;
+		result.Reserve(values.size());
+		result.AppendAoS(values);
+		return result;
+	}
+
+	// @brief 把全部行逐列写入 out 的对应成员，out.size() 须等于 Size()。
+	void ToAoS(std::span<T> out) const
+	{
+		if (out.size() != this->Size())
+			throw std::invalid_argument("ReflectedSoaArray::ToAoS — 输出长度须等于 Size()");
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			(CopyFieldOut<Is>(out), ...);
+		}(std::make_index_sequence<NumFields>{});
+	}
+
+	std::vector<T> ToAoS() const
+	{
+		std::vector<T> result(this->Size());
+		ToAoS(std::span<T>(result));
+		return result;
+	}
+
+	// @brief 取第 index 行为结构体（拷贝）。
+	T GetRow(size_t index) const
+	{
+		T value{};
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			((value.*SoaReflectedDetail::FieldPointer<T, Is> = this->template Column<Is>()[index]), ...);
+		}(std::make_index_sequence<NumFields>{});
+		return value;
+	}
+
+	// @brief 按下标选取行，见 BasicSoaDynamicArray::Gather；结果仍为 ReflectedSoaArray，可继续按成员取列。
+	ReflectedSoaArray Gather(std::span<const size_t> indices) const
+	{
+		return ReflectedSoaArray(Base::Gather(indices));
+	}
+
+	// @brief 用结构体覆盖第 index 行。
+	void SetRow(size_t index, const T& value)
+	{
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			((this->template Column<Is>()[index] = value.*SoaReflectedDetail::FieldPointer<T, Is>), ...);
+		}(std::make_index_sequence<NumFields>{});
+	}
+
+private:
+	explicit ReflectedSoaArray(Base&& base) noexcept
+		: Base(std::move(base))
+	{
+	}
+
+	template <size_t I>
+	void CopyFieldIn(std::span<const T> values, size_t first)
+	{
+		constexpr auto member = SoaReflectedDetail::FieldPointer<T, I>;
+		auto* column = this->template Column<I>().data() + first;
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			column[i] = values[i].*member;
+		}
+	}
+
+	template <size_t I>
+	void CopyFieldOut(std::span<T> out) const
+	{
+		constexpr auto member = SoaReflectedDetail::FieldPointer<T, I>;
+		const auto* column = this->template Column<I>().data();
+		for (size_t i = 0; i < out.size(); ++i)
+		{
+			out[i].*member = column[i];
+		}
+	}
+};
+
+// 所有列位于同一块内存的反射 SoA 数组
+template <typename T>
+using ReflectedSoaBlockArray = ReflectedSoaArray<T, ESoaLayout::SingleBlock>;
+}
@@ -0,0 +1,473 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "SoaDynamicArray.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#define CORE_SOA_HAS_MMAP 1
+#else
+	#define CORE_SOA_HAS_MMAP 0
+#endif
+
+// SoA 数组的二进制快照。
+//
+// 文件布局（小端 / 大端按写入机器，读取时校验）：
+//   SoaSnapshotHeader                        32 字节
+//   SoaSnapshotColumn[column_count]          每列 32 字节：类型哈希、元素大小 / 对齐、数据偏移与字节数
+//   填充至 SnapshotDataAlignment
+//   列 0 原始数据，填充至 SnapshotDataAlignment
+//   列 1 原始数据 ...
+//
+// 每列数据的文件偏移都是 4096 的倍数，因此整文件 mmap 后列地址天然按页对齐，
+// 可以直接作为 span 使用，无需拷贝（SoaMappedArray::MapReadOnly）。
+// 仅支持所有列均为 trivially copyable 的数组。
+//
+// 类型哈希取自编译器生成的函数签名，同一编译器构建的程序之间稳定；
+// 更换编译器或修改列类型后旧快照会在加载时被拒绝。
+
+namespace Core
+{
+inline constexpr uint32_t SnapshotMagic = 0x53414F53; // "SOAS"
+inline constexpr uint16_t SnapshotVersion = 1;
+inline constexpr uint16_t SnapshotEndianMark = 0x0102;
+inline constexpr size_t SnapshotDataAlignment = 4096;
+
+struct SoaSnapshotHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t endian_mark;
+	uint32_t column_count;
+	uint32_t reserved;
+	uint64_t row_count;
+	uint64_t data_alignment;
+};
+
+struct SoaSnapshotColumn
+{
+	uint64_t type_hash;
+	uint32_t element_size;
+	uint32_t element_align;
+	uint64_t offset;
+	uint64_t bytes;
+};
+
+static_assert(sizeof(SoaSnapshotHeader) == 32 && sizeof(SoaSnapshotColumn) == 32);
+
+namespace SoaSnapshotDetail
+{
+	constexpr uint64_t Fnv1a(std::string_view text) noexcept
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : text)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	template <typename T>
+	constexpr std::string_view TypeSignature() noexcept
+	{
+#if defined(_MSC_VER)
+		return __FUNCSIG__;
+#else
+		return __PRETTY_FUNCTION__;
+#endif
+	}
+
+	constexpr size_t AlignUp(size_t value, size_t alignment) noexcept
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	// 列描述表之后第一列数据的偏移
+	constexpr size_t DataBegin(size_t column_count) noexcept
+	{
+		return AlignUp(sizeof(SoaSnapshotHeader) + column_count * sizeof(SoaSnapshotColumn), SnapshotDataAlignment);
+	}
+
+	struct FileCloser
+	{
+		void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+	};
+	using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+	inline FilePtr OpenFile(const std::string& path, const char* mode)
+	{
+		FilePtr file(std::fopen(path.c_str(), mode));
+		if (!file)
+			throw std::runtime_error("SoaSnapshot: cannot open " + path);
+		return file;
+	}
+
+	inline void WriteBytes(std::FILE* file, const void* data, size_t bytes, const std::string& path)
+	{
+		if (bytes != 0 && std::fwrite(data, 1, bytes, file) != bytes)
+			throw std::runtime_error("SoaSnapshot: write failed for " + path);
+	}
+
+	inline void WritePadding(std::FILE* file, size_t bytes, const std::string& path)
+	{
+		static constexpr std::array<std::byte, 256> zeros{};
+		while (bytes != 0)
+		{
+			size_t n = std::min(bytes, zeros.size());
+			WriteBytes(file, zeros.data(), n, path);
+			bytes -= n;
+		}
+	}
+
+	inline void ReadBytes(std::FILE* file, void* data, size_t bytes, const std::string& path)
+	{
+		if (bytes != 0 && std::fread(data, 1, bytes, file) != bytes)
+			throw std::runtime_error("SoaSnapshot: unexpected end of file in " + path);
+	}
+
+	// 64 位文件偏移：long 在 LLP64（Windows）上只有 32 位，不能用 fseek / ftell
+	inline void SeekTo(std::FILE* file, uint64_t offset, const std::string& path)
+	{
+#if defined(_WIN32)
+		const int result = ::_fseeki64(file, int64_t(offset), SEEK_SET);
+#else
+		const int result = ::fseeko(file, off_t(offset), SEEK_SET);
+#endif
+		if (result != 0)
+			throw std::runtime_error("SoaSnapshot: cannot seek " + path);
+	}
+
+	// 文件总长度，读写位置回到开头
+	inline uint64_t FileSize(std::FILE* file, const std::string& path)
+	{
+#if defined(_WIN32)
+		const int64_t bytes = ::_fseeki64(file, 0, SEEK_END) == 0 ? ::_ftelli64(file) : -1;
+#else
+		const int64_t bytes = ::fseeko(file, 0, SEEK_END) == 0 ? int64_t(::ftello(file)) : -1;
+#endif
+		if (bytes < 0)
+			throw std::runtime_error("SoaSnapshot: cannot seek " + path);
+		SeekTo(file, 0, path);
+		return uint64_t(bytes);
+	}
+
+	// 校验头与列描述，file_bytes 为文件总长度（用于检查数据区越界）
+	template <typename... Types>
+	void Validate(const SoaSnapshotHeader& header, const SoaSnapshotColumn* columns, uint64_t file_bytes,
+		const std::string& path)
+	{
+		if (header.magic != SnapshotMagic)
+			throw std::runtime_error("SoaSnapshot: " + path + " is not a SoA snapshot");
+		if (header.endian_mark != SnapshotEndianMark)
+			throw std::runtime_error("SoaSnapshot: " + path + " was written with a different byte order");
+		if (header.version != SnapshotVersion)
+			throw std::runtime_error("SoaSnapshot: unsupported version " + std::to_string(header.version) + " in " + path);
+		if (header.column_count != sizeof...(Types) || header.data_alignment != SnapshotDataAlignment)
+			throw std::runtime_error("SoaSnapshot: column layout mismatch in " + path);
+
+		size_t i = 0;
+		auto check = [&]<typename T>(std::type_identity<T>)
+		{
+			const SoaSnapshotColumn& column = columns[i];
+			if (column.type_hash != Fnv1a(TypeSignature<T>()) || column.element_size != sizeof(T) ||
+				column.element_align != alignof(T))
+				throw std::runtime_error("SoaSnapshot: column " + std::to_string(i) + " type mismatch in " + path);
+			if (column.bytes / sizeof(T) < header.row_count || column.offset % SnapshotDataAlignment != 0 ||
+				column.offset > file_bytes || column.bytes > file_bytes - column.offset)
+				throw std::runtime_error("SoaSnapshot: column " + std::to_string(i) + " is truncated in " + path);
+			++i;
+		};
+		(check(std::type_identity<Types>{}), ...);
+	}
+}
+
+// @brief 列 T 在快照中记录的类型哈希。
+template <typename T>
+constexpr uint64_t SnapshotTypeHash() noexcept
+{
+	return SoaSnapshotDetail::Fnv1a(SoaSnapshotDetail::TypeSignature<T>());
+}
+
+// @brief 将数组写入二进制快照文件（覆盖已有文件）。
+// @throw std::runtime_error 打开或写入失败。
+template <ESoaLayout Layout, typename... Types>
+void SaveSnapshot(const BasicSoaDynamicArray<Layout, Types...>& array, const std::string& path)
+{
+	static_assert((std::is_trivially_copyable_v<Types> && ...), "SaveSnapshot — 所有列必须是 trivially copyable");
+	static_assert(((alignof(Types) <= SnapshotDataAlignment) && ...));
+	using namespace SoaSnapshotDetail;
+
+	constexpr size_t num_types = sizeof...(Types);
+	const size_t rows = array.Size();
+
+	SoaSnapshotHeader header{SnapshotMagic, SnapshotVersion, SnapshotEndianMark, uint32_t(num_types), 0, rows,
+		SnapshotDataAlignment};
+	std::array<SoaSnapshotColumn, num_types> columns{};
+	size_t offset = DataBegin(num_types);
+	{
+		size_t i = 0;
+		((columns[i] = {SnapshotTypeHash<Types>(), uint32_t(sizeof(Types)), uint32_t(alignof(Types)), offset,
+			  rows * sizeof(Types)},
+			offset = AlignUp(offset + rows * sizeof(Types), SnapshotDataAlignment), ++i), ...);
+	}
+
+	FilePtr file = OpenFile(path, "wb");
+	WriteBytes(file.get(), &header, sizeof(header), path);
+	WriteBytes(file.get(), columns.data(), sizeof(columns), path);
+	WritePadding(file.get(), DataBegin(num_types) - sizeof(header) - sizeof(columns), path);
+
+	[&]<size_t... Is>(std::index_sequence<Is...>)
+	{
+		auto write_column = [&]<size_t I>(std::integral_constant<size_t, I>)
+		{
+			auto column = array.template Column<I>();
+			WriteBytes(file.get(), column.data(), column.size_bytes(), path);
+			WritePadding(file.get(), AlignUp(column.size_bytes(), SnapshotDataAlignment) - column.size_bytes(), path);
+		};
+		(write_column(std::integral_constant<size_t, Is>{}), ...);
+	}(std::index_sequence_for<Types...>{});
+
+	if (std::fflush(file.get()) != 0)
+		throw std::runtime_error("SoaSnapshot: write failed for " + path);
+}
+
+// @brief 读取快照到新的数组（拷贝数据）。需要只读访问时优先使用 SoaMappedArray::MapReadOnly。
+// @throw std::runtime_error 文件无法打开、格式 / 版本不符或列类型不匹配。
+template <typename... Types>
+SoaDynamicArray<Types...> LoadSnapshot(const std::string& path)
+{
+	static_assert((std::is_trivially_copyable_v<Types> && ...), "LoadSnapshot — 所有列必须是 trivially copyable");
+	using namespace SoaSnapshotDetail;
+
+	FilePtr file = OpenFile(path, "rb");
+	const uint64_t file_bytes = FileSize(file.get(), path);
+
+	SoaSnapshotHeader header{};
+	std::array<SoaSnapshotColumn, sizeof...(Types)> columns{};
+	ReadBytes(file.get(), &header, sizeof(header), path);
+	if (header.magic == SnapshotMagic && header.column_count == sizeof...(Types))
+		ReadBytes(file.get(), columns.data(), sizeof(columns), path);
+	Validate<Types...>(header, columns.data(), file_bytes, path);
+
+	SoaDynamicArray<Types...> result;
+	result.Resize(size_t(header.row_count));
+	[&]<size_t... Is>(std::index_sequence<Is...>)
+	{
+		auto read_column = [&]<size_t I>(std::integral_constant<size_t, I>)
+		{
+			auto column = result.template Column<I>();
+			SeekTo(file.get(), columns[I].offset, path);
+			ReadBytes(file.get(), column.data(), column.size_bytes(), path);
+		};
+		(read_column(std::integral_constant<size_t, Is>{}), ...);
+	}(std::index_sequence_for<Types...>{});
+	return result;
+}
+
+// @brief 快照文件的只读零拷贝视图：整文件 mmap，列直接指向映射内存。
+// @note 不支持 mmap 的平台退化为一次整文件读入（页对齐缓冲区），接口不变。
+//       只可移动；析构时解除映射，此前取得的 span 随之失效。
+template <typename... Types>
+class SoaMappedArray
+{
+public:
+	using value_types = std::tuple<Types...>;
+	static constexpr size_t NumTypes = sizeof...(Types);
+
+	static_assert((std::is_trivially_copyable_v<Types> && ...), "SoaMappedArray — 所有列必须是 trivially copyable");
+
+	SoaMappedArray() = default;
+
+	~SoaMappedArray() { Release(); }
+
+	SoaMappedArray(SoaMappedArray&& other) noexcept
+		: base(std::exchange(other.base, nullptr)), mapped_bytes(std::exchange(other.mapped_bytes, 0)),
+		  size(std::exchange(other.size, 0)),
+		  columns(std::exchange(other.columns, {}))
+	{
+	}
+
+	SoaMappedArray& operator=(SoaMappedArray&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			base = std::exchange(other.base, nullptr);
+			mapped_bytes = std::exchange(other.mapped_bytes, 0);
+			size = std::exchange(other.size, 0);
+			columns = std::exchange(other.columns, {});
+		}
+		return *this;
+	}
+
+	SoaMappedArray(const SoaMappedArray&) = delete;
+	SoaMappedArray& operator=(const SoaMappedArray&) = delete;
+
+	// @brief 映射快照文件。加载耗时只有一次 mmap 与头部校验，列数据按需由缺页换入。
+	// @throw std::runtime_error 文件无法打开 / 映射、格式 / 版本不符或列类型不匹配。
+	static SoaMappedArray MapReadOnly(const std::string& path)
+	{
+		SoaMappedArray result;
+		result.Open(path);
+		return result;
+	}
+
+	size_t Size() const noexcept { return size; }
+	bool IsEmpty() const noexcept { return size == 0; }
+
+	// @brief 返回第 I 列的只读视图，起始地址按 SnapshotDataAlignment 对齐。
+	template <size_t I>
+	std::span<const std::tuple_element_t<I, value_types>> Column() const noexcept
+	{
+		using Type = std::tuple_element_t<I, value_types>;
+		return {std::launder(reinterpret_cast<const Type*>(columns[I])), size};
+	}
+
+	// @brief 按类型取列，要求 T 在 Types 中恰好出现一次。
+	template <typename T>
+	std::span<const T> Column() const noexcept
+	{
+		constexpr size_t index = SoaDynamicArray<Types...>::template IndexOfType<T>;
+		static_assert(index < NumTypes, "Column<T> — T 不在列类型中");
+		return Column<index>();
+	}
+
+	// @brief 返回第 index 行的只读视图（tuple<const Types&...>）。
+	auto operator[](size_t index) const noexcept
+	{
+		return [&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			return std::tuple<const Types&...>(Column<Is>()[index]...);
+		}(std::index_sequence_for<Types...>{});
+	}
+
+	auto At(size_t index) const
+	{
+		if (index >= size) throw std::out_of_range("SoaMappedArray index out of range");
+		return (*this)[index];
+	}
+
+	// @brief 拷贝为可修改的 SoaDynamicArray。
+	SoaDynamicArray<Types...> ToArray() const
+	{
+		SoaDynamicArray<Types...> result;
+		result.Resize(size);
+		[&]<size_t... Is>(std::index_sequence<Is...>)
+		{
+			(std::memcpy(result.template Column<Is>().data(), Column<Is>().data(), Column<Is>().size_bytes()), ...);
+		}(std::index_sequence_for<Types...>{});
+		return result;
+	}
+
+private:
+	std::byte* base = nullptr;
+	size_t mapped_bytes = 0;
+	size_t size = 0;
+	std::array<const std::byte*, NumTypes> columns{};
+
+	void Open(const std::string& path)
+	{
+		using namespace SoaSnapshotDetail;
+#if CORE_SOA_HAS_MMAP
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			throw std::runtime_error("SoaSnapshot: cannot open " + path);
+		struct stat info{};
+		if (::fstat(fd, &info) != 0)
+		{
+			::close(fd);
+			throw std::runtime_error("SoaSnapshot: cannot stat " + path);
+		}
+		if (size_t(info.st_size) < sizeof(SoaSnapshotHeader))
+		{
+			::close(fd);
+			throw std::runtime_error("SoaSnapshot: " + path + " is not a SoA snapshot");
+		}
+		void* memory = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd); // 映射建立后不再需要描述符
+		if (memory == MAP_FAILED)
+			throw std::runtime_error("SoaSnapshot: mmap failed for " + path);
+		base = static_cast<std::byte*>(memory);
+		mapped_bytes = size_t(info.st_size);
+#else
+		FilePtr file = OpenFile(path, "rb");
+		const uint64_t file_bytes = FileSize(file.get(), path);
+		if (file_bytes < sizeof(SoaSnapshotHeader))
+			throw std::runtime_error("SoaSnapshot: " + path + " is not a SoA snapshot");
+		base = static_cast<std::byte*>(::operator new(size_t(file_bytes), std::align_val_t(SnapshotDataAlignment)));
+		mapped_bytes = size_t(file_bytes);
+		try
+		{
+			ReadBytes(file.get(), base, mapped_bytes, path);
+		}
+		catch (...)
+		{
+			Release();
+			throw;
+		}
+#endif
+
+		try
+		{
+			SoaSnapshotHeader header;
+			std::memcpy(&header, base, sizeof(header));
+			std::array<SoaSnapshotColumn, NumTypes> descs{};
+			if (header.magic == SnapshotMagic && header.column_count == NumTypes)
+			{
+				if (mapped_bytes < sizeof(header) + sizeof(descs))
+					throw std::runtime_error("SoaSnapshot: " + path + " is truncated");
+				std::memcpy(descs.data(), base + sizeof(header), sizeof(descs));
+			}
+			Validate<Types...>(header, descs.data(), mapped_bytes, path);
+
+			size = size_t(header.row_count);
+			for (size_t i = 0; i < NumTypes; ++i)
+				columns[i] = base + descs[i].offset;
+		}
+		catch (...)
+		{
+			Release();
+			throw;
+		}
+
+#if CORE_SOA_HAS_MMAP && defined(MADV_SEQUENTIAL)
+		// 快照通常被整列顺序扫描，提示内核加大预读
+		::madvise(base, mapped_bytes, MADV_SEQUENTIAL);
+#endif
+	}
+
+	void Release() noexcept
+	{
+		if (!base) return;
+#if CORE_SOA_HAS_MMAP
+		::munmap(base, mapped_bytes);
+#else
+		::operator delete(base, std::align_val_t(SnapshotDataAlignment));
+#endif
+		base = nullptr;
+		mapped_bytes = 0;
+		size = 0;
+		columns = {};
+	}
+};
+}
@@ -0,0 +1,414 @@
+#include "Core/Entity/AABBBatch.h"
+#include "Core/Entity/DynamicAABBTree.h"
+#include "Core/Entity/IncrementalSweepAndPrune.h"
+#include "Core/Entity/ParallelSweepAndPrune.h"
+#include "CoreTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Runtime::Core::AABB;
+using Runtime::Core::AABBBatch;
+using Runtime::Core::HitInfo;
+
+template<typename Ty, std::size_t Dimensions>
+std::vector<AABB<Ty, Dimensions>> RandomBoxes(std::size_t count, Ty world, Ty maxHalf, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> position(0.0, double(world));
+    std::uniform_real_distribution<double> half(0.0, double(maxHalf));
+    std::vector<AABB<Ty, Dimensions>> boxes;
+    boxes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ::Core::Math::Vector<Ty, Dimensions> lo{}, hi{};
+        for (std::size_t axis = 0; axis < Dimensions; ++axis)
+        {
+            const double center = position(rng);
+            const double extent = half(rng);
+            lo[axis] = Ty(center - extent);
+            hi[axis] = Ty(center + extent);
+        }
+        boxes.emplace_back(lo, hi);
+    }
+    return boxes;
+}
+
+std::vector<HitInfo> Sorted(std::vector<HitInfo> hits)
+{
+    std::sort(hits.begin(), hits.end(), [](const HitInfo& a, const HitInfo& b)
+    {
+        return a.idx1 != b.idx1 ? a.idx1 < b.idx1 : a.idx2 < b.idx2;
+    });
+    return hits;
+}
+}
+
+CORE_TEST(BatchSweepAndPruneMatchesBruteForce)
+{
+    const auto boxes = RandomBoxes<float, 3>(3000, 100.0f, 2.0f, 1);
+    const AABBBatch<float, 3> batch(boxes);
+    const auto expected = Runtime::Core::BruteForcePairs(boxes);
+    CORE_CHECK(!expected.empty());
+
+    for (const std::array<uint8_t, 3> order : { std::array<uint8_t, 3>{ 0, 1, 2 },
+                                                std::array<uint8_t, 3>{ 2, 0, 1 },
+                                                std::array<uint8_t, 3>{ 1, 9, 9 },
+                                                std::array<uint8_t, 3>{ 9, 9, 9 } })
+    {
+        CORE_CHECK(Sorted(Runtime::Core::SweepAndPrune(batch, order)) == expected);
+        CORE_CHECK(Sorted(Runtime::Core::SweepAndPrune(boxes, order)) == expected);
+    }
+
+    // 大量重叠 (单个大组, 走基数排序而不是插入排序)
+    const auto dense = RandomBoxes<double, 2>(1500, 10.0, 3.0, 2);
+    const AABBBatch<double, 2> denseBatch(dense);
+    CORE_CHECK(Sorted(Runtime::Core::SweepAndPrune(denseBatch, { 1, 0 })) == Runtime::Core::BruteForcePairs(dense));
+}
+
+CORE_TEST(BatchSweepAndPruneTinyInputs)
+{
+    AABBBatch<float, 2> empty;
+    CORE_CHECK(Runtime::Core::SweepAndPrune(empty, { 0, 1 }).empty());
+
+    const auto one = RandomBoxes<float, 2>(1, 10.0f, 1.0f, 3);
+    CORE_CHECK(Runtime::Core::SweepAndPrune(AABBBatch<float, 2>(one), { 0, 1 }).empty());
+}
+
+CORE_TEST(SortBatchByAxisWithNaN)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    auto boxes = RandomBoxes<float, 2>(200, 20.0f, 1.5f, 4);
+    for (std::size_t i = 0; i < boxes.size(); i += 17)
+    {
+        boxes[i].min[0] = (i % 2) ? nan : -nan;
+        boxes[i].max[1] = nan;
+    }
+    const AABBBatch<float, 2> batch(boxes);
+
+    AABBBatch<float, 2> sorted;
+    const auto order = Runtime::Core::Detail::SortBatchByAxis(batch, 0, sorted);
+    CORE_CHECK(order.size() == boxes.size());
+    float previous = -std::numeric_limits<float>::infinity();
+    for (std::size_t k = 0; k < order.size(); ++k)
+    {
+        const float value = sorted.Min(0)[k];
+        if (std::isnan(value))
+            continue;
+        CORE_CHECK(!(value < previous)); // 有限值之间保持升序
+        previous = value;
+    }
+
+    // 含 NaN 的盒子结果未指定, 但有限盒子之间的重叠对必须完整
+    auto finite = [&](const HitInfo& hit)
+    {
+        return std::isfinite(boxes[hit.idx1].min[0]) && std::isfinite(boxes[hit.idx1].max[1])
+            && std::isfinite(boxes[hit.idx2].min[0]) && std::isfinite(boxes[hit.idx2].max[1]);
+    };
+    auto onlyFinite = [&](std::vector<HitInfo> hits)
+    {
+        std::erase_if(hits, [&](const HitInfo& hit) { return !finite(hit); });
+        return Sorted(std::move(hits));
+    };
+    const auto expected = onlyFinite(Runtime::Core::BruteForcePairs(boxes));
+    CORE_CHECK(onlyFinite(Runtime::Core::FullAABBCollisionFrom1D(batch, 0)) == expected);
+    CORE_CHECK(onlyFinite(Runtime::Core::SweepAndPrune(batch, { 0, 1 })) == expected);
+}
+
+CORE_TEST(SweepAndPruneReusesScratch)
+{
+    Runtime::Core::SweepAndPruneScratch<float> scratch;
+    std::vector<HitInfo> hits;
+    // 规模先大后小, 复用的缓冲里残留的旧数据不能影响结果
+    for (const std::size_t count : { 2000u, 300u, 1u, 800u })
+    {
+        const auto boxes = RandomBoxes<float, 3>(count, 60.0f, 2.0f, unsigned(count));
+        Runtime::Core::SweepAndPrune(boxes, { 0, 1, 2 }, scratch, hits);
+        CORE_CHECK(Sorted(hits) == Runtime::Core::BruteForcePairs(boxes));
+    }
+}
+
+CORE_TEST(SortIndexRangeIsChecked)
+{
+    Runtime::Core::Detail::CheckSortIndexRange(std::numeric_limits<std::uint32_t>::max(), "Test");
+    CORE_CHECK_THROWS(Runtime::Core::Detail::CheckSortIndexRange(
+        std::size_t(std::numeric_limits<std::uint32_t>::max()) + 1, "Test"), std::length_error);
+}
+
+CORE_TEST(IncrementalDeltasMatchBruteForce)
+{
+    using Box = AABB<float, 3>;
+    using PairSet = std::set<std::pair<std::uint64_t, std::uint64_t>>;
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> coord(0, 40), extent(0, 4), offset(-3, 3);
+    auto randomBox = [&]
+    {
+        const ::Core::Math::Vector<float, 3> lo{ float(coord(rng)), float(coord(rng)), float(coord(rng)) };
+        const ::Core::Math::Vector<float, 3> hi{ lo[0] + extent(rng), lo[1] + extent(rng), lo[2] + extent(rng) };
+        return Box(lo, hi);
+    };
+    auto bruteForce = [](const std::vector<Box>& boxes, const std::vector<bool>& alive)
+    {
+        PairSet pairs;
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+            for (std::size_t j = i + 1; j < boxes.size(); ++j)
+                if (alive[i] && alive[j] && Runtime::Core::IsOverlap(boxes[i], boxes[j]))
+                    pairs.insert({ i, j });
+        return pairs;
+    };
+
+    Runtime::Core::IncrementalSweepAndPrune<float, 3> sap;
+    std::vector<Box> boxes;
+    std::vector<bool> alive;
+    PairSet previous;
+    for (int frame = 0; frame < 200; ++frame)
+    {
+        const int ops = 1 + int(rng() % 40);
+        for (int k = 0; k < ops; ++k)
+        {
+            const unsigned op = rng() % 10;
+            if (op < 2 || boxes.empty())
+            {
+                const Box box = randomBox();
+                const auto id = sap.Add(box);
+                if (id >= boxes.size())
+                {
+                    boxes.resize(id + 1, box);
+                    alive.resize(id + 1, false);
+                }
+                CORE_CHECK(!alive[id]);
+                boxes[id] = box;
+                alive[id] = true;
+            }
+            else if (op < 3)
+            {
+                const std::size_t id = rng() % boxes.size();
+                if (alive[id])
+                {
+                    sap.Remove(std::uint32_t(id));
+                    alive[id] = false;
+                }
+            }
+            else
+            {
+                const std::size_t id = rng() % boxes.size();
+                if (!alive[id])
+                    continue;
+                auto lo = boxes[id].min, hi = boxes[id].max;
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    const float shift = float(offset(rng));
+                    lo[axis] += shift;
+                    hi[axis] += shift;
+                }
+                boxes[id] = Box(lo, hi);
+                sap.Move(std::uint32_t(id), boxes[id]);
+            }
+        }
+
+        const auto& delta = sap.Flush();
+        const PairSet current = bruteForce(boxes, alive);
+        PairSet tracked;
+        sap.ForEachPair([&](HitInfo hit) { tracked.insert({ hit.idx1, hit.idx2 }); });
+        CORE_CHECK(tracked == current);
+
+        // 上一帧的集合 + 本帧增量 == 本帧的集合
+        PairSet replayed = previous;
+        for (const HitInfo& hit : delta.ended)
+            CORE_CHECK(replayed.erase({ hit.idx1, hit.idx2 }) == 1);
+        for (const HitInfo& hit : delta.began)
+            CORE_CHECK(replayed.insert({ hit.idx1, hit.idx2 }).second);
+        CORE_CHECK(replayed == current);
+        previous = current;
+    }
+}
+
+CORE_TEST(IncrementalRebuildDoesNotReuseLiveIds)
+{
+    const auto boxes = RandomBoxes<float, 2>(3, 10.0f, 1.0f, 6);
+    Runtime::Core::IncrementalSweepAndPrune<float, 2> sap;
+    sap.Synchronize(boxes);
+    sap.Flush();
+
+    // 同一帧内先全部移除 (id 进入待回收列表) 再整体重建, 重建占用的 id 不能在 Flush 后被回收
+    sap.Synchronize({});
+    sap.Synchronize({ boxes[0], boxes[1] });
+    sap.Flush();
+    CORE_CHECK(sap.ProxyCount() == 2);
+
+    const auto first = sap.Add(boxes[2]);
+    const auto second = sap.Add(boxes[2]);
+    CORE_CHECK(first >= 2 && second >= 2 && first != second);
+    CORE_CHECK(sap.ProxyCount() == 4);
+}
+
+CORE_TEST(IncrementalResyncDoesNotReuseLiveIds)
+{
+    const auto boxes = RandomBoxes<float, 2>(3, 10.0f, 1.0f, 6);
+    Runtime::Core::IncrementalSweepAndPrune<float, 2> sap;
+    sap.Synchronize(boxes);
+    sap.Flush();
+
+    // 同一帧内先移除部分 id 再重新插入 (仍有存活代理, 不走整体重建), 重新插入的 id 不能在 Flush 后被回收
+    sap.Synchronize({ boxes[0] });
+    sap.Synchronize(boxes);
+    sap.Flush();
+    CORE_CHECK(sap.ProxyCount() == 3);
+
+    const auto first = sap.Add(boxes[2]);
+    const auto second = sap.Add(boxes[2]);
+    CORE_CHECK(first >= 3 && second >= 3 && first != second);
+    CORE_CHECK(sap.ProxyCount() == 5);
+}
+
+CORE_TEST(DynamicTreePairsMatchBruteForce)
+{
+    using Box = AABB<float, 3>;
+    auto boxes = RandomBoxes<float, 3>(600, 60.0f, 2.5f, 7);
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+
+    // 外扩为 0 时胖盒即真实盒, 结果应与暴力完全一致; 外扩时只要求不漏
+    for (const float margin : { 0.0f, 0.5f })
+    {
+        Runtime::Core::DynamicAABBTree<float, 3> tree(margin, margin == 0.0f ? 0.0f : 2.0f);
+        std::vector<Runtime::Core::DynamicAABBTree<float, 3>::ProxyId> ids;
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+            ids.push_back(tree.CreateProxy(boxes[i], i));
+
+        std::vector<bool> alive(boxes.size(), true);
+        for (int round = 0; round < 5; ++round)
+        {
+            for (std::size_t i = 0; i < boxes.size(); ++i)
+            {
+                if (!alive[i])
+                    continue;
+                if (rng() % 25 == 0)
+                {
+                    tree.DestroyProxy(ids[i]);
+                    alive[i] = false;
+                    continue;
+                }
+                ::Core::Math::Vector<float, 3> lo = boxes[i].min, hi = boxes[i].max, displacement{};
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    displacement[axis] = offset(rng);
+                    lo[axis] += displacement[axis];
+                    hi[axis] += displacement[axis];
+                }
+                boxes[i] = Box(lo, hi);
+                tree.MoveProxy(ids[i], boxes[i], displacement);
+            }
+            CORE_CHECK(tree.Validate());
+
+            std::vector<HitInfo> expected;
+            for (const HitInfo& hit : Runtime::Core::BruteForcePairs(boxes))
+                if (alive[hit.idx1] && alive[hit.idx2])
+                    expected.push_back(hit);
+
+            const auto pairs = Sorted(tree.ComputePairs());
+            if (margin == 0.0f)
+            {
+                CORE_CHECK(pairs == expected);
+            }
+            else
+            {
+                CORE_CHECK(std::includes(pairs.begin(), pairs.end(), expected.begin(), expected.end(),
+                    [](const HitInfo& a, const HitInfo& b)
+                    {
+                        return a.idx1 != b.idx1 ? a.idx1 < b.idx1 : a.idx2 < b.idx2;
+                    }));
+            }
+        }
+    }
+}
+
+CORE_TEST(DynamicTreeQueriesAreReentrantAndConcurrent)
+{
+    const auto boxes = RandomBoxes<float, 3>(1500, 50.0f, 2.0f, 11);
+    Runtime::Core::DynamicAABBTree<float, 3> tree(0.0f, 0.0f);
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+        tree.CreateProxy(boxes[i], i);
+    const auto expected = Runtime::Core::BruteForcePairs(boxes);
+    CORE_CHECK(!expected.empty());
+
+    // 回调中再次查询同一棵树: 内层遍历不能破坏外层的遍历栈
+    std::vector<HitInfo> outer;
+    int nested = 0;
+    tree.QueryPairs([&](auto a, auto b)
+    {
+        const std::uint64_t ua = tree.GetUserData(a), ub = tree.GetUserData(b);
+        outer.push_back(HitInfo{ std::min(ua, ub), std::max(ua, ub) });
+        if (nested++ < 3)
+            CORE_CHECK(Sorted(tree.ComputePairs()) == expected);
+    });
+    CORE_CHECK(Sorted(outer) == expected);
+
+    std::size_t hits = 0;
+    tree.Query(boxes[0], [&](auto a)
+    {
+        std::size_t inner = 0;
+        tree.Query(boxes[tree.GetUserData(a)], [&](auto) { ++inner; });
+        CORE_CHECK(inner >= 1);
+        ++hits;
+    });
+    CORE_CHECK(hits >= 1);
+
+    // const 查询可以在多个线程上同时进行
+    std::vector<char> matches(4, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < matches.size(); ++t)
+        threads.emplace_back([&, t] { matches[t] = Sorted(tree.ComputePairs()) == expected; });
+    for (auto& thread : threads)
+        thread.join();
+    CORE_CHECK(std::count(matches.begin(), matches.end(), 1) == 4);
+}
+
+CORE_TEST(ParallelSweepAndPruneMatchesBruteForce)
+{
+    ThreadPool pool(3, "BroadphaseTest");
+
+    for (const std::size_t count : { 0u, 1u, 2u, 50u, 3000u })
+    {
+        const auto boxes = RandomBoxes<float, 3>(count, 80.0f, 2.0f, unsigned(count) + 9);
+        CORE_CHECK(Sorted(Runtime::Core::ParallelSweepAndPrune(boxes, { 0, 1, 2 }, pool))
+            == Runtime::Core::BruteForcePairs(boxes));
+        CORE_CHECK(Sorted(Runtime::Core::ParallelSweepAndPrune(boxes, { 2, 0, 9 }, pool))
+            == Runtime::Core::BruteForcePairs(boxes));
+    }
+
+    // 整数坐标含负数与大量相等端点
+    std::mt19937 rng(10);
+    std::uniform_int_distribution<int> coord(-50, 50), extent(0, 5);
+    std::vector<AABB<int, 2>> integers;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const int x = coord(rng), y = coord(rng);
+        integers.emplace_back(::Core::Math::Vector<int, 2>{ x, y }, ::Core::Math::Vector<int, 2>{ x + extent(rng), y + extent(rng) });
+    }
+    CORE_CHECK(Sorted(Runtime::Core::ParallelSweepAndPrune(integers, { 1, 0 }, pool))
+        == Runtime::Core::BruteForcePairs(integers));
+
+    // 单个超过组内并行阈值的大组: 所有盒子在 x 上重叠
+    std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+    std::vector<AABB<float, 3>> slab;
+    for (int i = 0; i < 70000; ++i)
+    {
+        const float y = position(rng), z = position(rng);
+        slab.emplace_back(::Core::Math::Vector<float, 3>{ 0.0f, y, z }, ::Core::Math::Vector<float, 3>{ 1.0f, y + 1.0f, z + 1.0f });
+    }
+    CORE_CHECK(Sorted(Runtime::Core::ParallelSweepAndPrune(slab, { 0, 1, 2 }, pool))
+        == Sorted(Runtime::Core::SweepAndPrune(slab, { 0, 1, 2 })));
+    pool.WaitForIdle();
+}
+
+CORE_TEST_MAIN()
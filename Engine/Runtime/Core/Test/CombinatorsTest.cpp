@@ -0,0 +1,226 @@
+#include "Core/Bus/EventBus.h"
+#include "Core/Coroutine/Combinators.h"
+#include "Core/Coroutine/Task.h"
+#include "CoreTest.h"
+
+#include <coroutine>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace
+{
+struct OnFirst : Core::Bus::Signal<OnFirst, int> {};
+struct OnSecond : Core::Bus::Signal<OnSecond, int> {};
+
+// 手动触发的可取消 awaitable; 只有最终持有者析构时计数, 用于确认协程帧被销毁
+struct Gate
+{
+    std::coroutine_handle<> Waiter;
+    int Destroyed = 0;
+    int Cancelled = 0;
+
+    void Fire()
+    {
+        if (auto waiter = std::exchange(Waiter, nullptr))
+            waiter.resume();
+    }
+};
+
+struct GateAwaitable
+{
+    Gate* Target;
+    int Value;
+    bool Owner = true;
+
+    GateAwaitable(Gate& gate, int value) : Target(&gate), Value(value) {}
+    GateAwaitable(GateAwaitable&& other) noexcept
+        : Target(other.Target), Value(other.Value), Owner(std::exchange(other.Owner, false)) {}
+    ~GateAwaitable()
+    {
+        if (Owner)
+            ++Target->Destroyed;
+    }
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { Target->Waiter = handle; }
+    int await_resume() const noexcept { return Value; }
+
+    bool Cancel()
+    {
+        if (!Target->Waiter)
+            return false;
+        Target->Waiter = nullptr;
+        ++Target->Cancelled;
+        return true;
+    }
+};
+
+Core::Task<int> Ready(int value)
+{
+    co_return value;
+}
+
+Core::Task<int> Fails()
+{
+    throw std::runtime_error("operand");
+    co_return 0;
+}
+
+Core::Task<int> CountThenReturn(int& counter, int value)
+{
+    ++counter;
+    co_return value;
+}
+
+Core::Task<void> Nothing()
+{
+    co_return;
+}
+}
+
+CORE_TEST(WhenAllSynchronousOperands)
+{
+    auto all = []() -> Core::Task<std::tuple<int, int, std::monostate>>
+    {
+        co_return co_await Core::WhenAll(Ready(1), Ready(2), Nothing());
+    };
+    const auto [a, b, c] = Core::SyncWait(all());
+    CORE_CHECK(a == 1);
+    CORE_CHECK(b == 2);
+
+    auto range = []() -> Core::Task<std::vector<int>>
+    {
+        std::vector<Core::Task<int>> tasks;
+        for (int i = 0; i < 5; ++i)
+            tasks.push_back(Ready(i * 10));
+        co_return co_await Core::WhenAll(std::move(tasks));
+    };
+    CORE_CHECK((Core::SyncWait(range()) == std::vector<int>{ 0, 10, 20, 30, 40 }));
+}
+
+CORE_TEST(WhenAllZeroOperands)
+{
+    auto empty = []() -> Core::Task<bool>
+    {
+        [[maybe_unused]] std::tuple<> none = co_await Core::WhenAll();
+        std::vector<int> values = co_await Core::WhenAll(std::vector<Core::Task<int>>{});
+        co_return values.empty();
+    };
+    CORE_CHECK(Core::SyncWait(empty()));
+}
+
+CORE_TEST(WhenAllRethrowsAfterAllOperandsFinish)
+{
+    int counter = 0;
+    auto all = [&]() -> Core::Task<void>
+    {
+        co_await Core::WhenAll(CountThenReturn(counter, 1), Fails(), CountThenReturn(counter, 3));
+    };
+    CORE_CHECK_THROWS(Core::SyncWait(all()), std::runtime_error);
+    CORE_CHECK(counter == 2); // 异常不会阻止其余操作数运行
+}
+
+CORE_TEST(WhenAllWaitsForAsyncOperands)
+{
+    Gate first, second;
+    bool done = false;
+    std::tuple<int, int> result;
+    auto waiter = [&]() -> Core::Bus::EventTask
+    {
+        result = co_await Core::WhenAll(GateAwaitable(first, 1), GateAwaitable(second, 2));
+        done = true;
+    };
+    waiter();
+    CORE_CHECK(!done);
+    second.Fire();
+    CORE_CHECK(!done);
+    first.Fire();
+    CORE_CHECK(done);
+    CORE_CHECK((result == std::tuple<int, int>{ 1, 2 }));
+}
+
+CORE_TEST(WhenAnyCancelsAndDestroysLosers)
+{
+    Gate first, second, third;
+    std::variant<int, int, int> result;
+    bool done = false;
+    auto waiter = [&]() -> Core::Bus::EventTask
+    {
+        result = co_await Core::WhenAny(GateAwaitable(first, 1), GateAwaitable(second, 2), GateAwaitable(third, 3));
+        done = true;
+    };
+    waiter();
+    CORE_CHECK(!done);
+
+    second.Fire();
+    CORE_CHECK(done);
+    CORE_CHECK(result.index() == 1);
+    CORE_CHECK(std::get<1>(result) == 2);
+
+    // 失败者被取消, 其辅助协程帧 (连同 awaitable) 被销毁
+    CORE_CHECK(first.Cancelled == 1 && third.Cancelled == 1);
+    CORE_CHECK(first.Destroyed == 1 && second.Destroyed == 1 && third.Destroyed == 1);
+    CORE_CHECK(!first.Waiter && !third.Waiter);
+}
+
+CORE_TEST(WhenAnyDisconnectsLosingEventAwaiters)
+{
+    Core::Bus::EventBus bus;
+    std::variant<std::tuple<int>, std::tuple<int>> result;
+    bool done = false;
+    auto waiter = [&]() -> Core::Bus::EventTask
+    {
+        result = co_await Core::WhenAny(bus.Await<OnFirst>(), bus.Await<OnSecond>());
+        done = true;
+    };
+    waiter();
+    CORE_CHECK(bus.LiveWaiterCount<OnFirst>() == 1);
+    CORE_CHECK(bus.LiveWaiterCount<OnSecond>() == 1);
+
+    bus.Emit<OnSecond>(4);
+    CORE_CHECK(done);
+    CORE_CHECK(result.index() == 1);
+    CORE_CHECK(std::get<0>(std::get<1>(result)) == 4);
+    CORE_CHECK(bus.LiveWaiterCount<OnFirst>() == 0);
+    CORE_CHECK(bus.SubscriberCount<OnFirst>() == 0);
+}
+
+CORE_TEST(WhenAnySynchronousWinnerSkipsRemainingOperands)
+{
+    Gate gate;
+    int counter = 0;
+    auto any = [&]() -> Core::Task<size_t>
+    {
+        auto result = co_await Core::WhenAny(Ready(7), GateAwaitable(gate, 1), CountThenReturn(counter, 2));
+        co_return result.index();
+    };
+    CORE_CHECK(Core::SyncWait(any()) == 0);
+    CORE_CHECK(!gate.Waiter);  // 胜出者已确定, 之后的操作数不再启动
+    CORE_CHECK(counter == 0);
+    CORE_CHECK(gate.Destroyed == 1);
+
+    auto range = []() -> Core::Task<std::pair<size_t, int>>
+    {
+        std::vector<Core::Task<int>> tasks;
+        tasks.push_back(Ready(5));
+        tasks.push_back(Ready(6));
+        co_return co_await Core::WhenAny(std::move(tasks));
+    };
+    CORE_CHECK((Core::SyncWait(range()) == std::pair<size_t, int>{ 0, 5 }));
+}
+
+CORE_TEST(WhenAnyRethrowsWinnerException)
+{
+    Gate gate;
+    auto any = [&]() -> Core::Task<void>
+    {
+        co_await Core::WhenAny(Fails(), GateAwaitable(gate, 1));
+    };
+    CORE_CHECK_THROWS(Core::SyncWait(any()), std::runtime_error);
+    CORE_CHECK(gate.Destroyed == 1);
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <vector>
+
+// Core 单元测试使用的极简测试框架, 不引入第三方依赖.
+// 每个测试源文件编译为一个可执行文件, 由 ctest 运行; 任一检查失败时进程返回非 0.
+//
+//   CORE_TEST(SoaSortEmpty)
+//   {
+//       Core::SoaDynamicArray<int> array;
+//       CORE_CHECK(array.SortedOrder<0>().empty());
+//   }
+//
+//   CORE_TEST_MAIN()
+
+namespace Core::Test
+{
+
+struct TestCase
+{
+    const char*           Name;
+    std::function<void()> Body;
+};
+
+inline std::vector<TestCase>& Registry()
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+inline int& FailureCount()
+{
+    static int failures = 0;
+    return failures;
+}
+
+struct Registrar
+{
+    Registrar(const char* name, std::function<void()> body)
+    {
+        Registry().push_back(TestCase{ name, std::move(body) });
+    }
+};
+
+inline void ReportFailure(const char* file, int line, const char* expression)
+{
+    std::fprintf(stderr, "%s:%d: CORE_CHECK(%s) failed\n", file, line, expression);
+    ++FailureCount();
+}
+
+inline int RunAll()
+{
+    int failed_tests = 0;
+    for (const TestCase& test : Registry())
+    {
+        const int failures_before = FailureCount();
+        try
+        {
+            test.Body();
+        }
+        catch (const std::exception& e)
+        {
+            std::fprintf(stderr, "[%s] unexpected exception: %s\n", test.Name, e.what());
+            ++FailureCount();
+        }
+        catch (...)
+        {
+            std::fprintf(stderr, "[%s] unexpected exception\n", test.Name);
+            ++FailureCount();
+        }
+
+        const bool passed = FailureCount() == failures_before;
+        failed_tests += passed ? 0 : 1;
+        std::fprintf(stderr, "[%s] %s\n", passed ? "  OK  " : " FAIL ", test.Name);
+    }
+    std::fprintf(stderr, "%zu tests, %d failed\n", Registry().size(), failed_tests);
+    return failed_tests == 0 ? 0 : 1;
+}
+
+} // namespace Core::Test
+
+#define CORE_TEST(name)                                                              \
+    static void CoreTest_##name();                                                   \
+    static const ::Core::Test::Registrar CoreTestRegistrar_##name{ #name, &CoreTest_##name }; \
+    static void CoreTest_##name()
+
+#define CORE_CHECK(expression)                                                       \
+    do                                                                               \
+    {                                                                                \
+        if (!(expression))                                                           \
+            ::Core::Test::ReportFailure(__FILE__, __LINE__, #expression);            \
+    } while (0)
+
+// 期望 statement 抛出 exception_type
+#define CORE_CHECK_THROWS(statement, exception_type)                                 \
+    do                                                                               \
+    {                                                                                \
+        bool core_test_thrown = false;                                               \
+        try { statement; }                                                           \
+        catch (const exception_type&) { core_test_thrown = true; }                   \
+        if (!core_test_thrown)                                                       \
+            ::Core::Test::ReportFailure(__FILE__, __LINE__, #statement " throws " #exception_type); \
+    } while (0)
+
+#define CORE_TEST_MAIN()                                                             \
+    int main()                                                                       \
+    {                                                                                \
+        return ::Core::Test::RunAll();                                               \
+    }
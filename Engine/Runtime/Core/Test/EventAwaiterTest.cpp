@@ -0,0 +1,249 @@
+#include "Core/Bus/EventBus.h"
+#include "CoreTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <tuple>
+
+namespace
+{
+struct OnPing : Core::Bus::Signal<OnPing, int> {};
+
+using namespace std::chrono_literals;
+using Clock = Core::TimerWheel::Clock;
+
+struct WaitResult
+{
+    bool Resumed = false;
+    std::optional<std::tuple<int>> Value;
+};
+
+Core::Bus::EventTask WaitPlain(Core::Bus::EventBus& bus, std::atomic<int>& resumed, std::atomic<int>& value)
+{
+    auto [ping] = co_await bus.Await<OnPing>();
+    value.store(ping);
+    resumed.fetch_add(1);
+}
+
+Core::Bus::EventTask WaitWithCancellation(Core::Bus::EventBus& bus, Core::CancellationToken token, WaitResult& result)
+{
+    result.Value = co_await bus.Await<OnPing>().WithCancellation(std::move(token));
+    result.Resumed = true;
+}
+
+Core::Bus::EventTask WaitWithTimeout(Core::Bus::EventBus& bus, Core::TimerWheel& wheel,
+                                     Core::TimerWheel::Duration timeout, WaitResult& result)
+{
+    result.Value = co_await bus.Await<OnPing>().WithTimeout(timeout, wheel);
+    result.Resumed = true;
+}
+
+Core::Bus::EventTask WaitGuarded(Core::Bus::EventBus& bus, Core::TimerWheel& wheel, Core::CancellationToken token,
+                                 std::atomic<int>& resumed, std::atomic<int>& hits)
+{
+    auto value = co_await bus.Await<OnPing>().WithTimeout(1ms, wheel).WithCancellation(std::move(token));
+    if (value)
+        hits.fetch_add(1);
+    resumed.fetch_add(1);
+}
+}
+
+CORE_TEST(CancellationSourceRunsCallbacksOnce)
+{
+    Core::CancellationSource source;
+    Core::CancellationToken token = source.GetToken();
+    CORE_CHECK(token.CanBeCancelled());
+    CORE_CHECK(!Core::CancellationToken().CanBeCancelled());
+
+    int calls = 0;
+    int removedCalls = 0;
+    auto registration = token.Register([&] { ++calls; });
+    auto removed = token.Register([&] { ++removedCalls; });
+    CORE_CHECK(registration.IsActive());
+    removed.Reset();
+    CORE_CHECK(!removed.IsActive());
+
+    CORE_CHECK(source.Cancel());
+    CORE_CHECK(!source.Cancel());
+    CORE_CHECK(calls == 1);
+    CORE_CHECK(removedCalls == 0);
+    CORE_CHECK(token.IsCancellationRequested());
+
+    // 已取消的令牌上注册: 不调用回调, 返回空句柄
+    auto late = token.Register([&] { ++calls; });
+    CORE_CHECK(!late.IsActive());
+    CORE_CHECK(calls == 1);
+}
+
+CORE_TEST(AwaitResumesOnEmit)
+{
+    Core::Bus::EventBus bus;
+    std::atomic<int> resumed = 0;
+    std::atomic<int> value = 0;
+    WaitPlain(bus, resumed, value);
+    CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 1);
+
+    bus.Emit<OnPing>(7);
+    CORE_CHECK(resumed == 1);
+    CORE_CHECK(value == 7);
+    CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 0);
+
+    bus.Emit<OnPing>(8); // 一次性等待, 不再恢复
+    CORE_CHECK(resumed == 1);
+}
+
+CORE_TEST(AwaitRacesEmitDuringRegistration)
+{
+    // 订阅注册与另一线程的 Emit 竞争: 协程必须恰好恢复一次, 且等待者计数归零
+    for (int round = 0; round < 200; ++round)
+    {
+        Core::Bus::EventBus bus;
+        std::atomic<int> resumed = 0;
+        std::atomic<int> value = 0;
+        std::atomic<bool> stop = false;
+        std::thread emitter([&]
+        {
+            while (!stop.load())
+                bus.Emit<OnPing>(round);
+        });
+        WaitPlain(bus, resumed, value);
+        while (resumed.load() == 0)
+            std::this_thread::yield();
+        stop = true;
+        emitter.join();
+
+        CORE_CHECK(resumed == 1);
+        CORE_CHECK(value == round);
+        CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 0);
+    }
+}
+
+CORE_TEST(CancelledTokenDoesNotSuspend)
+{
+    Core::Bus::EventBus bus;
+    Core::CancellationSource source;
+    source.Cancel();
+
+    WaitResult result;
+    WaitWithCancellation(bus, source.GetToken(), result);
+    CORE_CHECK(result.Resumed);
+    CORE_CHECK(!result.Value);
+    CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 0);
+    CORE_CHECK(bus.SubscriberCount<OnPing>() == 0);
+}
+
+CORE_TEST(CancellationResumesWithEmpty)
+{
+    Core::Bus::EventBus bus;
+    Core::CancellationSource source;
+    WaitResult result;
+    WaitWithCancellation(bus, source.GetToken(), result);
+    CORE_CHECK(!result.Resumed);
+    CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 1);
+
+    source.Cancel();
+    CORE_CHECK(result.Resumed);
+    CORE_CHECK(!result.Value);
+    CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 0);
+    CORE_CHECK(bus.SubscriberCount<OnPing>() == 0);
+}
+
+CORE_TEST(EventBeatsCancellation)
+{
+    Core::Bus::EventBus bus;
+    Core::CancellationSource source;
+    WaitResult result;
+    WaitWithCancellation(bus, source.GetToken(), result);
+
+    bus.Emit<OnPing>(3);
+    CORE_CHECK(result.Resumed);
+    CORE_CHECK(result.Value && std::get<0>(*result.Value) == 3);
+    CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 0);
+
+    // 令牌回调已注销, 之后的取消不会再恢复协程
+    result.Resumed = false;
+    source.Cancel();
+    CORE_CHECK(!result.Resumed);
+}
+
+CORE_TEST(TimeoutResumesWithEmpty)
+{
+    const auto start = Clock::now();
+    Core::TimerWheel wheel(start);
+    Core::Bus::EventBus bus;
+    WaitResult result;
+    WaitWithTimeout(bus, wheel, 5ms, result);
+    CORE_CHECK(wheel.PendingTimers() == 1);
+
+    wheel.Tick(start + 4ms);
+    CORE_CHECK(!result.Resumed);
+    wheel.Tick(start + 5ms);
+    CORE_CHECK(result.Resumed);
+    CORE_CHECK(!result.Value);
+    CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 0);
+    CORE_CHECK(wheel.PendingTimers() == 0);
+
+    result.Resumed = false;
+    bus.Emit<OnPing>(1);
+    CORE_CHECK(!result.Resumed);
+}
+
+CORE_TEST(EventBeatsTimeout)
+{
+    const auto start = Clock::now();
+    Core::TimerWheel wheel(start);
+    Core::Bus::EventBus bus;
+    WaitResult result;
+    WaitWithTimeout(bus, wheel, 5ms, result);
+
+    bus.Emit<OnPing>(9);
+    CORE_CHECK(result.Resumed);
+    CORE_CHECK(result.Value && std::get<0>(*result.Value) == 9);
+    CORE_CHECK(wheel.PendingTimers() == 0); // 定时器节点已摘下
+
+    result.Resumed = false;
+    wheel.Tick(start + 10ms);
+    CORE_CHECK(!result.Resumed);
+}
+
+CORE_TEST(ZeroTimeoutDoesNotSuspend)
+{
+    Core::TimerWheel wheel;
+    Core::Bus::EventBus bus;
+    WaitResult result;
+    WaitWithTimeout(bus, wheel, 0ms, result);
+    CORE_CHECK(result.Resumed);
+    CORE_CHECK(!result.Value);
+    CORE_CHECK(wheel.PendingTimers() == 0);
+}
+
+CORE_TEST(TimeoutRacesEventAndCancellation)
+{
+    // 事件、超时、取消三个来源在不同线程同时触发: 每轮恰好恢复一次, 不残留订阅或定时器
+    for (int round = 0; round < 300; ++round)
+    {
+        auto now = Clock::now();
+        Core::TimerWheel wheel(now);
+        Core::Bus::EventBus bus;
+        Core::CancellationSource source;
+        std::atomic<int> resumed = 0;
+        std::atomic<int> hits = 0;
+
+        WaitGuarded(bus, wheel, source.GetToken(), resumed, hits);
+        std::thread emitter([&] { bus.Emit<OnPing>(round); });
+        std::thread canceller([&] { if (round % 3 == 0) source.Cancel(); });
+        wheel.Tick(now + 2ms);
+        emitter.join();
+        canceller.join();
+
+        CORE_CHECK(resumed == 1);
+        CORE_CHECK(hits <= 1);
+        CORE_CHECK(bus.LiveWaiterCount<OnPing>() == 0);
+        CORE_CHECK(bus.SubscriberCount<OnPing>() == 0);
+        CORE_CHECK(wheel.PendingTimers() == 0);
+    }
+}
+
+CORE_TEST_MAIN()
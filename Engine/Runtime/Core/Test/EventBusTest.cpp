@@ -0,0 +1,163 @@
+#include "Core/Bus/EventBus.h"
+#include "CoreTest.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct OnValue : Core::Bus::Signal<OnValue, int> {};
+
+using namespace std::chrono_literals;
+using FrameClock = Core::Bus::FrameClock;
+
+// 让帧时间进入帧驱动状态并返回起点; FrameClock 只进不退, 各测试从当前时间开始推进
+FrameClock::TimePoint StartFrames()
+{
+    FrameClock::Set(FrameClock::Clock::now());
+    return FrameClock::Now();
+}
+}
+
+CORE_TEST(ThrottleAdmitsLeadingEventPerPeriod)
+{
+    const auto start = StartFrames();
+    Core::Bus::EventBus bus;
+    std::vector<int> values;
+    auto conn = bus.SubscribeThrottled<OnValue>(100ms, [&](int value) { values.push_back(value); });
+
+    bus.Emit<OnValue>(1);   // 第一个事件立即回调
+    bus.Emit<OnValue>(2);   // 同一帧内被抑制
+    FrameClock::Set(start + 50ms);
+    bus.Emit<OnValue>(3);
+    FrameClock::Set(start + 100ms);
+    bus.Emit<OnValue>(4);   // 距上次回调恰好一个周期
+    FrameClock::Set(start + 150ms);
+    bus.Emit<OnValue>(5);
+    FrameClock::Set(start + 250ms);
+    bus.Emit<OnValue>(6);
+    CORE_CHECK((values == std::vector<int>{ 1, 4, 6 }));
+
+    // 被抑制的事件不会在刷新时补发
+    CORE_CHECK(bus.FlushAllAsync() == 0);
+    CORE_CHECK(values.size() == 3);
+}
+
+CORE_TEST(DebounceFiresOnlyFromFlush)
+{
+    const auto start = StartFrames();
+    Core::Bus::EventBus bus;
+    std::vector<int> values;
+    auto conn = bus.SubscribeDebounced<OnValue>(100ms, [&](int value) { values.push_back(value); });
+
+    bus.Emit<OnValue>(1);
+    FrameClock::Set(start + 50ms);
+    bus.Emit<OnValue>(2);   // 静默期从最后一个事件重新计时
+    FrameClock::Set(start + 100ms);
+    CORE_CHECK(bus.FlushAllAsync() == 0);
+    CORE_CHECK(values.empty());
+
+    // 静默期已过, 但 Emit 从不调用防抖回调, 只有刷新才补发
+    FrameClock::Set(start + 150ms);
+    CORE_CHECK(values.empty());
+    CORE_CHECK(bus.FlushAllAsync() == 1);
+    CORE_CHECK((values == std::vector<int>{ 2 }));
+    CORE_CHECK(bus.FlushAllAsync() == 0);
+
+    // FlushAsync<SignalType> 同样补发; 每个静默期只回调一次, 参数取最后一个事件
+    bus.Emit<OnValue>(3);
+    bus.Emit<OnValue>(4);
+    FrameClock::Set(start + 300ms);
+    CORE_CHECK(bus.FlushAsync<OnValue>() == 1);
+    CORE_CHECK((values == std::vector<int>{ 2, 4 }));
+
+    // 断开后待补发的参数被丢弃
+    bus.Emit<OnValue>(5);
+    conn.Disconnect();
+    FrameClock::Set(start + 500ms);
+    CORE_CHECK(bus.FlushAllAsync() == 0);
+    CORE_CHECK(values.size() == 2);
+}
+
+CORE_TEST(SampleAdmitsEveryNthEvent)
+{
+    Core::Bus::EventBus bus;
+    std::vector<int> sampled;
+    std::vector<int> every;
+    auto third = bus.SubscribeSampled<OnValue>(3, [&](int value) { sampled.push_back(value); });
+    auto all   = bus.SubscribeSampled<OnValue>(1, [&](int value) { every.push_back(value); });
+
+    for (int i = 1; i <= 7; ++i)
+        bus.Emit<OnValue>(i);
+    CORE_CHECK((sampled == std::vector<int>{ 1, 4, 7 }));
+    CORE_CHECK(every.size() == 7);
+
+    // 异步事件在刷新时经 Emit 分发, 与同步事件共用计数
+    bus.EmitAsync<OnValue>(8);
+    bus.EmitAsync<OnValue>(9);
+    bus.EmitAsync<OnValue>(10);
+    CORE_CHECK(bus.FlushAllAsync() == 3);
+    CORE_CHECK((sampled == std::vector<int>{ 1, 4, 7, 10 }));
+}
+
+CORE_TEST(PriorityOrdersSubscribers)
+{
+    Core::Bus::EventBus bus;
+    std::string order;
+    auto plain  = bus.Subscribe<OnValue>([&](int) { order += 'a'; });
+    auto low    = bus.SubscribeWithPriority<OnValue>(-5, [&](int) { order += 'L'; });
+    auto high   = bus.SubscribeWithPriority<OnValue>(10, [&](int) { order += 'H'; });
+    auto plain2 = bus.Subscribe<OnValue>([&](int) { order += 'b'; });
+    auto high2  = bus.SubscribeWithPriority<OnValue>(10, [&](int) { order += 'I'; });
+    auto mid    = bus.SubscribeConsumer<OnValue>(5, [&](int) { order += 'M'; return false; });
+
+    // 优先级降序, 同优先级按订阅顺序; 普通订阅为 0
+    CORE_CHECK(!bus.Emit<OnValue>(1));
+    CORE_CHECK(order == "HIMabL");
+
+    // 断开后其余订阅的相对顺序不变
+    high.Disconnect();
+    order.clear();
+    bus.Emit<OnValue>(2);
+    CORE_CHECK(order == "IMabL");
+}
+
+CORE_TEST(ConsumerStopsDispatch)
+{
+    Core::Bus::EventBus bus;
+    Core::Bus::MainThreadExecutor executor;
+    std::vector<int> seen;
+    int lower  = 0;
+    int posted = 0;
+    auto first    = bus.SubscribeWithPriority<OnValue>(20, [&](int value) { seen.push_back(-value); });
+    auto consumer = bus.SubscribeConsumer<OnValue>(10, [&](int value)
+    {
+        seen.push_back(value);
+        return value % 2 == 0; // 只消费偶数
+    });
+    auto plain = bus.Subscribe<OnValue>([&](int) { ++lower; });
+    auto later = bus.SubscribeOn<OnValue>(executor, [&](int) { ++posted; });
+
+    // 被消费: 更高优先级的已经收到, 更低优先级及执行器订阅都不再收到
+    CORE_CHECK(bus.Emit<OnValue>(2));
+    CORE_CHECK((seen == std::vector<int>{ -2, 2 }));
+    CORE_CHECK(lower == 0);
+    CORE_CHECK(executor.RunPending() == 0);
+
+    // 未被消费: 继续传递, Emit 返回 false
+    CORE_CHECK(!bus.Emit<OnValue>(3));
+    CORE_CHECK(lower == 1);
+    CORE_CHECK(executor.RunPending() == 1);
+    CORE_CHECK(posted == 1);
+
+    // 没有可消费订阅时 Emit 总是返回 false
+    consumer.Disconnect();
+    CORE_CHECK(!bus.Emit<OnValue>(4));
+    CORE_CHECK(lower == 2);
+
+    Core::Bus::EventBus empty;
+    CORE_CHECK(!empty.Emit<OnValue>(5));
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,161 @@
+#include "Core/Bus/EventBus.h"
+#include "CoreTest.h"
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+struct OnValue : Core::Bus::Signal<OnValue, int> {};
+
+using namespace std::chrono_literals;
+using Stream = Core::Bus::EventStream<OnValue>;
+
+// 首次 co_await 才注册订阅: 等待并取走一个事件, 之后的事件留在缓冲区
+Core::Bus::EventTask Subscribe(Stream& stream)
+{
+    co_await stream;
+}
+
+Core::Bus::EventTask Collect(Stream& stream, std::vector<int>& values, bool& finished)
+{
+    while (auto event = co_await stream)
+        values.push_back(std::get<0>(*event));
+    finished = true;
+}
+
+std::vector<int> Drain(Stream& stream)
+{
+    std::vector<int> values;
+    while (auto event = stream.TryNext())
+        values.push_back(std::get<0>(*event));
+    return values;
+}
+
+std::vector<int> Values(const std::vector<std::tuple<int>>& batch)
+{
+    std::vector<int> values;
+    for (const auto& [value] : batch)
+        values.push_back(value);
+    return values;
+}
+
+std::vector<int> FillPastCapacity(Core::Bus::EventBus& bus, Core::Bus::EStreamOverflow overflow, uint64_t& dropped)
+{
+    auto stream = bus.Stream<OnValue>({ .Capacity = 3, .Overflow = overflow });
+    Subscribe(stream);
+    bus.Emit<OnValue>(0);
+    for (int i = 1; i <= 5; ++i)
+        bus.Emit<OnValue>(i);
+    dropped = stream.GetDroppedCount();
+    return Drain(stream);
+}
+}
+
+CORE_TEST(StreamResumesOncePerEventUntilStopped)
+{
+    Core::Bus::EventBus bus;
+    auto stream = bus.Stream<OnValue>();
+    std::vector<int> values;
+    bool finished = false;
+    Collect(stream, values, finished);
+
+    for (int i = 1; i <= 3; ++i)
+        bus.Emit<OnValue>(i);
+    CORE_CHECK((values == std::vector<int>{ 1, 2, 3 }));
+    CORE_CHECK(stream.BufferedCount() == 0);
+    CORE_CHECK(!finished);
+
+    stream.Stop();
+    CORE_CHECK(finished);
+    CORE_CHECK(bus.SubscriberCount<OnValue>() == 0);
+}
+
+CORE_TEST(OverflowPolicies)
+{
+    Core::Bus::EventBus bus;
+    uint64_t dropped = 0;
+
+    // 容量 3, 先后到达 1..5
+    CORE_CHECK((FillPastCapacity(bus, Core::Bus::EStreamOverflow::DropOldest, dropped) == std::vector<int>{ 3, 4, 5 }));
+    CORE_CHECK(dropped == 2);
+    CORE_CHECK((FillPastCapacity(bus, Core::Bus::EStreamOverflow::DropNewest, dropped) == std::vector<int>{ 1, 2, 3 }));
+    CORE_CHECK(dropped == 2);
+    CORE_CHECK((FillPastCapacity(bus, Core::Bus::EStreamOverflow::Coalesce, dropped) == std::vector<int>{ 1, 2, 5 }));
+    CORE_CHECK(dropped == 2);
+}
+
+CORE_TEST(TryNextDoesNotSuspend)
+{
+    Core::Bus::EventBus bus;
+    auto stream = bus.Stream<OnValue>();
+    CORE_CHECK(!stream.TryNext());
+
+    // 尚未 co_await 时没有订阅, 事件不会进入缓冲区
+    bus.Emit<OnValue>(1);
+    CORE_CHECK(!stream.TryNext());
+
+    Subscribe(stream);
+    bus.Emit<OnValue>(2);
+    bus.Emit<OnValue>(3);
+    bus.Emit<OnValue>(4);
+    CORE_CHECK(stream.BufferedCount() == 2);
+
+    // 停止后剩余事件仍可取出
+    stream.Stop();
+    bus.Emit<OnValue>(5);
+    CORE_CHECK((Drain(stream) == std::vector<int>{ 3, 4 }));
+    CORE_CHECK(!stream.TryNext());
+}
+
+CORE_TEST(NextBatchTakesBufferedEventsWithoutSuspending)
+{
+    const auto start = Core::TimerWheel::Clock::now();
+    Core::TimerWheel wheel(start);
+    Core::Bus::EventBus bus;
+    auto stream = bus.Stream<OnValue>();
+    std::vector<std::vector<int>> batches;
+    bool finished = false;
+
+    auto consumer = [&]() -> Core::Bus::EventTask
+    {
+        batches.push_back(Values(co_await stream.NextBatch(2)));
+        co_await Core::NextFrame(wheel); // 此间到达的事件进入缓冲区
+        for (;;)
+        {
+            auto batch = co_await stream.NextBatch(2);
+            if (batch.empty())
+                break;
+            batches.push_back(Values(batch));
+        }
+        finished = true;
+    };
+    consumer();
+
+    bus.Emit<OnValue>(1);
+    CORE_CHECK(batches.size() == 1);
+    for (int i = 2; i <= 6; ++i)
+        bus.Emit<OnValue>(i);
+    CORE_CHECK(stream.BufferedCount() == 5);
+
+    wheel.Tick(start + 1ms);
+    CORE_CHECK((batches == std::vector<std::vector<int>>{ { 1 }, { 2, 3 }, { 4, 5 }, { 6 } }));
+    CORE_CHECK(!finished);
+
+    bus.Emit<OnValue>(7);
+    CORE_CHECK(batches.back() == std::vector<int>{ 7 });
+    stream.Stop();
+    CORE_CHECK(finished);
+}
+
+CORE_TEST(NextBatchRejectsZero)
+{
+    Core::Bus::EventBus bus;
+    auto stream = bus.Stream<OnValue>();
+    CORE_CHECK_THROWS(stream.NextBatch(0), std::invalid_argument);
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,139 @@
+#include "Core/Coroutine/FramePool.h"
+#include "Core/Coroutine/Task.h"
+#include "CoreTest.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Core::FramePool;
+
+uint64_t Allocations(size_t bucket)
+{
+    return FramePool::GetStats().Buckets[bucket].Allocations;
+}
+
+int64_t Live(size_t bucket)
+{
+    return FramePool::GetStats().Buckets[bucket].Live;
+}
+
+Core::Task<int> Small()
+{
+    co_return 1;
+}
+}
+
+CORE_TEST(SizesMapToBuckets)
+{
+    const auto stats = FramePool::GetStats();
+    CORE_CHECK(stats.Buckets[0].FrameSize == FramePool::BucketGranularity);
+    CORE_CHECK(stats.Buckets[FramePool::BucketCount - 1].FrameSize == FramePool::MaxPooledSize);
+
+    const uint64_t first = Allocations(0);
+    const uint64_t second = Allocations(1);
+    const uint64_t last = Allocations(FramePool::BucketCount - 1);
+    void* a = FramePool::Allocate(1);
+    void* b = FramePool::Allocate(FramePool::BucketGranularity);
+    void* c = FramePool::Allocate(FramePool::BucketGranularity + 1);
+    void* d = FramePool::Allocate(FramePool::MaxPooledSize);
+    CORE_CHECK(Allocations(0) == first + 2);
+    CORE_CHECK(Allocations(1) == second + 1);
+    CORE_CHECK(Allocations(FramePool::BucketCount - 1) == last + 1);
+    CORE_CHECK(reinterpret_cast<uintptr_t>(c) % FramePool::BucketGranularity == 0);
+
+    FramePool::Deallocate(a, 1);
+    FramePool::Deallocate(b, FramePool::BucketGranularity);
+    FramePool::Deallocate(c, FramePool::BucketGranularity + 1);
+    FramePool::Deallocate(d, FramePool::MaxPooledSize);
+
+    // 释放后同桶的下一次分配复用刚释放的块
+    void* again = FramePool::Allocate(FramePool::BucketGranularity);
+    CORE_CHECK(again == b);
+    FramePool::Deallocate(again, FramePool::BucketGranularity);
+}
+
+CORE_TEST(OversizedFramesUseGlobalHeap)
+{
+    const auto before = FramePool::GetStats();
+    const size_t size = FramePool::MaxPooledSize + 1;
+    void* block = FramePool::Allocate(size);
+    const auto after = FramePool::GetStats();
+    CORE_CHECK(after.OversizedAllocations == before.OversizedAllocations + 1);
+    CORE_CHECK(after.LargestFrameSize >= size);
+    CORE_CHECK(after.ReservedBytes == before.ReservedBytes);
+    CORE_CHECK(FramePool::ThreadCachedCount(size) == 0);
+    FramePool::Deallocate(block, size);
+}
+
+CORE_TEST(CrossThreadFreeReturnsToFreeingThread)
+{
+    constexpr size_t size = 5 * FramePool::BucketGranularity;
+    constexpr size_t bucket = 4;
+    const int64_t live = Live(bucket);
+
+    std::vector<void*> blocks;
+    std::thread allocator([&]
+    {
+        for (int i = 0; i < 100; ++i)
+            blocks.push_back(FramePool::Allocate(size));
+    });
+    allocator.join(); // 分配线程退出, 其缓存归还全局链表
+    CORE_CHECK(Live(bucket) == live + 100);
+
+    std::thread releaser([&]
+    {
+        const size_t cached = FramePool::ThreadCachedCount(size);
+        for (void* block : blocks)
+            FramePool::Deallocate(block, size);
+        CORE_CHECK(FramePool::ThreadCachedCount(size) == cached + 100);
+        // 释放线程随后可以直接复用这些块
+        void* reused = FramePool::Allocate(size);
+        CORE_CHECK(reused == blocks.back());
+        FramePool::Deallocate(reused, size);
+    });
+    releaser.join();
+    CORE_CHECK(Live(bucket) == live);
+}
+
+CORE_TEST(ThreadCacheStaysBounded)
+{
+    std::thread worker([]
+    {
+        constexpr size_t size = 7 * FramePool::BucketGranularity;
+        // 新线程第一次分配: 即使需要切分新 Chunk, 缓存也只取一批
+        void* first = FramePool::Allocate(size);
+        CORE_CHECK(FramePool::ThreadCachedCount(size) < FramePool::MaxCachedPerBucket / 2);
+
+        std::vector<void*> blocks{ first };
+        for (size_t i = 0; i < 3 * FramePool::MaxCachedPerBucket; ++i)
+        {
+            blocks.push_back(FramePool::Allocate(size));
+            CORE_CHECK(FramePool::ThreadCachedCount(size) <= FramePool::MaxCachedPerBucket);
+        }
+        for (void* block : blocks)
+        {
+            FramePool::Deallocate(block, size);
+            CORE_CHECK(FramePool::ThreadCachedCount(size) <= FramePool::MaxCachedPerBucket);
+        }
+    });
+    worker.join();
+}
+
+CORE_TEST(CoroutineFramesComeFromPool)
+{
+    const auto before = FramePool::GetStats();
+    CORE_CHECK(Core::SyncWait(Small()) == 1);
+    const auto after = FramePool::GetStats();
+
+    uint64_t allocations = 0;
+    for (size_t i = 0; i < FramePool::BucketCount; ++i)
+    {
+        allocations += after.Buckets[i].Allocations - before.Buckets[i].Allocations;
+        CORE_CHECK(after.Buckets[i].Live == before.Buckets[i].Live);
+    }
+    CORE_CHECK(allocations == 2); // Small 与 SyncWait 的包装协程
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,59 @@
+#include "Core/Bus/Executor.h"
+#include "CoreTest.h"
+
+#include <stdexcept>
+#include <vector>
+
+CORE_TEST(RunPendingDoesNotRerunAfterThrow)
+{
+    Core::Bus::MainThreadExecutor executor;
+    int counter = 0;
+    int after = 0;
+    executor.Post([&] { ++counter; });
+    executor.Post([] { throw std::runtime_error("task"); });
+    executor.Post([&] { ++after; });
+
+    CORE_CHECK_THROWS(executor.RunPending(), std::runtime_error);
+    CORE_CHECK(counter == 1);
+    CORE_CHECK(after == 0);
+    CORE_CHECK(executor.PendingCount() == 1); // 未执行的任务放回队列
+
+    CORE_CHECK(executor.RunPending() == 1);
+    CORE_CHECK(executor.RunPending() == 0);
+    CORE_CHECK(counter == 1);
+    CORE_CHECK(after == 1);
+}
+
+CORE_TEST(RunPendingKeepsOrderOfRequeuedTasks)
+{
+    Core::Bus::MainThreadExecutor executor;
+    std::vector<int> order;
+    executor.Post([] { throw std::runtime_error("task"); });
+    executor.Post([&] { order.push_back(1); });
+    executor.Post([&] { order.push_back(2); });
+
+    CORE_CHECK_THROWS(executor.RunPending(), std::runtime_error);
+    executor.Post([&] { order.push_back(3); });
+    CORE_CHECK(executor.RunPending() == 3);
+    CORE_CHECK((order == std::vector<int>{ 1, 2, 3 }));
+}
+
+CORE_TEST(NestedRunPending)
+{
+    Core::Bus::MainThreadExecutor executor;
+    std::vector<int> order;
+    executor.Post([&]
+    {
+        order.push_back(1);
+        executor.Post([&] { order.push_back(3); });
+        CORE_CHECK(executor.RunPending() == 1); // 外层批次不受影响
+        order.push_back(4);
+    });
+    executor.Post([&] { order.push_back(5); });
+
+    CORE_CHECK(executor.RunPending() == 2);
+    CORE_CHECK((order == std::vector<int>{ 1, 3, 4, 5 }));
+    CORE_CHECK(executor.RunPending() == 0);
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,143 @@
+#include "Core/Bus/SharedMemoryTransport.h"
+#include "CoreTest.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if CORE_BUS_HAS_SHARED_MEMORY
+    #include <sys/wait.h>
+#endif
+
+namespace
+{
+struct FrameStats
+{
+    uint32_t Frame;
+    float    Milliseconds;
+};
+
+struct OnFrameStats : Core::Bus::Signal<OnFrameStats, FrameStats> {};
+struct OnHitch      : Core::Bus::Signal<OnHitch, uint32_t, double> {};
+struct OnUnrouted   : Core::Bus::Signal<OnUnrouted, int> {};
+
+// 每个测试进程使用独立的名字, 避免并行运行的 ctest 互相干扰
+std::string UniqueName(const char* tag)
+{
+    return "/core_test_" + std::string(tag) + "_" + std::to_string(::getpid());
+}
+}
+
+#if CORE_BUS_HAS_SHARED_MEMORY
+
+CORE_TEST(TwoProcessRoundTrip)
+{
+    constexpr uint32_t EventCount = 1000;
+    const std::string  name       = UniqueName("roundtrip");
+
+    Core::Bus::EventBus              engineBus;
+    Core::Bus::SharedMemoryTransport out(engineBus, name, Core::Bus::SharedMemoryTransport::ERole::Producer);
+    out.Mirror<OnFrameStats>().Mirror<OnHitch>().Mirror<OnUnrouted>();
+
+    const pid_t child = ::fork();
+    CORE_CHECK(child >= 0);
+    if (child == 0)
+    {
+        // 工具进程: 只用退出码汇报结果, 不经过测试框架
+        Core::Bus::EventBus              toolBus;
+        Core::Bus::SharedMemoryTransport in(toolBus, name, Core::Bus::SharedMemoryTransport::ERole::Consumer);
+        in.Route<OnFrameStats>().Route<OnHitch>();
+
+        uint32_t nextFrame = 0;
+        uint32_t hitches   = 0;
+        bool     ordered   = true;
+        auto statsConn = toolBus.Subscribe<OnFrameStats>([&](const FrameStats& stats)
+        {
+            ordered = ordered && stats.Frame == nextFrame && stats.Milliseconds == float(nextFrame) * 0.5f;
+            ++nextFrame;
+        });
+        auto hitchConn = toolBus.Subscribe<OnHitch>([&](const uint32_t& frame, const double& ms)
+        {
+            ordered = ordered && frame % 100 == 0 && ms == double(frame);
+            ++hitches;
+        });
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while ((nextFrame < EventCount || in.GetUnroutedCount() < 1) && std::chrono::steady_clock::now() < deadline)
+        {
+            if (in.Poll() == 0)
+                std::this_thread::yield();
+        }
+        const bool ok = ordered && nextFrame == EventCount && hitches == EventCount / 100
+            && in.GetUnroutedCount() == 1 && in.GetMismatchCount() == 0;
+        ::_exit(ok ? 0 : 1);
+    }
+
+    for (uint32_t frame = 0; frame < EventCount; ++frame)
+    {
+        engineBus.Emit<OnFrameStats>(FrameStats{frame, float(frame) * 0.5f});
+        if (frame % 100 == 0)
+            engineBus.Emit<OnHitch>(frame, double(frame));
+    }
+    engineBus.Emit<OnUnrouted>(7);
+    CORE_CHECK(out.GetDroppedCount() == 0);
+
+    int status = 0;
+    CORE_CHECK(::waitpid(child, &status, 0) == child);
+    CORE_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+CORE_TEST(ThrowingSubscriberDoesNotJamRing)
+{
+    const std::string name = UniqueName("throw");
+
+    Core::Bus::EventBus              engineBus;
+    Core::Bus::SharedMemoryTransport out(engineBus, name, Core::Bus::SharedMemoryTransport::ERole::Producer);
+    out.Mirror<OnFrameStats>();
+
+    Core::Bus::EventBus              toolBus;
+    Core::Bus::SharedMemoryTransport in(toolBus, name, Core::Bus::SharedMemoryTransport::ERole::Consumer);
+    in.Route<OnFrameStats>();
+
+    uint32_t received = 0;
+    auto conn = toolBus.Subscribe<OnFrameStats>([&received](const FrameStats& stats)
+    {
+        if (stats.Frame == 1)
+            throw std::runtime_error("subscriber");
+        ++received;
+    });
+
+    for (uint32_t frame = 0; frame < 4; ++frame)
+        engineBus.Emit<OnFrameStats>(FrameStats{frame, 0.0f});
+
+    CORE_CHECK_THROWS(in.Poll(), std::runtime_error);
+    CORE_CHECK(received == 1);
+    CORE_CHECK(in.Poll() == 2); // 抛出的那条已出队, 其余继续可读
+    CORE_CHECK(received == 3);
+    CORE_CHECK(in.PendingCount() == 0);
+
+    // 环形缓冲区仍可继续写入
+    engineBus.Emit<OnFrameStats>(FrameStats{4, 0.0f});
+    CORE_CHECK(in.Poll() == 1);
+    CORE_CHECK(received == 4);
+}
+
+CORE_TEST(ProducerDoesNotReplaceExistingSegment)
+{
+    const std::string name = UniqueName("exclusive");
+
+    Core::Bus::EventBus              bus;
+    Core::Bus::SharedMemoryTransport first(bus, name, Core::Bus::SharedMemoryTransport::ERole::Producer);
+    CORE_CHECK_THROWS(Core::Bus::SharedMemoryTransport(bus, name, Core::Bus::SharedMemoryTransport::ERole::Producer),
+                      std::runtime_error);
+
+    // 显式声明为残留后才会被替换
+    Core::Bus::SharedMemoryTransport replaced(bus, name, Core::Bus::SharedMemoryTransport::ERole::Producer,
+                                              Core::Bus::SharedMemoryTransport::ECreateMode::ReplaceStale);
+    CORE_CHECK(replaced.GetName() == name);
+}
+
+#endif
+
+CORE_TEST_MAIN()
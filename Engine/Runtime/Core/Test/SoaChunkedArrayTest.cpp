@@ -0,0 +1,169 @@
+#include "Core/SoA/SoaChunkedArray.h"
+#include "CoreTest.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+// 置位后下一次全局 operator new 抛出 std::bad_alloc (仅一次)
+bool GFailNextAllocation = false;
+
+// 存活实例计数, 用于检查构造失败时的回滚
+int GCountedAlive = 0;
+
+struct Counted
+{
+    Counted() { ++GCountedAlive; }
+    Counted(const Counted&) { ++GCountedAlive; }
+    ~Counted() { --GCountedAlive; }
+};
+
+// 默认构造在计数归零时抛出
+int GDefaultsBeforeThrow = -1;
+
+struct ThrowOnDefault
+{
+    ThrowOnDefault()
+    {
+        if (GDefaultsBeforeThrow >= 0 && GDefaultsBeforeThrow-- == 0)
+            throw std::runtime_error("ThrowOnDefault");
+    }
+};
+
+size_t Address(const void* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p);
+}
+}
+
+void* operator new(std::size_t bytes)
+{
+    if (GFailNextAllocation)
+    {
+        GFailNextAllocation = false;
+        throw std::bad_alloc();
+    }
+    if (void* p = std::malloc(bytes ? bytes : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+CORE_TEST(RowAddressesStableAcrossGrowth)
+{
+    using Array = Core::BasicSoaChunkedArray<4, int, std::string>;
+    Array array;
+    for (int i = 0; i < 3; ++i)
+        array.PushBack(i, std::string(40, static_cast<char>('a' + i)));
+    const int* first = &array.Get<0>(0);
+    const std::string* third = &array.Get<1>(2);
+
+    for (int i = 3; i < 200; ++i)
+        array.PushBack(i, std::string(40, static_cast<char>('a' + i % 26)));
+    CORE_CHECK(&array.Get<0>(0) == first);
+    CORE_CHECK(&array.Get<1>(2) == third);
+    CORE_CHECK(*third == std::string(40, 'c'));
+
+    // 块内每列起始地址按 64 字节对齐; 除最后一块外每块恰好 4 行
+    size_t rows = 0;
+    array.ForEachChunk([&](size_t firstRow, std::span<int> ints, std::span<std::string> strings)
+    {
+        CORE_CHECK(firstRow == rows);
+        CORE_CHECK(Address(ints.data()) % Array::ColumnAlignment == 0);
+        CORE_CHECK(Address(strings.data()) % Array::ColumnAlignment == 0);
+        CORE_CHECK(ints.size() == strings.size());
+        CORE_CHECK(ints[0] == static_cast<int>(firstRow));
+        rows += ints.size();
+    });
+    CORE_CHECK(rows == 200);
+}
+
+CORE_TEST(ShrinkToFitReturnsChunksToPool)
+{
+    using Array = Core::BasicSoaChunkedArray<4, int, double>;
+    Core::SoaChunkPool pool(Array::ChunkBytes, Array::ChunkAlignment);
+    {
+        Array array(pool);
+        array.Reserve(40);
+        CORE_CHECK(array.Capacity() == 40);
+        for (int i = 0; i < 5; ++i)
+            array.PushBack(i, i * 0.5);
+
+        array.ShrinkToFit();
+        CORE_CHECK(array.Capacity() == 8);
+        CORE_CHECK(pool.CachedCount() == 8);
+        CORE_CHECK(array.Get<1>(4) == 2.0);
+
+        // 再次扩容优先复用池中的块
+        array.Reserve(16);
+        CORE_CHECK(pool.CachedCount() == 6);
+    }
+    CORE_CHECK(pool.CachedCount() == 10); // 析构时全部归还
+    pool.Trim();
+    CORE_CHECK(pool.CachedCount() == 0);
+}
+
+CORE_TEST(EmplaceRowRollsBackFailedRow)
+{
+    {
+        Core::BasicSoaChunkedArray<4, int, Counted, ThrowOnDefault> array;
+        array.Resize(2);
+        CORE_CHECK(GCountedAlive == 2);
+
+        // 第 2 个新行的最后一列构造失败: 该行已构造的列被析构, 之前的行保留
+        GDefaultsBeforeThrow = 1;
+        CORE_CHECK_THROWS(array.Resize(5), std::runtime_error);
+        GDefaultsBeforeThrow = -1;
+        CORE_CHECK(array.Size() == 3);
+        CORE_CHECK(GCountedAlive == 3);
+
+        array.Resize(5);
+        CORE_CHECK(GCountedAlive == 5);
+    }
+    CORE_CHECK(GCountedAlive == 0);
+}
+
+CORE_TEST(EmplaceRowDoesNotLeakChunkWhenIndexGrowthFails)
+{
+    using Array = Core::BasicSoaChunkedArray<4, int, int>;
+    Core::SoaChunkPool pool(Array::ChunkBytes, Array::ChunkAlignment);
+    Array array(pool);
+    for (int i = 0; i < 16; ++i)
+        array.PushBack(i, i);
+    pool.Release(pool.Acquire()); // 池中缓存一个块, 取块本身不再分配
+
+    // 块指针数组已满, 追加第 17 行需要扩大它; 分配失败时取到的块不能丢失
+    GFailNextAllocation = true;
+    CORE_CHECK_THROWS(array.PushBack(16, 16), std::bad_alloc);
+    GFailNextAllocation = false;
+    CORE_CHECK(pool.CachedCount() == 1);
+    CORE_CHECK(array.Size() == 16);
+    CORE_CHECK(array.Capacity() == 16);
+
+    array.PushBack(16, 16);
+    CORE_CHECK(pool.CachedCount() == 0);
+    CORE_CHECK(array.Get<1>(16) == 16);
+}
+
+CORE_TEST(MismatchedPoolIsRejected)
+{
+    using Array = Core::BasicSoaChunkedArray<4, int, double>;
+    Core::SoaChunkPool wrongSize(Array::ChunkBytes * 2, Array::ChunkAlignment);
+    Core::SoaChunkPool wrongAlignment(Array::ChunkBytes, 16);
+    CORE_CHECK_THROWS(Array{ wrongSize }, std::invalid_argument);
+    CORE_CHECK_THROWS(Array{ wrongAlignment }, std::invalid_argument);
+
+    Core::SoaChunkPool matching(Array::ChunkBytes, Array::ChunkAlignment);
+    Array array(matching);
+    array.PushBack(1, 1.0);
+    CORE_CHECK(array.Size() == 1);
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,439 @@
+#include "Core/SoA/SoaDynamicArray.h"
+#include "CoreTest.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+// 存活实例计数, 用于检查重复析构 / 泄漏
+int GTrackedAlive = 0;
+
+// 持有堆内存, 特化为可平凡重定位 (按字节搬运)
+struct Tracked
+{
+    int* Value = nullptr;
+
+    explicit Tracked(int value = 0) : Value(new int(value)) { ++GTrackedAlive; }
+    Tracked(const Tracked& other) : Value(new int(*other.Value)) { ++GTrackedAlive; }
+    Tracked(Tracked&& other) noexcept : Value(other.Value) { other.Value = nullptr; ++GTrackedAlive; }
+    Tracked& operator=(const Tracked& other) { *Value = *other.Value; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { std::swap(Value, other.Value); return *this; }
+    ~Tracked() { delete Value; --GTrackedAlive; }
+};
+
+// 拷贝在计数归零时抛出, 移动不是 noexcept, 因此搬运时走拷贝路径
+int GCopiesBeforeThrow = -1;
+
+struct ThrowOnCopy
+{
+    int Value = 0;
+
+    ThrowOnCopy() = default;
+    explicit ThrowOnCopy(int value) : Value(value) {}
+    ThrowOnCopy(const ThrowOnCopy& other) : Value(other.Value)
+    {
+        if (GCopiesBeforeThrow >= 0 && GCopiesBeforeThrow-- == 0)
+            throw std::runtime_error("ThrowOnCopy");
+    }
+    ThrowOnCopy(ThrowOnCopy&& other) noexcept(false) : ThrowOnCopy(std::as_const(other)) {}
+    ThrowOnCopy& operator=(const ThrowOnCopy&) = default;
+};
+}
+
+template <>
+struct Core::IsTriviallyRelocatable<Tracked> : std::true_type {};
+
+namespace
+{
+// 按行读出 Tracked 列的值, 并检查字符串列与之一致
+std::vector<int> TrackedValues(const Core::SoaDynamicArray<Tracked, std::string>& array)
+{
+    std::vector<int> values;
+    for (size_t i = 0; i < array.Size(); ++i)
+    {
+        const int value = *array.Column<0>()[i].Value;
+        CORE_CHECK(array.Column<1>()[i] == std::string(32, static_cast<char>('a' + value)));
+        values.push_back(value);
+    }
+    return values;
+}
+
+// 记录每次分配的 memory_resource, 用于检查单块布局与泄漏
+struct CountingResource : std::pmr::memory_resource
+{
+    size_t Allocations = 0;
+    size_t Outstanding = 0;
+    void*  LastBlock = nullptr;
+    size_t LastBytes = 0;
+    size_t LastAlign = 0;
+    bool   AllPadded = true; // 每次分配的大小都是 64 的倍数, 对齐至少 64
+
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        ++Allocations;
+        AllPadded = AllPadded && bytes % 64 == 0 && align >= 64;
+        ++Outstanding;
+        LastBytes = bytes;
+        LastAlign = align;
+        return LastBlock = std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        --Outstanding;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+struct alignas(128) Wide
+{
+    float Lanes[32] = {};
+};
+
+size_t Address(const void* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p);
+}
+
+Core::SoaDynamicArray<Tracked, std::string> MakeTracked(int count)
+{
+    Core::SoaDynamicArray<Tracked, std::string> array;
+    for (int i = 0; i < count; ++i)
+        array.PushBack(Tracked(i), std::string(32, static_cast<char>('a' + i)));
+    return array;
+}
+}
+
+CORE_TEST(SortedOrderEmptyAndSingle)
+{
+    Core::SoaDynamicArray<int, float, std::string> array;
+    CORE_CHECK(array.SortedOrder<0>().empty());
+    CORE_CHECK(array.SortedOrder<1>(std::greater<>{}).empty());
+    CORE_CHECK(array.SortedOrder<2>().empty());
+    array.SortBy<0>();
+    array.SortBy<float>(std::greater<>{});
+    array.SortBy<2>();
+    CORE_CHECK(array.Size() == 0);
+
+    array.PushBack(7, 1.5f, std::string("x"));
+    CORE_CHECK(array.SortedOrder<0>() == std::vector<size_t>{ 0 });
+    CORE_CHECK(array.SortedOrder<1>(std::greater<>{}) == std::vector<size_t>{ 0 });
+    CORE_CHECK(array.SortedOrder<2>() == std::vector<size_t>{ 0 });
+    array.SortBy<0>();
+    CORE_CHECK(array.Size() == 1);
+    CORE_CHECK(array.Column<0>()[0] == 7);
+    CORE_CHECK(array.Column<2>()[0] == "x");
+}
+
+CORE_TEST(SortByRadixMatchesStableSort)
+{
+    Core::SoaDynamicArray<int, int> array;
+    const std::vector<int> keys{ 3, -1, 3, 0, -7, 12, 0, 3 };
+    for (size_t i = 0; i < keys.size(); ++i)
+        array.PushBack(keys[i], static_cast<int>(i));
+
+    array.SortBy<0>();
+    const std::vector<int> sorted_keys(array.Column<0>().begin(), array.Column<0>().end());
+    const std::vector<int> rows(array.Column<1>().begin(), array.Column<1>().end());
+    CORE_CHECK((sorted_keys == std::vector<int>{ -7, -1, 0, 0, 3, 3, 3, 12 }));
+    CORE_CHECK((rows == std::vector<int>{ 4, 1, 3, 6, 0, 2, 7, 5 })); // 稳定
+}
+
+CORE_TEST(ApplyPermutationRollsBackOnThrow)
+{
+    {
+        Core::SoaDynamicArray<Tracked, std::string, ThrowOnCopy> array;
+        for (int i = 0; i < 8; ++i)
+            array.PushBack(Tracked(i), std::string(32, static_cast<char>('a' + i)), ThrowOnCopy(i));
+        CORE_CHECK(GTrackedAlive == 8);
+
+        const std::vector<size_t> order{ 7, 6, 5, 4, 3, 2, 1, 0 };
+        GCopiesBeforeThrow = 4;
+        CORE_CHECK_THROWS(array.ApplyPermutation(order), std::runtime_error);
+        GCopiesBeforeThrow = -1;
+
+        // 失败后数组保持原样: 没有被移走的行, 没有重复析构
+        CORE_CHECK(GTrackedAlive == 8);
+        for (int i = 0; i < 8; ++i)
+        {
+            CORE_CHECK(*array.Column<0>()[i].Value == i);
+            CORE_CHECK(array.Column<1>()[i] == std::string(32, static_cast<char>('a' + i)));
+            CORE_CHECK(array.Column<2>()[i].Value == i);
+        }
+
+        array.ApplyPermutation(order);
+        CORE_CHECK(GTrackedAlive == 8);
+        CORE_CHECK(*array.Column<0>()[0].Value == 7);
+        CORE_CHECK(array.Column<1>()[0] == std::string(32, 'h'));
+        CORE_CHECK(array.Column<2>()[0].Value == 7);
+    }
+    CORE_CHECK(GTrackedAlive == 0);
+}
+
+CORE_TEST(ApplyPermutationRejectsNonPermutation)
+{
+    {
+        Core::SoaDynamicArray<Tracked, std::string> array;
+        array.PushBack(Tracked(0), std::string(32, 'a'));
+        array.PushBack(Tracked(1), std::string(32, 'b'));
+
+        const std::vector<size_t> outOfRange{ 1, 7 };
+        const std::vector<size_t> duplicate{ 0, 0 };
+        CORE_CHECK_THROWS(array.ApplyPermutation(outOfRange), std::invalid_argument);
+        CORE_CHECK_THROWS(array.ApplyPermutation(duplicate), std::invalid_argument);
+
+        CORE_CHECK(GTrackedAlive == 2);
+        CORE_CHECK(*array.Column<0>()[0].Value == 0);
+        CORE_CHECK(*array.Column<0>()[1].Value == 1);
+        CORE_CHECK(array.Column<1>()[1] == std::string(32, 'b'));
+    }
+    CORE_CHECK(GTrackedAlive == 0);
+}
+
+CORE_TEST(SwapRemoveAtFillsFromBack)
+{
+    {
+        auto array = MakeTracked(5);
+        array.SwapRemoveAt(1);
+        CORE_CHECK((TrackedValues(array) == std::vector<int>{ 0, 4, 2, 3 }));
+        array.SwapRemoveAt(3); // 末尾元素: 直接移除
+        CORE_CHECK((TrackedValues(array) == std::vector<int>{ 0, 4, 2 }));
+        CORE_CHECK(GTrackedAlive == 3);
+
+        CORE_CHECK_THROWS(array.SwapRemoveAt(3), std::out_of_range);
+        CORE_CHECK(array.Size() == 3);
+
+        array.SwapRemoveAt(0);
+        array.SwapRemoveAt(0);
+        array.SwapRemoveAt(0);
+        CORE_CHECK(array.IsEmpty());
+        CORE_CHECK(GTrackedAlive == 0);
+        CORE_CHECK_THROWS(array.SwapRemoveAt(0), std::out_of_range);
+    }
+    CORE_CHECK(GTrackedAlive == 0);
+}
+
+CORE_TEST(EraseIfKeepsRelativeOrder)
+{
+    {
+        auto array = MakeTracked(8);
+        const auto isOdd = [](auto row) { return *std::get<0>(row).Value % 2 != 0; };
+        CORE_CHECK(array.EraseIf(isOdd) == 4);
+        CORE_CHECK((TrackedValues(array) == std::vector<int>{ 0, 2, 4, 6 }));
+        CORE_CHECK(GTrackedAlive == 4);
+
+        CORE_CHECK(array.EraseIf(isOdd) == 0);
+        CORE_CHECK(array.Size() == 4);
+        CORE_CHECK(array.EraseIf([](auto) { return true; }) == 4);
+        CORE_CHECK(array.IsEmpty());
+        CORE_CHECK(GTrackedAlive == 0);
+    }
+    CORE_CHECK(GTrackedAlive == 0);
+}
+
+CORE_TEST(RemoveIndicesKeepsRelativeOrder)
+{
+    {
+        auto array = MakeTracked(8);
+        const std::vector<size_t> indices{ 0, 3, 4, 7 };
+        CORE_CHECK(array.RemoveIndices(indices) == 4);
+        CORE_CHECK((TrackedValues(array) == std::vector<int>{ 1, 2, 5, 6 }));
+        CORE_CHECK(GTrackedAlive == 4);
+
+        CORE_CHECK(array.RemoveIndices({}) == 0);
+        CORE_CHECK(array.Size() == 4);
+    }
+    CORE_CHECK(GTrackedAlive == 0);
+}
+
+CORE_TEST(RemoveIndicesRejectsInvalidIndices)
+{
+    {
+        auto array = MakeTracked(4);
+        const std::vector<size_t> unsorted{ 2, 1 };
+        const std::vector<size_t> duplicate{ 1, 1, 2 };
+        const std::vector<size_t> outOfRange{ 0, 4 };
+        CORE_CHECK_THROWS(array.RemoveIndices(unsorted), std::invalid_argument);
+        CORE_CHECK_THROWS(array.RemoveIndices(duplicate), std::invalid_argument);
+        CORE_CHECK_THROWS(array.RemoveIndices(outOfRange), std::invalid_argument);
+
+        // 校验先于任何移动: 数组保持不变
+        CORE_CHECK((TrackedValues(array) == std::vector<int>{ 0, 1, 2, 3 }));
+        CORE_CHECK(GTrackedAlive == 4);
+    }
+    CORE_CHECK(GTrackedAlive == 0);
+}
+
+CORE_TEST(SingleBlockLayoutAndAlignment)
+{
+    using Array = Core::SoaBlockArray<char, double, Wide>;
+    CountingResource resource;
+    {
+        Array array(&resource);
+        array.Reserve(10);
+        for (int i = 0; i < 10; ++i)
+            array.PushBack(static_cast<char>('a' + i), i * 0.5, Wide{});
+        CORE_CHECK(resource.Allocations == 1); // 所有列一次分配
+        CORE_CHECK(resource.LastAlign == 128);  // 各列对齐要求的最大值
+
+        // 各列依次排布在块内: 起始地址按列对齐, 每列大小向上取整到 64 字节
+        const size_t block = Address(resource.LastBlock);
+        const size_t columns[] = { Address(array.Column<0>().data()), Address(array.Column<1>().data()),
+                                   Address(array.Column<2>().data()) };
+        CORE_CHECK(columns[0] == block);
+        CORE_CHECK(columns[1] == block + 64);                 // 10 个 char → 64 字节
+        CORE_CHECK(columns[2] == block + 256);                // 10 个 double → 80 → 128 字节, 止于 192, 再按 128 对齐
+        CORE_CHECK(resource.LastBytes == 256 + 10 * sizeof(Wide));
+        CORE_CHECK(columns[1] % 64 == 0 && columns[2] % 128 == 0);
+
+        for (int i = 0; i < 10; ++i)
+            CORE_CHECK(array.Column<0>()[i] == 'a' + i && array.Column<1>()[i] == i * 0.5);
+    }
+    CORE_CHECK(resource.Outstanding == 0);
+}
+
+CORE_TEST(SingleBlockGrowthRelocatesNonTrivialColumns)
+{
+    CountingResource resource;
+    {
+        Core::SoaBlockArray<int, std::string, Tracked> array(&resource);
+        for (int i = 0; i < 300; ++i)
+            array.PushBack(i, std::string(40, static_cast<char>('a' + i % 26)), Tracked(i));
+        CORE_CHECK(GTrackedAlive == 300);
+        CORE_CHECK(resource.Outstanding == 1); // 旧块在每次扩容后释放
+
+        // std::string 逐个移动构造, Tracked 按字节搬运, 两者都不能丢失或重复
+        for (int i = 0; i < 300; ++i)
+        {
+            CORE_CHECK(array.Column<0>()[i] == i);
+            CORE_CHECK(array.Column<1>()[i] == std::string(40, static_cast<char>('a' + i % 26)));
+            CORE_CHECK(*array.Column<2>()[i].Value == i);
+        }
+
+        array.ShrinkToFit();
+        CORE_CHECK(array.Capacity() == 300);
+        CORE_CHECK(array.Column<1>()[299] == std::string(40, static_cast<char>('a' + 299 % 26)));
+        CORE_CHECK(GTrackedAlive == 300);
+    }
+    CORE_CHECK(GTrackedAlive == 0);
+    CORE_CHECK(resource.Outstanding == 0);
+}
+
+CORE_TEST(GrowToRollsBackOnThrow)
+{
+    // ThrowOnCopy 位于最后一列: 其前面的列在旧实现中会先被搬走
+    const auto check = []<typename Array>(std::type_identity<Array>)
+    {
+        CountingResource resource;
+        {
+            Array array(&resource);
+            for (int i = 0; i < 8; ++i)
+                array.PushBack(Tracked(i), std::string(32, static_cast<char>('a' + i)), ThrowOnCopy(i));
+            const size_t capacity = array.Capacity();
+            const size_t outstanding = resource.Outstanding;
+
+            GCopiesBeforeThrow = 3;
+            CORE_CHECK_THROWS(array.Reserve(capacity * 4), std::runtime_error);
+            GCopiesBeforeThrow = -1;
+
+            CORE_CHECK(array.Capacity() == capacity);
+            CORE_CHECK(resource.Outstanding == outstanding); // 新内存已释放
+            CORE_CHECK(GTrackedAlive == 8);
+            for (int i = 0; i < 8; ++i)
+            {
+                CORE_CHECK(*array.template Column<0>()[i].Value == i);
+                CORE_CHECK(array.template Column<1>()[i] == std::string(32, static_cast<char>('a' + i)));
+                CORE_CHECK(array.template Column<2>()[i].Value == i);
+            }
+
+            array.Reserve(capacity * 4);
+            CORE_CHECK(array.Capacity() == capacity * 4);
+            CORE_CHECK(array.template Column<1>()[7] == std::string(32, 'h'));
+            CORE_CHECK(array.template Column<2>()[7].Value == 7);
+            CORE_CHECK(GTrackedAlive == 8);
+        }
+        CORE_CHECK(GTrackedAlive == 0);
+        CORE_CHECK(resource.Outstanding == 0);
+    };
+    check(std::type_identity<Core::SoaBlockArray<Tracked, std::string, ThrowOnCopy>>{});
+    check(std::type_identity<Core::SoaDynamicArray<Tracked, std::string, ThrowOnCopy>>{});
+}
+
+CORE_TEST(ColumnsAreAlignedAndPadded)
+{
+    const auto check = []<typename Array>(std::type_identity<Array>)
+    {
+        CountingResource resource;
+        for (const size_t rows : { 1u, 63u, 65u, 100u })
+        {
+            Array array(&resource);
+            for (size_t i = 0; i < rows; ++i)
+                array.PushBack(static_cast<char>(i), static_cast<float>(i), Wide{});
+            CORE_CHECK(Address(array.template Column<0>().data()) % 64 == 0);
+            CORE_CHECK(Address(array.template Column<1>().data()) % 64 == 0);
+            CORE_CHECK(Address(array.template Column<2>().data()) % alignof(Wide) == 0);
+            CORE_CHECK(array.template Column<float>().data() == array.template Column<1>().data());
+            CORE_CHECK(array.template Column<Wide>().size() == rows);
+        }
+        CORE_CHECK(resource.AllPadded);
+        CORE_CHECK(resource.Outstanding == 0);
+    };
+    check(std::type_identity<Core::SoaDynamicArray<char, float, Wide>>{});
+    check(std::type_identity<Core::SoaBlockArray<char, float, Wide>>{});
+}
+
+CORE_TEST(ForEachColumnChunkBoundaries)
+{
+    Core::SoaDynamicArray<char, int, double> array;
+    for (int i = 0; i < 1000; ++i)
+        array.PushBack(static_cast<char>(i), i, i * 0.5);
+
+    // 100 行向上取整为 128 行: 7 个整块加 104 行的尾块, 每块在各列中都从 64 字节边界开始
+    std::vector<size_t> firsts, counts;
+    array.ForEachColumnChunk([&](size_t first, std::span<char> chars, std::span<int> ints, std::span<double> doubles)
+    {
+        CORE_CHECK(chars.size() == ints.size() && ints.size() == doubles.size());
+        CORE_CHECK(Address(chars.data()) % 64 == 0);
+        CORE_CHECK(Address(ints.data()) % 64 == 0);
+        CORE_CHECK(Address(doubles.data()) % 64 == 0);
+        CORE_CHECK(ints.front() == static_cast<int>(first));
+        CORE_CHECK(ints.back() == static_cast<int>(first + ints.size() - 1));
+        firsts.push_back(first);
+        counts.push_back(ints.size());
+    }, 100);
+    CORE_CHECK((firsts == std::vector<size_t>{ 0, 128, 256, 384, 512, 640, 768, 896 }));
+    CORE_CHECK((counts == std::vector<size_t>{ 128, 128, 128, 128, 128, 128, 128, 104 }));
+
+    // 只遍历部分列; 行数恰为块大小的整数倍时没有空尾块; 块行数 0 视为 64
+    const auto& constArray = array;
+    size_t chunks = 0;
+    double sum = 0;
+    constArray.ForEachColumnChunk<2>([&](size_t, std::span<const double> doubles)
+    {
+        ++chunks;
+        for (const double value : doubles)
+            sum += value;
+    }, 500);
+    CORE_CHECK(chunks == 2); // 500 → 512: 512 + 488
+    CORE_CHECK(sum == 0.5 * 999 * 1000 / 2);
+
+    array.Resize(256);
+    chunks = 0;
+    array.ForEachColumnChunk<1>([&](size_t, std::span<int> ints) { ++chunks; CORE_CHECK(ints.size() == 128); }, 128);
+    CORE_CHECK(chunks == 2);
+    chunks = 0;
+    array.ForEachColumnChunk<0>([&](size_t, std::span<char>) { ++chunks; }, 0);
+    CORE_CHECK(chunks == 4);
+
+    array.Clear();
+    chunks = 0;
+    array.ForEachColumnChunk([&](size_t, auto...) { ++chunks; });
+    CORE_CHECK(chunks == 0);
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,200 @@
+#include "Core/SoA/SoaDynamicArray.h"
+#include "Core/SoA/SoaMemoryResource.h"
+#include "CoreTest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <utility>
+
+namespace
+{
+// 统计经过的分配, 作为被测资源的 upstream
+struct CountingResource : std::pmr::memory_resource
+{
+    size_t Allocations = 0;
+    size_t Outstanding = 0;
+
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        ++Allocations;
+        ++Outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        --Outstanding;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+size_t Address(const void* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p);
+}
+}
+
+CORE_TEST(FrameArenaBumpsAndAligns)
+{
+    CountingResource upstream;
+    {
+        Core::SoaFrameArena arena(4096, &upstream);
+        CORE_CHECK(upstream.Allocations == 1);
+        CORE_CHECK(arena.Capacity() == 4096);
+
+        void* a = arena.allocate(10, 1);
+        void* b = arena.allocate(100, 64);
+        void* c = arena.allocate(8, 8);
+        CORE_CHECK(Address(b) % 64 == 0);
+        CORE_CHECK(Address(c) % 8 == 0);
+        CORE_CHECK(Address(b) >= Address(a) + 10);
+        CORE_CHECK(Address(c) >= Address(b) + 100);
+        CORE_CHECK(arena.BytesUsed() == Address(c) + 8 - Address(a));
+
+        // deallocate 是空操作, 内存在 Reset 时统一回收
+        arena.deallocate(b, 100, 64);
+        CORE_CHECK(arena.BytesUsed() == Address(c) + 8 - Address(a));
+        CORE_CHECK(upstream.Allocations == 1);
+    }
+    CORE_CHECK(upstream.Outstanding == 0);
+}
+
+CORE_TEST(FrameArenaResetCoalescesBlocks)
+{
+    CountingResource upstream;
+    {
+        Core::SoaFrameArena arena(4096, &upstream);
+        (void)arena.allocate(3000, 8);
+        (void)arena.allocate(3000, 8); // 放不下: 追加一个至少翻倍的块
+        CORE_CHECK(arena.BlockCount() == 2);
+        CORE_CHECK(arena.Capacity() == 4096 + 8192);
+        CORE_CHECK(arena.BytesUsed() >= 6000);
+        (void)arena.allocate(20000, 8); // 超过翻倍大小: 新块至少容纳本次分配
+        CORE_CHECK(arena.BlockCount() == 3);
+        const size_t total = arena.Capacity();
+        CORE_CHECK(upstream.Allocations == 3);
+
+        // Reset 把多个块合并为一个总容量相同的块
+        arena.Reset();
+        CORE_CHECK(arena.BlockCount() == 1);
+        CORE_CHECK(arena.Capacity() == total);
+        CORE_CHECK(arena.BytesUsed() == 0);
+        CORE_CHECK(upstream.Allocations == 4);
+        CORE_CHECK(upstream.Outstanding == 1);
+
+        // 稳定后: 同样的用量不再向 upstream 申请, 单块时 Reset 也不分配
+        (void)arena.allocate(3000, 8);
+        (void)arena.allocate(3000, 8);
+        (void)arena.allocate(20000, 8);
+        arena.Reset();
+        CORE_CHECK(upstream.Allocations == 4);
+
+        // 作为 SoA 数组的内存资源: 扩容留下的旧列在 Reset 时一并回收
+        {
+            Core::SoaDynamicArray<int, double> array(&arena);
+            for (int i = 0; i < 1000; ++i)
+                array.PushBack(i, i * 0.5);
+            CORE_CHECK(array.GetResource() == &arena);
+            CORE_CHECK(array.Column<1>()[999] == 499.5);
+        }
+        CORE_CHECK(arena.BytesUsed() > 0);
+        arena.Reset();
+        CORE_CHECK(arena.BytesUsed() == 0);
+        CORE_CHECK(arena.BlockCount() == 1);
+    }
+    CORE_CHECK(upstream.Outstanding == 0);
+}
+
+CORE_TEST(HugePageResourceRoutesBySizeAndFallsBack)
+{
+    CountingResource upstream;
+    constexpr size_t threshold = 64 << 10;
+    for (const bool tryHugeTlb : { true, false })
+    {
+        Core::SoaHugePageResource resource(threshold, tryHugeTlb, &upstream);
+
+        // 小于阈值或对齐超过大页的分配交给 upstream
+        void* small = resource.allocate(1024, 64);
+        CORE_CHECK(upstream.Allocations == 1);
+        resource.deallocate(small, 1024, 64);
+        CORE_CHECK(upstream.Outstanding == 0);
+
+        void* large = resource.allocate(threshold, 64);
+#if CORE_SOA_HAS_MMAP_ANON
+        CORE_CHECK(upstream.Allocations == 1);
+        CORE_CHECK(Address(large) % Core::SoaHugePageResource::HugePageBytes == 0);
+        // 显式大页不可用 (未预留 vm.nr_hugepages) 或被关闭时退化为透明大页
+        CORE_CHECK(resource.HugeTlbAllocations() + resource.TransparentAllocations() == 1);
+        if (!tryHugeTlb)
+            CORE_CHECK(resource.HugeTlbAllocations() == 0 && resource.TransparentAllocations() == 1);
+#else
+        CORE_CHECK(upstream.Allocations == 2);
+#endif
+        std::memset(large, 0xAB, threshold);
+        CORE_CHECK(static_cast<unsigned char*>(large)[threshold - 1] == 0xAB);
+        resource.deallocate(large, threshold, 64);
+        CORE_CHECK(upstream.Outstanding == 0);
+        upstream.Allocations = 0;
+    }
+
+    // 经由 SoA 数组使用: 列分配达到阈值后走映射
+    Core::SoaHugePageResource resource(threshold, true, &upstream);
+    {
+        Core::SoaDynamicArray<float> heights(&resource);
+        heights.Reserve(threshold / sizeof(float));
+        heights.PushBack(1.5f);
+        CORE_CHECK(heights.Column<0>()[0] == 1.5f);
+#if CORE_SOA_HAS_MMAP_ANON
+        CORE_CHECK(Address(heights.Column<0>().data()) % Core::SoaHugePageResource::HugePageBytes == 0);
+#endif
+    }
+    CORE_CHECK(upstream.Outstanding == 0);
+}
+
+CORE_TEST(MoveAndSwapCarryTheResource)
+{
+    Core::SoaFrameArena first(1 << 16), second(1 << 16);
+
+    Core::SoaDynamicArray<int, double> a(&first);
+    for (int i = 0; i < 10; ++i)
+        a.PushBack(i, i * 2.0);
+    const int* data = a.Column<0>().data();
+    const size_t used = first.BytesUsed();
+
+    // 移动构造 / 移动赋值: 内存与资源一起转移, 不重新分配
+    Core::SoaDynamicArray<int, double> b(std::move(a));
+    CORE_CHECK(b.GetResource() == &first);
+    CORE_CHECK(b.Column<0>().data() == data);
+    CORE_CHECK(a.Size() == 0);
+
+    Core::SoaDynamicArray<int, double> c;
+    CORE_CHECK(c.GetResource() == std::pmr::get_default_resource());
+    c = std::move(b);
+    CORE_CHECK(c.GetResource() == &first);
+    CORE_CHECK(c.Column<0>().data() == data);
+    CORE_CHECK(first.BytesUsed() == used);
+
+    // 拷贝构造使用默认资源, 拷贝赋值保留目标自己的资源
+    Core::SoaDynamicArray<int, double> copy(c);
+    CORE_CHECK(copy.GetResource() == std::pmr::get_default_resource());
+    Core::SoaDynamicArray<int, double> assigned(&second);
+    assigned = c;
+    CORE_CHECK(assigned.GetResource() == &second);
+    CORE_CHECK(assigned.Column<1>()[9] == 18.0);
+    CORE_CHECK(first.BytesUsed() == used);
+
+    // Swap 交换资源: 之后的扩容从对方的资源分配
+    Core::SoaDynamicArray<int, double> d(&second);
+    d.PushBack(100, 100.0);
+    swap(c, d);
+    CORE_CHECK(c.GetResource() == &second && d.GetResource() == &first);
+    CORE_CHECK(c.Size() == 1 && d.Size() == 10);
+    const size_t secondUsed = second.BytesUsed();
+    c.Reserve(1000);
+    CORE_CHECK(second.BytesUsed() > secondUsed);
+    CORE_CHECK(first.BytesUsed() == used);
+    CORE_CHECK(c.Column<0>()[0] == 100);
+}
+
+CORE_TEST_MAIN()
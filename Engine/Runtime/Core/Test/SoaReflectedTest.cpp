@@ -0,0 +1,52 @@
+#include "Core/SoA/SoaReflected.h"
+#include "CoreTest.h"
+
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+struct Particle
+{
+    float Position = 0.0f;
+    float Life = 0.0f;
+    int Id = 0;
+};
+
+// 只提供 SoaReflected.h 用到的 name / pointer, 避免依赖完整的反射头
+template<typename Member>
+struct FieldEntry
+{
+    std::string_view name;
+    Member pointer;
+};
+}
+
+template<>
+struct TypeInfo<Particle>
+{
+    static constexpr std::tuple variables{
+        FieldEntry<float Particle::*>{ "Position", &Particle::Position },
+        FieldEntry<float Particle::*>{ "Life", &Particle::Life },
+        FieldEntry<int Particle::*>{ "Id", &Particle::Id },
+    };
+};
+
+CORE_TEST(GatherKeepsReflectedType)
+{
+    const std::vector<Particle> particles{ { 1.0f, 10.0f, 1 }, { 2.0f, 20.0f, 2 }, { 3.0f, 30.0f, 3 } };
+    const auto array = Core::ReflectedSoaArray<Particle>::FromAoS(particles);
+
+    const std::vector<size_t> indices{ 2, 0, 2 };
+    auto gathered = array.Gather(indices);
+    static_assert(std::is_same_v<decltype(gathered), Core::ReflectedSoaArray<Particle>>);
+
+    CORE_CHECK(gathered.Size() == 3);
+    CORE_CHECK(gathered.Field<"Id">()[0] == 3);
+    CORE_CHECK(gathered.Field<"Id">()[1] == 1);
+    CORE_CHECK(gathered.Field<&Particle::Life>()[2] == 30.0f);
+    CORE_CHECK(gathered.GetRow(1).Position == 1.0f);
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,39 @@
+#include "Core/SoA/SoaSnapshot.h"
+#include "CoreTest.h"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+std::string TempPath()
+{
+    return "/tmp/CoreSoaSnapshotTest." + std::to_string(::getpid()) + ".bin";
+}
+}
+
+CORE_TEST(SnapshotRoundTrip)
+{
+    Core::SoaDynamicArray<int, double> array;
+    for (int i = 0; i < 1000; ++i)
+        array.PushBack(i, i * 0.5);
+
+    const std::string path = TempPath();
+    Core::SaveSnapshot(array, path);
+
+    // 列数据偏移经 SeekTo 定位, 整文件长度经 FileSize 读取
+    const auto loaded = Core::LoadSnapshot<int, double>(path);
+    CORE_CHECK(loaded.Size() == array.Size());
+    CORE_CHECK(loaded.Column<0>()[999] == 999);
+    CORE_CHECK(loaded.Column<1>()[10] == 5.0);
+
+    const auto mapped = Core::SoaMappedArray<int, double>::MapReadOnly(path);
+    CORE_CHECK(mapped.Size() == array.Size());
+    CORE_CHECK(mapped.Column<0>()[500] == 500);
+
+    CORE_CHECK_THROWS((Core::LoadSnapshot<int, float>(path)), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,106 @@
+#include "Core/Bus/StaticEventBus.h"
+#include "CoreTest.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace
+{
+struct OnDamage : Core::Bus::Signal<OnDamage, int, std::string> {};
+struct OnTick   : Core::Bus::Signal<OnTick> {};
+}
+
+CORE_TEST(SelfDisconnectDuringEmit)
+{
+    Core::Bus::StaticEventBus<OnDamage, OnTick> bus;
+
+    // 捕获 shared_ptr 的 lambda 放在堆上, 断开时若立即 Reset 会在执行中释放自身
+    auto                                  payload = std::make_shared<std::string>("owned by the callback");
+    std::optional<Core::Bus::Connection>  self;
+    int                                   calls = 0;
+    self = bus.Subscribe<OnDamage>([&self, &calls, payload](int damage, const std::string& source)
+    {
+        self.reset();                         // 断开自身
+        calls += damage;
+        CORE_CHECK(*payload == "owned by the callback"); // 断开后仍可访问捕获
+        CORE_CHECK(source == "Fireball");
+    });
+
+    int otherCalls = 0;
+    auto other = bus.Subscribe<OnDamage>([&otherCalls](int, const std::string&) { ++otherCalls; });
+
+    CORE_CHECK(!bus.Emit<OnDamage>(5, std::string("Fireball")));
+    CORE_CHECK(calls == 5);
+    CORE_CHECK(otherCalls == 1);
+    CORE_CHECK(bus.SubscriberCount<OnDamage>() == 1);
+    CORE_CHECK(payload.use_count() == 1); // 最外层 Emit 结束后回调已被回收
+
+    bus.Emit<OnDamage>(5, std::string("Fireball"));
+    CORE_CHECK(calls == 5);
+    CORE_CHECK(otherCalls == 2);
+}
+
+CORE_TEST(DisconnectOtherAndSubscribeDuringNestedEmit)
+{
+    Core::Bus::StaticEventBus<OnDamage, OnTick> bus;
+
+    int tickCalls = 0;
+    int lateCalls = 0;
+    std::optional<Core::Bus::Connection> tick;
+    std::optional<Core::Bus::Connection> late;
+    tick = bus.Subscribe<OnTick>([&tickCalls] { ++tickCalls; });
+
+    auto damage = bus.Subscribe<OnDamage>([&](int, const std::string&)
+    {
+        bus.Emit<OnTick>();  // 嵌套 Emit
+        tick.reset();        // 断开另一个信号的订阅
+        late = bus.Subscribe<OnTick>([&lateCalls] { ++lateCalls; });
+        bus.Emit<OnTick>();  // 新订阅在最外层 Emit 结束前不生效
+    });
+
+    bus.Emit<OnDamage>(1, std::string());
+    CORE_CHECK(tickCalls == 1);
+    CORE_CHECK(lateCalls == 0);
+    CORE_CHECK(bus.SubscriberCount<OnTick>() == 1);
+
+    bus.Emit<OnTick>();
+    CORE_CHECK(tickCalls == 1);
+    CORE_CHECK(lateCalls == 1);
+}
+
+CORE_TEST(ConsumingSubscriberStopsEmit)
+{
+    Core::Bus::StaticEventBus<OnDamage, OnTick> bus;
+
+    int  after   = 0;
+    auto first   = bus.Subscribe<OnDamage>([](int damage, const std::string&) { return damage > 10; });
+    auto second  = bus.Subscribe<OnDamage>([&after](int, const std::string&) { ++after; });
+
+    CORE_CHECK(!bus.Emit<OnDamage>(5, std::string()));
+    CORE_CHECK(after == 1);
+    CORE_CHECK(bus.Emit<OnDamage>(50, std::string()));
+    CORE_CHECK(after == 1);
+}
+
+CORE_TEST(ThrowingCallbackLeavesBusUsable)
+{
+    Core::Bus::StaticEventBus<OnDamage, OnTick> bus;
+
+    std::optional<Core::Bus::Connection> thrower;
+    thrower = bus.Subscribe<OnTick>([&thrower]
+    {
+        thrower.reset();
+        throw std::runtime_error("tick");
+    });
+    CORE_CHECK_THROWS(bus.Emit<OnTick>(), std::runtime_error);
+    CORE_CHECK(bus.SubscriberCount<OnTick>() == 0);
+
+    // EmitDepth 已恢复: 新订阅立即生效
+    int calls = 0;
+    auto conn = bus.Subscribe<OnTick>([&calls] { ++calls; });
+    bus.Emit<OnTick>();
+    CORE_CHECK(calls == 1);
+}
+
+CORE_TEST_MAIN()
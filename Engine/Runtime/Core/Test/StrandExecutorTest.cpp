@@ -0,0 +1,94 @@
+#include "Core/Bus/Executor.h"
+#include "CoreTest.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// 手动驱动的底层执行器, 像 ThreadPool 一样吞掉任务抛出的异常
+class ManualExecutor final : public Core::Bus::IExecutor
+{
+public:
+    std::vector<std::function<void()>> Tasks;
+    size_t                             Exceptions = 0;
+
+    void Post(std::function<void()> work) override { Tasks.push_back(std::move(work)); }
+
+    void RunAll()
+    {
+        while (!Tasks.empty())
+        {
+            auto task = std::move(Tasks.front());
+            Tasks.erase(Tasks.begin());
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                ++Exceptions;
+            }
+        }
+    }
+};
+}
+
+CORE_TEST(StrandSurvivesThrowingTask)
+{
+    ManualExecutor              target;
+    Core::Bus::StrandExecutor   strand(target);
+    std::vector<int>            order;
+
+    strand.Post([&order] { order.push_back(0); });
+    strand.Post([] { throw std::runtime_error("task"); });
+    strand.Post([&order] { order.push_back(2); });
+    strand.Post([&order] { order.push_back(3); });
+    CORE_CHECK(target.Tasks.size() == 1); // 只投递了一个 Drain
+
+    target.RunAll();
+    CORE_CHECK(target.Exceptions == 1);
+    CORE_CHECK((order == std::vector<int>{ 0, 2, 3 })); // 剩余任务按顺序执行
+
+    // Scheduled 已复位: 之后的 Post 会重新投递
+    strand.Post([&order] { order.push_back(4); });
+    CORE_CHECK(target.Tasks.size() == 1);
+    target.RunAll();
+    CORE_CHECK((order == std::vector<int>{ 0, 2, 3, 4 }));
+}
+
+CORE_TEST(StrandKeepsOrderWhenPostingDuringRequeue)
+{
+    ManualExecutor            target;
+    Core::Bus::StrandExecutor strand(target);
+    std::vector<int>          order;
+
+    strand.Post([&] {
+        strand.Post([&order] { order.push_back(9); }); // 投递于失败之前, 应排在剩余批次之后
+        throw std::runtime_error("task");
+    });
+    strand.Post([&order] { order.push_back(1); });
+
+    target.RunAll();
+    CORE_CHECK((order == std::vector<int>{ 1, 9 }));
+}
+
+CORE_TEST(StrandOnThreadPoolSurvivesThrowingTask)
+{
+    // 独立线程池: WaitForIdle 之后不再有 Drain 访问 strand
+    ThreadPool                   pool(2, "StrandExecutorTest");
+    Core::Bus::ThreadPoolExecutor executor(pool);
+    Core::Bus::StrandExecutor    strand(executor);
+    std::atomic<int>             ran{0};
+
+    strand.Post([&ran] { ++ran; });
+    strand.Post([] { throw std::runtime_error("task"); });
+    strand.Post([&ran] { ++ran; });
+    strand.Post([&ran] { ++ran; });
+
+    pool.WaitForIdle();
+    CORE_CHECK(ran.load() == 3);
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,87 @@
+#include "Core/Coroutine/Task.h"
+#include "Core/ThreadPool/ThreadPool.h"
+#include "CoreTest.h"
+
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+// GCC 在未优化或 AddressSanitizer 插桩时不把 resume 生成为尾调用, 此时只验证结果
+#if defined(__SANITIZE_ADDRESS__) || (defined(__GNUC__) && !defined(__clang__) && !defined(__OPTIMIZE__))
+constexpr int ChainDepth = 1000;
+#else
+constexpr int ChainDepth = 200000;
+#endif
+
+Core::Task<int> Value(int value, bool& started)
+{
+    started = true;
+    co_return value;
+}
+
+Core::Task<int> Chain(int depth)
+{
+    if (depth == 0)
+        co_return 0;
+    co_return co_await Chain(depth - 1) + 1;
+}
+
+Core::Task<void> Throws()
+{
+    throw std::runtime_error("task");
+    co_return;
+}
+
+Core::Task<int> AwaitsThrowing()
+{
+    co_await Throws();
+    co_return 1;
+}
+
+Core::Task<std::thread::id> OnPool(ThreadPool& pool)
+{
+    co_await pool.Schedule();
+    co_return std::this_thread::get_id();
+}
+}
+
+CORE_TEST(TaskStartsLazily)
+{
+    bool started = false;
+    Core::Task<int> task = Value(5, started);
+    CORE_CHECK(!started);
+    CORE_CHECK(!task.IsDone());
+    CORE_CHECK(Core::SyncWait(std::move(task)) == 5);
+    CORE_CHECK(started);
+
+    // 未被等待的任务析构时直接销毁帧, 协程体从未执行
+    started = false;
+    {
+        Core::Task<int> unused = Value(6, started);
+    }
+    CORE_CHECK(!started);
+}
+
+CORE_TEST(DeepAwaitChainUsesSymmetricTransfer)
+{
+    // 每层都是 co_await 子任务 + 对称转移返回; 若 resume 在调用栈上嵌套, 该深度会溢出栈
+    CORE_CHECK(Core::SyncWait(Chain(ChainDepth)) == ChainDepth);
+}
+
+CORE_TEST(ExceptionPropagatesThroughSyncWait)
+{
+    CORE_CHECK_THROWS(Core::SyncWait(Throws()), std::runtime_error);
+    CORE_CHECK_THROWS(Core::SyncWait(AwaitsThrowing()), std::runtime_error);
+}
+
+CORE_TEST(ScheduleMovesToPoolThread)
+{
+    ThreadPool pool(2, "TaskTest");
+    const std::thread::id caller = std::this_thread::get_id();
+    for (int i = 0; i < 20; ++i)
+        CORE_CHECK(Core::SyncWait(OnPool(pool)) != caller);
+    pool.WaitForIdle();
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,215 @@
+#include "Core/Coroutine/TimerWheel.h"
+#include "CoreTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using namespace std::chrono_literals;
+using Clock = Core::TimerWheel::Clock;
+
+// 立即开始、结束时挂起的协程: 帧由测试持有并销毁, 以便在恢复前取消
+struct Waiter
+{
+    struct promise_type
+    {
+        Waiter get_return_object() { return { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> Handle;
+};
+
+Waiter WaitDelay(Core::TimerWheel& wheel, Core::TimerWheel::Duration delay, Clock::time_point& firedAt)
+{
+    co_await Core::Delay(delay, wheel);
+    firedAt = wheel.Now();
+}
+
+template <typename Awaiter>
+Waiter WaitOn(Awaiter& awaiter, std::atomic<bool>& resumed)
+{
+    co_await awaiter;
+    std::this_thread::sleep_for(20us); // 放大 Tick 在锁外恢复的窗口
+    resumed.store(true);
+}
+
+Waiter WaitFrames(Core::TimerWheel& wheel, int frames, int& resumed)
+{
+    for (int i = 0; i < frames; ++i)
+    {
+        co_await Core::NextFrame(wheel);
+        ++resumed;
+    }
+}
+
+Waiter WaitUntil(Core::TimerWheel& wheel, const int& value, int& checks, bool& resumed)
+{
+    co_await Core::Until([&] { ++checks; return value >= 3; }, wheel);
+    resumed = true;
+}
+}
+
+CORE_TEST(DelaysExpireExactlyOnTheirTick)
+{
+    // 覆盖 Level 0 / 1 / 2 / 3 及各层边界; 起点偏移让 cascade 发生在不对齐的位置
+    const std::vector<std::chrono::milliseconds> delays = {
+        1ms, 2ms, 255ms, 256ms, 257ms, 511ms, 512ms, 16383ms, 16384ms, 16385ms, 1048575ms, 1048576ms, 20min
+    };
+    for (const auto offset : { 0ms, 1ms, 255ms, 300ms, 16383ms })
+    {
+        const auto start = Clock::now();
+        Core::TimerWheel wheel(start);
+        wheel.Tick(start + offset);
+
+        std::vector<Clock::time_point> firedAt(delays.size());
+        std::vector<Waiter> waiters;
+        for (size_t i = 0; i < delays.size(); ++i)
+            waiters.push_back(WaitDelay(wheel, delays[i], firedAt[i]));
+        CORE_CHECK(wheel.PendingTimers() == delays.size());
+
+        for (size_t i = 0; i < delays.size(); ++i)
+        {
+            const auto expire = start + offset + delays[i];
+            wheel.Tick(expire - 1ms);
+            CORE_CHECK(!waiters[i].Handle.done());
+            wheel.Tick(expire);
+            CORE_CHECK(waiters[i].Handle.done());
+            CORE_CHECK(firedAt[i] == expire);
+            CORE_CHECK(wheel.PendingTimers() == delays.size() - i - 1);
+        }
+        for (auto& waiter : waiters)
+            waiter.Handle.destroy();
+    }
+}
+
+CORE_TEST(DelayRoundsUpToResolution)
+{
+    const auto start = Clock::now();
+    Core::TimerWheel wheel(start);
+    Clock::time_point firedAt;
+    Waiter waiter = WaitDelay(wheel, 1us, firedAt);
+    wheel.Tick(start);
+    CORE_CHECK(!waiter.Handle.done());
+    wheel.Tick(start + 1ms);
+    CORE_CHECK(waiter.Handle.done());
+    waiter.Handle.destroy();
+
+    // 不大于零的时长不挂起
+    Waiter immediate = WaitDelay(wheel, 0ms, firedAt);
+    CORE_CHECK(immediate.Handle.done());
+    CORE_CHECK(wheel.PendingTimers() == 0);
+    immediate.Handle.destroy();
+}
+
+CORE_TEST(CancelledDelayIsNotResumed)
+{
+    const auto start = Clock::now();
+    Core::TimerWheel wheel(start);
+    std::atomic<bool> resumed = false;
+    auto delay = Core::Delay(5ms, wheel);
+    Waiter waiter = WaitOn(delay, resumed);
+    CORE_CHECK(wheel.PendingTimers() == 1);
+
+    CORE_CHECK(delay.Cancel());
+    CORE_CHECK(!delay.Cancel());
+    CORE_CHECK(wheel.PendingTimers() == 0);
+    wheel.Tick(start + 10ms);
+    CORE_CHECK(!resumed);
+    waiter.Handle.destroy();
+}
+
+CORE_TEST(NextFrameResumesOncePerTick)
+{
+    const auto start = Clock::now();
+    Core::TimerWheel wheel(start);
+    int resumed = 0;
+    Waiter waiter = WaitFrames(wheel, 3, resumed);
+
+    // 恢复后立即再次等待的协程留到下一次 Tick
+    CORE_CHECK(wheel.Tick(start + 1ms) == 1);
+    CORE_CHECK(resumed == 1);
+    CORE_CHECK(wheel.Tick(start + 1ms) == 1);
+    CORE_CHECK(resumed == 2);
+    CORE_CHECK(wheel.Tick(start + 2ms) == 1);
+    CORE_CHECK(resumed == 3);
+    CORE_CHECK(waiter.Handle.done());
+    CORE_CHECK(wheel.Tick(start + 3ms) == 0);
+    waiter.Handle.destroy();
+}
+
+CORE_TEST(UntilEvaluatesPredicateEachTick)
+{
+    const auto start = Clock::now();
+    Core::TimerWheel wheel(start);
+    int value = 0;
+    int checks = 0;
+    bool resumed = false;
+    Waiter waiter = WaitUntil(wheel, value, checks, resumed);
+    CORE_CHECK(checks == 1); // await_ready 先求值一次
+    CORE_CHECK(!resumed);
+
+    for (int frame = 1; frame <= 2; ++frame)
+    {
+        ++value;
+        wheel.Tick(start + frame * 1ms);
+        CORE_CHECK(!resumed);
+    }
+    ++value;
+    wheel.Tick(start + 3ms);
+    CORE_CHECK(resumed);
+    CORE_CHECK(checks == 4);
+    waiter.Handle.destroy();
+
+    // 一开始就成立则不挂起
+    checks = 0;
+    resumed = false;
+    Waiter ready = WaitUntil(wheel, value, checks, resumed);
+    CORE_CHECK(resumed && checks == 1);
+    ready.Handle.destroy();
+}
+
+CORE_TEST(CancelFromAnotherThreadWaitsForInFlightResume)
+{
+    // Cancel 与 Tick 在不同线程竞争: 要么取消成功且协程不再恢复,
+    // 要么返回 false, 且返回时恢复已经结束 (此后销毁帧是安全的)
+    for (int round = 0; round < 500; ++round)
+    {
+        const auto start = Clock::now();
+        Core::TimerWheel wheel(start);
+        std::atomic<bool> resumed = false;
+        std::atomic<bool> go = false;
+        bool cancelled = false;
+        bool consistent = false;
+
+        auto delay = Core::Delay(1ms, wheel);
+        auto frame = Core::NextFrame(wheel);
+        Waiter waiter = round % 2 == 0 ? WaitOn(delay, resumed) : WaitOn(frame, resumed);
+
+        std::thread canceller([&]
+        {
+            while (!go.load())
+                std::this_thread::yield();
+            cancelled = round % 2 == 0 ? delay.Cancel() : frame.Cancel();
+            consistent = cancelled || resumed.load();
+        });
+        go = true;
+        wheel.Tick(start + 1ms);
+        canceller.join();
+
+        CORE_CHECK(consistent);
+        CORE_CHECK(cancelled != resumed.load());
+        CORE_CHECK(wheel.PendingTimers() == 0);
+        waiter.Handle.destroy();
+    }
+}
+
+CORE_TEST_MAIN()
@@ -0,0 +1,132 @@
+#include "Core/GameObject/GameObject.h"
+#include "CoreTest.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+struct Position { float X = 0, Y = 0; };
+struct Velocity { float X = 0, Y = 0; };
+struct Name     { std::string Value; };
+struct Health   { int Value = 0; };
+
+// 拷贝在计数归零时抛出, 移动不是 noexcept: 迁移时走拷贝
+int GCopiesBeforeThrow = -1;
+
+struct Fragile
+{
+    int Value = 0;
+
+    Fragile() = default;
+    explicit Fragile(int value) : Value(value) {}
+    Fragile(const Fragile& other) : Value(other.Value)
+    {
+        if (GCopiesBeforeThrow >= 0 && GCopiesBeforeThrow-- == 0)
+            throw std::runtime_error("Fragile");
+    }
+    Fragile(Fragile&& other) noexcept(false) : Value(std::exchange(other.Value, -1)) {}
+    Fragile& operator=(const Fragile&) = default;
+    Fragile& operator=(Fragile&&) noexcept = default;
+};
+}
+
+CORE_TEST(AddComponentCreatesUnregisteredArchetype)
+{
+    Core::World world;
+    auto e = world.Spawn(Position{1, 2}, Velocity{3, 4}, Name{"first"});
+    CORE_CHECK(world.ArchetypeCount() == 1);
+
+    world.AddComponent(e, Health{100}); // {Position, Velocity, Name, Health} 从未注册过
+    CORE_CHECK(world.ArchetypeCount() == 2);
+    CORE_CHECK(world.Has<Health>(e));
+    CORE_CHECK(world.TryGet<Health>(e)->Value == 100);
+    CORE_CHECK(world.TryGet<Position>(e)->X == 1);
+    CORE_CHECK(world.TryGet<Name>(e)->Value == "first");
+
+    world.RemoveComponent<Velocity>(e); // {Position, Name, Health} 同样是新组合
+    CORE_CHECK(world.ArchetypeCount() == 3);
+    CORE_CHECK(!world.Has<Velocity>(e));
+    CORE_CHECK(world.TryGet<Name>(e)->Value == "first");
+
+    Core::GameObject object(world, e);
+    object.Remove<Name>();
+    object.Remove<Position>();
+    CORE_CHECK(object.IsValid());
+    CORE_CHECK(object.Get<Health>()->Value == 100);
+    CORE_CHECK(!object.Has<Position>());
+
+    auto& healthy = world.GetQuery<Health>();
+    CORE_CHECK(healthy.Count() == 1);
+}
+
+CORE_TEST(DynamicArchetypeGrowsAndSwapRemoves)
+{
+    Core::World world;
+    std::vector<Core::EntityId> entities;
+    for (int i = 0; i < 1000; ++i)
+    {
+        entities.push_back(world.Spawn(Position{float(i), 0}, Name{"entity " + std::to_string(i)}));
+        world.AddComponent(entities.back(), Health{i});
+    }
+    CORE_CHECK((world.GetQuery<Position, Name>().GetArchetypes().size() == 2));
+    CORE_CHECK(world.GetQuery<Health>().Count() == 1000);
+
+    for (int i = 0; i < 1000; i += 3)
+        world.Destroy(entities[i]);
+
+    size_t visited = 0;
+    world.GetQuery<const Position, const Name, const Health>().ForEach(
+        [&](const Position& p, const Name& n, const Health& h)
+        {
+            CORE_CHECK(int(p.X) == h.Value);
+            CORE_CHECK(n.Value == "entity " + std::to_string(h.Value));
+            ++visited;
+        });
+    CORE_CHECK(visited == world.EntityCount());
+    for (int i = 0; i < 1000; ++i)
+        CORE_CHECK(world.IsAlive(entities[i]) == (i % 3 != 0));
+}
+
+CORE_TEST(FailedMigrationLeavesEntityUnchanged)
+{
+    Core::World world;
+    auto e     = world.Spawn(Fragile{7}, Name{"kept"});
+    auto other = world.Spawn(Fragile{8}, Name{"other"});
+
+    GCopiesBeforeThrow = 0;
+    CORE_CHECK_THROWS(world.AddComponent(e, Health{1}), std::runtime_error);
+    GCopiesBeforeThrow = -1;
+
+    CORE_CHECK(world.IsAlive(e));
+    CORE_CHECK(!world.Has<Health>(e));
+    CORE_CHECK(world.TryGet<Fragile>(e)->Value == 7);
+    CORE_CHECK(world.TryGet<Name>(e)->Value == "kept"); // nothrow 列没有被提前移走
+    CORE_CHECK(world.TryGet<Fragile>(other)->Value == 8);
+    CORE_CHECK(world.GetQuery<Health>().Count() == 0);
+
+    world.AddComponent(e, Health{1});
+    CORE_CHECK(world.TryGet<Fragile>(e)->Value == 7);
+    CORE_CHECK(world.TryGet<Name>(e)->Value == "kept");
+    CORE_CHECK(world.TryGet<Health>(e)->Value == 1);
+    CORE_CHECK(world.TryGet<Name>(other)->Value == "other");
+}
+
+CORE_TEST(FailedMigrationIntoRegisteredArchetype)
+{
+    Core::World world;
+    world.RegisterArchetype<Name, Fragile, Health>(); // 以 SoaDynamicArray 存储的目标
+    auto e = world.Spawn(Name{"kept"}, Fragile{7});
+
+    GCopiesBeforeThrow = 0;
+    CORE_CHECK_THROWS(world.AddComponent(e, Health{1}), std::runtime_error);
+    GCopiesBeforeThrow = -1;
+
+    CORE_CHECK(!world.Has<Health>(e));
+    CORE_CHECK(world.TryGet<Name>(e)->Value == "kept");
+    CORE_CHECK(world.TryGet<Fragile>(e)->Value == 7);
+    CORE_CHECK(world.GetQuery<Health>().Count() == 0);
+}
+
+CORE_TEST_MAIN()
@@ -16,6 +16,9 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <coroutine>
+#include <algorithm>
+#include <exception>
 
 enum class ETaskPriority : uint8_t
 {
@@ -142,6 +145,127 @@ public:
 		m_condition.notify_one();
 	}
 
+	// co_await pool.Schedule() 的等待体: 将协程的恢复作为任务加入队列
+	// 线程池已停止时不挂起, 协程在当前线程继续执行
+	class ScheduleAwaiter
+	{
+	public:
+		ScheduleAwaiter(ThreadPool& pool, ETaskPriority priority)
+			: m_pool(pool)
+			, m_priority(priority)
+		{
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			return m_pool.EnqueueResume(handle, m_priority);
+		}
+
+		void await_resume() const noexcept
+		{
+		}
+
+	private:
+		ThreadPool&   m_pool;
+		ETaskPriority m_priority;
+	};
+
+	// 在协程中切换到线程池的工作线程继续执行:
+	//   co_await GThreadPool().Schedule();
+	ScheduleAwaiter Schedule(ETaskPriority priority = ETaskPriority::Normal)
+	{
+		return ScheduleAwaiter(*this, priority);
+	}
+
+	// 将 [0, count) 按 grain 切块, 在线程池上并行执行 fn(begin, end), 全部完成后返回
+	// 调用线程也参与领取块, 因此在工作线程内调用不会死锁; 线程池已停止时在当前线程顺序执行
+	// 第一个抛出的异常在所有块结束后重新抛出
+	template <typename Func>
+	void ParallelFor(size_t count, size_t grain, Func&& fn, ETaskPriority priority = ETaskPriority::Normal)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		grain = std::max<size_t>(grain, 1);
+		const size_t chunks = (count + grain - 1) / grain;
+		if (chunks == 1 || m_stop)
+		{
+			fn(size_t{0}, count);
+			return;
+		}
+
+		struct ParallelForState
+		{
+			std::atomic<size_t>     next_chunk { 0 };
+			std::atomic<size_t>     finished_chunks { 0 };
+			std::mutex              mutex;
+			std::condition_variable done;
+			std::exception_ptr      exception;
+		};
+		auto state = std::make_shared<ParallelForState>();
+
+		// 领取块直到全部领完; 领不到块的辅助任务不会访问 fn
+		auto run_chunks = [state, &fn, count, grain, chunks]()
+		{
+			for (;;)
+			{
+				size_t chunk = state->next_chunk.fetch_add(1);
+				if (chunk >= chunks)
+				{
+					return;
+				}
+				try
+				{
+					fn(chunk * grain, std::min(count, (chunk + 1) * grain));
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(state->mutex);
+					if (!state->exception)
+					{
+						state->exception = std::current_exception();
+					}
+				}
+				if (state->finished_chunks.fetch_add(1) + 1 == chunks)
+				{
+					std::lock_guard<std::mutex> lock(state->mutex);
+					state->done.notify_all();
+				}
+			}
+		};
+
+		size_t helpers = std::min(chunks - 1, GetThreadCount());
+		{
+			std::lock_guard<std::mutex> lock(m_queue_mutex);
+			if (!m_stop)
+			{
+				for (size_t i = 0; i < helpers; ++i)
+				{
+					m_task_queue.emplace(TaskWrapper{ run_chunks, priority });
+				}
+			}
+		}
+		m_condition.notify_all();
+
+		run_chunks();
+
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->done.wait(lock, [&]()
+		{
+			return state->finished_chunks.load() == chunks;
+		});
+		if (state->exception)
+		{
+			std::rethrow_exception(state->exception);
+		}
+	}
+
 	void WaitForIdle()
 	{
 		std::unique_lock<std::mutex> lock(m_queue_mutex);
@@ -221,6 +345,25 @@ private:
 		}
 	};
 
+	bool EnqueueResume(std::coroutine_handle<> handle, ETaskPriority priority)
+	{
+		std::lock_guard<std::mutex> lock(m_queue_mutex);
+		if (m_stop)
+		{
+			return false;
+		}
+
+		m_task_queue.emplace(TaskWrapper{
+			[handle]()
+			{
+				handle.resume();
+			},
+			priority
+		});
+		m_condition.notify_one();
+		return true;
+	}
+
 	void Create(size_t threads_num)
 	{
 		m_worker_threads.reserve(threads_num);